@@ -0,0 +1,424 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include "Engine.h"
+#include <UI/Button.h>
+#include <UI/View.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace	ExoEngine;
+
+// Layers of every generated array texture
+#define BENCHMARK_LAYERS		4
+
+// Widgets per group: an outer view, the view nested in it and buttons spread over the screen and both views
+#define BENCHMARK_GROUP_SIZE	8
+
+struct benchmarkConfig
+{
+	unsigned int sprites;
+	unsigned int textures;
+	unsigned int labels;
+	unsigned int glyphs;
+	unsigned int widgets;
+	unsigned int frames;
+	unsigned int warmup;
+	unsigned int width;
+	unsigned int height;
+	unsigned int seed;
+	bool headless;
+	std::string output;
+};
+
+struct benchmarkScene
+{
+	std::vector<std::shared_ptr<IArrayTexture>> textures;
+	std::vector<Label*> labels;
+	std::vector<IWidget*> roots;
+	std::vector<IWidget*> widgets;
+};
+
+static const struct { const char* name; unsigned int benchmarkConfig::*value; } g_options[] = {
+	{ "--sprites", &benchmarkConfig::sprites },
+	{ "--textures", &benchmarkConfig::textures },
+	{ "--labels", &benchmarkConfig::labels },
+	{ "--glyphs", &benchmarkConfig::glyphs },
+	{ "--widgets", &benchmarkConfig::widgets },
+	{ "--frames", &benchmarkConfig::frames },
+	{ "--warmup", &benchmarkConfig::warmup },
+	{ "--width", &benchmarkConfig::width },
+	{ "--height", &benchmarkConfig::height },
+	{ "--seed", &benchmarkConfig::seed }
+};
+
+static const struct { const char* name; double frameStats::*time; } g_passes[] = {
+	{ "record", &frameStats::record },
+	{ "tileMaps", &frameStats::tileMaps },
+	{ "sprites", &frameStats::sprites },
+	{ "particles", &frameStats::particles },
+	{ "widgets", &frameStats::widgets },
+	{ "text", &frameStats::text },
+	{ "postProcessing", &frameStats::postProcessing },
+	{ "total", &frameStats::total }
+};
+
+static const struct { const char* name; unsigned long frameStats::*count; } g_counters[] = {
+	{ "drawCalls", &frameStats::drawCalls },
+	{ "stateChanges", &frameStats::stateChanges },
+	{ "stateChangesElided", &frameStats::stateChangesElided },
+	{ "uniformUploads", &frameStats::uniformUploads }
+};
+
+static void	usage(void)
+{
+	std::cerr << "usage: benchmark [--sprites N] [--textures M] [--labels K] [--glyphs L] [--widgets W]" << std::endl
+		<< "                 [--frames F] [--warmup F] [--width W] [--height H] [--seed S]" << std::endl
+		<< "                 [--windowed] [--output file.json | -]" << std::endl;
+}
+
+static void	parseArguments(int argc, char** argv, benchmarkConfig& config)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool known = false;
+
+		if (argument == "--windowed")
+		{
+			config.headless = false;
+			continue;
+		}
+		if (i + 1 >= argc)
+			throw (std::invalid_argument("missing value after '" + argument + "'"));
+
+		if (argument == "--output")
+		{
+			config.output = argv[++i];
+			continue;
+		}
+		for (const auto& option : g_options)
+		{
+			if (argument == option.name)
+			{
+				config.*option.value = (unsigned int)std::stoul(argv[++i]);
+				known = true;
+				break;
+			}
+		}
+		if (!known)
+			throw (std::invalid_argument("unknown option '" + argument + "'"));
+	}
+}
+
+// N sprites over M array textures, in a 40x40 square in front of the camera
+static void	generateSprites(IRenderer* renderer, const benchmarkConfig& config, std::mt19937& random, benchmarkScene& scene)
+{
+	std::vector<std::string> layers(BENCHMARK_LAYERS, "resources/red_block.png");
+	std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> scale(0.2f, 1.0f);
+	std::uniform_int_distribution<int> layer(0, BENCHMARK_LAYERS - 1);
+	std::uniform_int_distribution<int> zOrder(0, 7);
+
+	for (unsigned int i = 0; i < std::max(config.textures, 1u); i++)
+		scene.textures.push_back(std::shared_ptr<IArrayTexture>(renderer->createArrayTexture(128, 128, layers)));
+
+	for (unsigned int i = 0; i < config.sprites; i++)
+	{
+		sprite s;
+
+		s.texture = scene.textures[i % scene.textures.size()];
+		s.position = glm::vec2(position(random), position(random));
+		s.scale = glm::vec2(scale(random));
+		s.layer = layer(random);
+		s.zOrder = zOrder(random);
+		renderer->add(s);
+	}
+}
+
+// K labels of L glyphs
+static void	generateLabels(IRenderer* renderer, ResourceManager* resources, const benchmarkConfig& config, std::mt19937& random, benchmarkScene& scene)
+{
+	std::shared_ptr<Font> font = resources->get<Font>("global_font");
+	std::uniform_real_distribution<float> x(0.0f, REFRENCE_RESOLUTION_WIDTH);
+	std::uniform_real_distribution<float> y(0.0f, REFRENCE_RESOLUTION_HEIGHT);
+	std::string text;
+
+	for (unsigned int i = 0; i < config.glyphs; i++)
+		text += (char)('a' + i % 26);
+
+	for (unsigned int i = 0; i < config.labels; i++)
+	{
+		Label* label = new Label();
+
+		label->setFont(font);
+		label->setText(text);
+		label->setLocalAnchor(AnchorPoint::TOP_LEFT);
+		label->setFontScale(0.3f);
+		label->setPosition(x(random), y(random));
+		renderer->add(label);
+		scene.labels.push_back(label);
+	}
+}
+
+static View*	createView(IRenderer* renderer, ResourceManager* resources, const glm::vec2& position, const glm::vec2& size)
+{
+	View* view = new View(resources->get<ITexture>("black"), resources->get<ITexture>("scrollBackground"), 1, 1,
+		renderer->getUIScaleFactor(), renderer->getWindow()->getWidth(), renderer->getWindow()->getHeight());
+
+	view->setSize(size);
+	view->setPosition(position);
+	return (view);
+}
+
+// W widgets by groups: every full group holds an outer view with a nested one, half of the buttons are 9-sliced
+static void	generateWidgets(IRenderer* renderer, ResourceManager* resources, const benchmarkConfig& config, std::mt19937& random, benchmarkScene& scene)
+{
+	std::shared_ptr<ITexture> texture = resources->get<ITexture>("button");
+	std::uniform_real_distribution<float> x(0.0f, REFRENCE_RESOLUTION_WIDTH);
+	std::uniform_real_distribution<float> y(0.0f, REFRENCE_RESOLUTION_HEIGHT);
+	std::uniform_real_distribution<float> child(0.0f, 1.0f);
+	unsigned int count = 0;
+
+	while (count < config.widgets)
+	{
+		View* outer = nullptr;
+		View* inner = nullptr;
+
+		if (config.widgets - count >= BENCHMARK_GROUP_SIZE)
+		{
+			outer = createView(renderer, resources, glm::vec2(x(random), y(random)), glm::vec2(200.0f, 150.0f));
+			inner = createView(renderer, resources, glm::vec2(100.0f, 75.0f), glm::vec2(80.0f, 60.0f));
+			outer->addChild(inner);
+
+			scene.widgets.push_back(outer);
+			scene.widgets.push_back(inner);
+			count += 2;
+		}
+
+		unsigned int buttons = std::min(config.widgets - count, (unsigned int)BENCHMARK_GROUP_SIZE - (outer ? 2 : 0));
+		for (unsigned int i = 0; i < buttons; i++)
+		{
+			Button* button = new Button(texture, ButtonType::NORMAL, false, renderer->getUIScaleFactor(), renderer->getWindow()->getWidth(), renderer->getWindow()->getHeight());
+			View* parent = (!outer || i % 3 == 0) ? nullptr : (i % 3 == 1 ? outer : inner);
+
+			button->setSize(40.0f, 15.0f);
+			button->setSliced(i % 2 == 1);
+			if (parent)
+			{
+				button->setPosition(child(random) * parent->getSize().x * 2.0f, child(random) * parent->getSize().y * 2.0f);
+				parent->addChild(button);
+			}
+			else
+			{
+				button->setPosition(x(random), y(random));
+				renderer->add(button);
+				scene.roots.push_back(button);
+			}
+			scene.widgets.push_back(button);
+		}
+		count += buttons;
+
+		if (outer)
+		{
+			renderer->add(outer);
+			scene.roots.push_back(outer);
+		}
+	}
+}
+
+static void	writeSummary(std::ostream& out, std::vector<double> values)
+{
+	double sum = 0.0;
+
+	std::sort(values.begin(), values.end());
+	for (double value : values)
+		sum += value;
+
+	out << "{ \"mean\": " << sum / values.size()
+		<< ", \"median\": " << values[values.size() / 2]
+		<< ", \"p95\": " << values[std::min(values.size() - 1, values.size() * 95 / 100)]
+		<< ", \"min\": " << values.front()
+		<< ", \"max\": " << values.back() << " }";
+}
+
+static void	writeReport(std::ostream& out, const benchmarkConfig& config, const std::vector<frameStats>& samples, const std::vector<double>& frameTimes, const Profiler* profiler)
+{
+	std::vector<double> values(samples.size());
+
+	out << "{" << std::endl
+		<< "\t\"backend\": \"" << (config.headless ? "headless" : "windowed") << "\"," << std::endl
+		<< "\t\"scene\": { \"sprites\": " << config.sprites << ", \"textures\": " << std::max(config.textures, 1u)
+		<< ", \"labels\": " << config.labels << ", \"glyphs\": " << config.glyphs << ", \"widgets\": " << config.widgets
+		<< ", \"width\": " << config.width << ", \"height\": " << config.height << ", \"seed\": " << config.seed << " }," << std::endl
+		<< "\t\"frames\": " << samples.size() << "," << std::endl
+		<< "\t\"warmup\": " << config.warmup << "," << std::endl;
+
+	// Milliseconds
+	out << "\t\"frameTime\": ";
+	writeSummary(out, frameTimes);
+	out << "," << std::endl << "\t\"passes\": {" << std::endl;
+	for (size_t pass = 0; pass < sizeof(g_passes) / sizeof(g_passes[0]); pass++)
+	{
+		for (size_t i = 0; i < samples.size(); i++)
+			values[i] = samples[i].*g_passes[pass].time;
+
+		out << "\t\t\"" << g_passes[pass].name << "\": ";
+		writeSummary(out, values);
+		out << (pass + 1 < sizeof(g_passes) / sizeof(g_passes[0]) ? "," : "") << std::endl;
+	}
+
+	// Per frame
+	out << "\t}," << std::endl << "\t\"counters\": {" << std::endl;
+	for (size_t counter = 0; counter < sizeof(g_counters) / sizeof(g_counters[0]); counter++)
+	{
+		for (size_t i = 0; i < samples.size(); i++)
+			values[i] = (double)(samples[i].*g_counters[counter].count);
+
+		out << "\t\t\"" << g_counters[counter].name << "\": ";
+		writeSummary(out, values);
+		out << (counter + 1 < sizeof(g_counters) / sizeof(g_counters[0]) ? "," : "") << std::endl;
+	}
+	out << "\t}";
+
+	// Timer queries, over the last PROFILER_HISTORY frames
+	if (profiler->hasGpuTimers())
+	{
+		out << "," << std::endl << "\t\"gpu\": {" << std::endl;
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+		{
+			profileStats stats = profiler->getGpuStats((ProfileStage)stage);
+
+			out << "\t\t\"" << Profiler::getStageName((ProfileStage)stage) << "\": { \"min\": " << stats.min
+				<< ", \"average\": " << stats.average << ", \"p99\": " << stats.p99 << " }"
+				<< (stage + 1 < PROFILE_STAGE_COUNT ? "," : "") << std::endl;
+		}
+		out << "\t}";
+	}
+	out << std::endl << "}" << std::endl;
+}
+
+int	main(int argc, char** argv)
+{
+	benchmarkConfig config = { 10000, 8, 100, 32, 64, 600, 60, 1280, 720, 42, true, "benchmark.json" };
+
+	try
+	{
+		parseArguments(argc, argv, config);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		usage();
+		return (EXIT_FAILURE);
+	}
+	if (config.frames == 0)
+	{
+		usage();
+		return (EXIT_FAILURE);
+	}
+
+	Engine		engine("resources/settings.xml");
+	IRenderer*	renderer = engine.getRenderer();
+
+	// Headless where available, a window otherwise
+	try
+	{
+		renderer->initialize("ExoEngine - Benchmark", config.width, config.height, config.headless ? WindowMode::HEADLESS : WindowMode::WINDOWED, false);
+	}
+	catch (const std::exception& e)
+	{
+		if (!config.headless)
+			throw;
+		std::cerr << "headless rendering unavailable (" << e.what() << "), falling back to a window" << std::endl;
+		config.headless = false;
+		renderer->initialize("ExoEngine - Benchmark", config.width, config.height, WindowMode::WINDOWED, false);
+	}
+	engine.getResourceManager()->load("resources/resources.xml");
+	renderer->getWindow()->setVsync(false);
+	renderer->getProfiler()->setGpuTimers(true);
+
+	auto cam = renderer->createCamera();
+	cam->setPosition(0.0f, 0.0f, 20.0f);
+	renderer->setCurrentCamera(cam);
+
+	// Same seed, same scene
+	std::mt19937 random(config.seed);
+	benchmarkScene scene;
+	generateSprites(renderer, config, random, scene);
+	generateLabels(renderer, engine.getResourceManager(), config, random, scene);
+	generateWidgets(renderer, engine.getResourceManager(), config, random, scene);
+
+	std::vector<frameStats> samples;
+	std::vector<double> frameTimes;
+	samples.reserve(config.frames);
+	frameTimes.reserve(config.frames);
+
+	for (unsigned int frame = 0; frame < config.warmup + config.frames && !renderer->getWindow()->getIsClosing(); frame++)
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		renderer->draw();
+		renderer->swap();
+
+		if (frame < config.warmup)
+			continue;
+		frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+		samples.push_back(renderer->getFrameStats());
+	}
+
+	if (samples.empty())
+		return (EXIT_FAILURE);
+
+	if (config.output == "-")
+		writeReport(std::cout, config, samples, frameTimes, renderer->getProfiler());
+	else
+	{
+		std::ofstream file(config.output);
+		if (!file)
+		{
+			std::cerr << "cannot write '" << config.output << "'" << std::endl;
+			return (EXIT_FAILURE);
+		}
+		writeReport(file, config, samples, frameTimes, renderer->getProfiler());
+		std::cerr << "benchmark written to '" << config.output << "'" << std::endl;
+	}
+
+	// Scene
+	for (IWidget* widget : scene.roots)
+		renderer->remove(widget);
+	for (Label* label : scene.labels)
+		renderer->remove(label);
+	for (IWidget* widget : scene.widgets)
+		delete widget;
+	for (Label* label : scene.labels)
+		delete label;
+
+	return (EXIT_SUCCESS);
+}
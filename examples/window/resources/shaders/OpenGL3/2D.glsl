@@ -1,38 +1,155 @@
 #version 330 core
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 instanceTransform;
+layout(location = 3) in vec4 instanceData;
+layout(location = 4) in vec4 instanceAnimation;
 
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 model;
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+    vec4 time;
+};
+uniform float size;
 
 out vec2 TexCoords;
+out vec2 World;
+flat out int Layer;
+flat out vec4 NormalTransform;
 
 void main(void) 
 {
-    gl_Position = projection * view * model * vec4(position, 1.0);
-    TexCoords = texCoord;
+    float c = cos(instanceData.x);
+    float s = sin(instanceData.x);
+    vec2 scaled = position.xy * instanceTransform.zw;
+    vec2 world = vec2(scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c) + instanceTransform.xy;
+
+    gl_Position = projection * view * vec4(world, 0.0, 1.0);
+    TexCoords = texCoord * size * instanceData.zw;
+    World = world;
+
+    // Frame of the clip from its start time, frame count, frame duration and loop flag
+    float layer = instanceData.y;
+    if (instanceAnimation.y > 0.0)
+    {
+        float frame = floor(max(time.x - instanceAnimation.x, 0.0) / max(instanceAnimation.z, 0.0001));
+        layer += instanceAnimation.w > 0.5 ? mod(frame, instanceAnimation.y) : min(frame, instanceAnimation.y - 1.0);
+    }
+    Layer = int(layer);
+    NormalTransform = vec4(c, s, instanceData.zw);
 }
 
 #FRAGMENT
 #version 330 core
 
+// Height of the lights above the sprites, relative to their radius
+#define LIGHT_HEIGHT 0.25
+#define SHADOW_STEPS 24
+
 in vec2 TexCoords;
+in vec2 World;
+flat in int Layer;
+flat in vec4 NormalTransform;
+
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+    vec4 time;
+};
 
 uniform sampler2DArray ourTexture;
-uniform int layer;
-uniform int flipHorizontal;
-uniform int flipVertical;
-uniform float size;
+uniform sampler2DArray normalMap;
+uniform samplerBuffer lights;
+uniform usamplerBuffer lightTiles;
+uniform usamplerBuffer lightIndices;
+uniform sampler2D shadowMask;
+
+uniform int lighting;
+uniform int normalMapped;
+uniform int occluder;
+uniform int shadows;
+uniform vec3 ambient;
+uniform float lightTileSize;
+uniform int lightTilesX;
+uniform vec2 lightViewport;
 
 out vec4 color;
 
+float shadow(vec2 light)
+{
+    vec4 clip = projection * view * vec4(light, 0.0, 1.0);
+    vec2 target = clip.xy / clip.w * 0.5 + 0.5;
+    vec2 origin = gl_FragCoord.xy / lightViewport;
+    bool outside = false;
+
+    // March to the light in the occluder mask, the sprite of the fragment does not shadow itself
+    for (int i = 1; i <= SHADOW_STEPS; i++)
+    {
+        if (texture(shadowMask, mix(origin, target, float(i) / float(SHADOW_STEPS))).r < 0.5)
+            outside = true;
+        else if (outside)
+            return (0.0);
+    }
+    return (1.0);
+}
+
 void main(void) 
 {    
-    vec4 color_out = texture(ourTexture, vec3(TexCoords.x * size * flipHorizontal, TexCoords.y * size * flipVertical, layer));
+    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer));
 
     if(color_out.a < 0.1)
         discard;
 
-	color = color_out;
+    if (occluder != 0)
+    {
+        color = vec4(1.0);
+        return;
+    }
+
+    if (lighting == 0)
+    {
+        color = color_out;
+        return;
+    }
+
+    // Normal in world space: flipped then rotated like the sprite
+    vec3 normal = vec3(0.0, 0.0, 1.0);
+    if (normalMapped != 0)
+    {
+        normal = texture(normalMap, vec3(TexCoords, Layer)).xyz * 2.0 - 1.0;
+        normal.xy *= NormalTransform.zw;
+        normal.xy = vec2(normal.x * NormalTransform.x - normal.y * NormalTransform.y, normal.x * NormalTransform.y + normal.y * NormalTransform.x);
+        normal = normalize(normal);
+    }
+
+    // Only the lights binned in the tile of the fragment
+    ivec2 tile = ivec2(gl_FragCoord.xy / lightTileSize);
+    uvec2 list = texelFetch(lightTiles, tile.y * lightTilesX + tile.x).xy;
+    vec3 diffuse = ambient;
+
+    for (uint i = 0u; i < list.y; i++)
+    {
+        int index = int(texelFetch(lightIndices, int(list.x + i)).r);
+        vec4 light = texelFetch(lights, index * 2);
+        vec4 lightColor = texelFetch(lights, index * 2 + 1);
+        vec2 delta = light.xy - World;
+        float dist = length(delta);
+
+        if (dist >= light.z)
+            continue;
+
+        float attenuation = 1.0 - dist / light.z;
+        float lambert = max(dot(normal, normalize(vec3(delta, light.z * LIGHT_HEIGHT))), 0.0);
+
+        if (shadows != 0 && lightColor.a > 0.5 && lambert > 0.0)
+            lambert *= shadow(light.xy);
+
+        diffuse += lightColor.rgb * light.w * attenuation * attenuation * lambert;
+    }
+
+    color = vec4(color_out.rgb * diffuse, color_out.a);
 }
\ No newline at end of file
@@ -1,26 +1,34 @@
 #version 330 core
 layout (location = 0) in vec4 vertex;
+layout (location = 1) in vec3 color;
 
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+};
 
 out vec2 TexCoords;
+out vec3 TextColor;
 
 void main()
 {
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+    gl_Position = orthographic * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    TextColor = color;
 }
 
 #FRAGMENT
 #version 330 core
 
 in vec2 TexCoords;
+in vec3 TextColor;
 out vec4 color;
 
 uniform sampler2D fontAtlas;
-uniform vec3 textColor;
 
 void main()
 {    
-    color = vec4(textColor, texture(fontAtlas, TexCoords).r);
+    color = vec4(TextColor, texture(fontAtlas, TexCoords).r);
 }
\ No newline at end of file
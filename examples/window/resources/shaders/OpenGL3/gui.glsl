@@ -1,32 +1,37 @@
 #version 330 core
 layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 texCoord;
+layout (location = 2) in float opacity;
 
-uniform mat4 transformation;
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+};
 
 out vec2 TexCoords;
+out float Opacity;
 
 void main(void)
 {
-    gl_Position = projection * transformation * vec4(position, 0.0, 1.0);
-    TexCoords = vec2((position.x + 1.0) / 2, 1 - (-1 * position.y + 1.0) / 2.0);
+    gl_Position = orthographic * vec4(position, 0.0, 1.0);
+    TexCoords = texCoord;
+    Opacity = opacity;
 }
 
 #FRAGMENT
 #version 330 core
 
 in vec2 TexCoords;
+in float Opacity;
 
 out vec4 color;
 
 uniform sampler2D guiTexture;
-uniform float opacity;
-uniform float numberOfRows;
-uniform float numberOfColumns;
-uniform vec2 offset;
 
 void main(void)
 {    
-    color = texture(guiTexture, vec2(TexCoords.x / numberOfRows, TexCoords.y / numberOfColumns) + offset);
-    color.a = color.a - opacity;
+    color = texture(guiTexture, TexCoords);
+    color.a = color.a - Opacity;
 }
\ No newline at end of file
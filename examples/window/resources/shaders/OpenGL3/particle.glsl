@@ -0,0 +1,58 @@
+#version 330 core
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 instance;
+
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+};
+layout(std140) uniform Emitter
+{
+    vec4 startColor;
+    vec4 endColor;
+    vec2 scale;
+    vec2 frames;
+};
+
+out vec2 TexCoords;
+out vec4 Color;
+flat out int Layer;
+
+void main(void)
+{
+    // instance: position, fraction of the life, angle
+    float life = instance.z;
+    float c = cos(instance.w);
+    float s = sin(instance.w);
+    vec2 scaled = position * mix(scale.x, scale.y, life);
+    vec2 world = vec2(scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c) + instance.xy;
+
+    gl_Position = projection * view * vec4(world, 0.0, 1.0);
+    TexCoords = texCoord;
+    Color = mix(startColor, endColor, life);
+    Layer = int(frames.x) + min(int(life * frames.y), int(frames.y) - 1);
+}
+
+#FRAGMENT
+#version 330 core
+
+in vec2 TexCoords;
+in vec4 Color;
+flat in int Layer;
+
+uniform sampler2DArray ourTexture;
+
+out vec4 color;
+
+void main(void)
+{
+    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer)) * Color;
+
+    if (color_out.a < 0.01)
+        discard;
+
+    color = color_out;
+}
\ No newline at end of file
@@ -2,12 +2,14 @@
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 texCoord;
 
+uniform vec2 uvScale;
+
 out vec2 TexCoords;
 
 void main(void) 
 {
 	gl_Position = vec4(position.x, position.y, 0.0, 1.0);
-	TexCoords = texCoord;
+	TexCoords = texCoord * uvScale;
 }
 
 #FRAGMENT
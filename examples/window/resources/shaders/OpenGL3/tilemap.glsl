@@ -0,0 +1,43 @@
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in float layer;
+
+layout(std140) uniform Frame
+{
+    mat4 projection;
+    mat4 view;
+    mat4 orthographic;
+};
+uniform mat4 model;
+
+out vec2 TexCoords;
+flat out int Layer;
+
+void main(void)
+{
+    gl_Position = projection * view * model * vec4(position, 0.0, 1.0);
+    TexCoords = texCoord;
+    Layer = int(layer);
+}
+
+#FRAGMENT
+#version 330 core
+
+in vec2 TexCoords;
+flat in int Layer;
+
+uniform sampler2DArray ourTexture;
+
+out vec4 color;
+
+void main(void)
+{
+    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer));
+
+    if(color_out.a < 0.1)
+        discard;
+
+    color = color_out;
+}
\ No newline at end of file
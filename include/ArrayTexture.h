@@ -31,6 +31,7 @@
 #include "IArrayTexture.h"
 #include "Texture.h"
 #include "OGLCall.h"
+#include "TextureUploader.h"
 
 namespace ExoEngine
 {
@@ -46,15 +47,18 @@ namespace ExoEngine
 
 		virtual void bind(int unit = 0) const;
 		virtual void unbind(void) const;
+		virtual bool isReady(void) const;
 
 		// Getters
 		unsigned int getBuffer(void) const;
 
 		const GLuint	&getId(void) const;
 	private:
+		bool initializeCooked(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
 		static void applyFilter(const TextureFilter& filter);
 	private:
 		GLuint	_id;
+		mutable UploadFence	_upload;
 	};
 
 }
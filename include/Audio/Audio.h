@@ -50,10 +50,10 @@ namespace ExoEngine
 		virtual void updateListener(const glm::vec3 &position, const glm::vec3 &velocity, float volume);
 		virtual void updateVolume(float volume);
 
-		Source* createSource(void);
-		Sound* createSound(const std::string& filePath);
-		Music* createMusic(const std::string& filePath);
-	private:
+		virtual Source* createSource(void);
+		virtual Sound* createSound(const std::string& filePath);
+		virtual Music* createMusic(const std::string& filePath);
+	protected:
 		friend class Singleton<Audio>;
 
 		Audio(void);
@@ -42,6 +42,9 @@ namespace ExoEngine
 	{
 	public:
 		Music(const std::string &filePath);
+
+		// Without any buffer nor stream, for NullAudio
+		Music(void);
 		virtual ~Music(void);
 
 		void streamingUpdate(ALuint source);
@@ -0,0 +1,54 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include "Audio/Audio.h"
+
+namespace ExoEngine
+{
+
+	// Audio of dedicated servers: no OpenAL device nor context, sounds and musics are created without PCM
+	class NullAudio : public Audio, public Singleton<NullAudio>
+	{
+	public:
+		using Singleton<NullAudio>::Get;
+		using Singleton<NullAudio>::Destroy;
+
+		virtual void initialize(void);
+
+		virtual void getDevices(std::vector<std::string> &devices);
+		virtual void updateListener(const glm::vec3 &position, const glm::vec3 &velocity, float volume);
+		virtual void updateVolume(float volume);
+
+		virtual Source* createSource(void);
+		virtual Sound* createSound(const std::string& filePath);
+		virtual Music* createMusic(const std::string& filePath);
+	private:
+		friend class Singleton<NullAudio>;
+
+		NullAudio(void);
+		virtual ~NullAudio(void);
+	};
+
+}
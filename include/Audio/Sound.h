@@ -42,6 +42,9 @@ namespace ExoEngine
 	{
 	public:
 		Sound(const std::string &filePath);
+
+		// Without any buffer, for NullAudio
+		Sound(void);
 		virtual ~Sound(void);
 
 		// Getters
@@ -50,7 +50,8 @@ namespace ExoEngine
 			PAUSED
 		};
 	public:
-		Source(void);
+		// Without generate, for NullAudio: no OpenAL source and every call below does nothing
+		Source(bool generate = true);
 		virtual ~Source(void);
 
 		void play(void) const;
@@ -28,10 +28,15 @@
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
-#include "Grid.h"
 #include "Shader.h"
 #include "Buffer.h"
 
+// Vertices of the geometry buffer: position (2) and color (4), lines first then both sets of heads
+#define AXIS_VERTEX_SIZE			6
+#define AXIS_LINE_VERTICES			4
+#define AXIS_TRANSLATION_VERTICES	6
+#define AXIS_SCALE_VERTICES			12
+
 namespace ExoEngine
 {
 
@@ -46,7 +51,7 @@ namespace ExoEngine
 		Axis(void);
 		virtual ~Axis(void);
 
-		void render(const glm::mat4& lookAt, const glm::mat4& perspective);
+		void render(void);
 
 		// Getters
 		const AxisType& getType(void) const { return _type; }
@@ -55,12 +60,14 @@ namespace ExoEngine
 		// Setters
 		void setType(const AxisType& type) { _type = type; };
 		void setPosition(const glm::vec2& position) { _pos = position; }
-	private:
-		void drawAxis(int x, int y, float angle, const glm::vec3 &color, const glm::mat4& lookAt, const glm::mat4& perspective);
 	public:
+		static void loadUniforms(void);
+
 		static Shader* pShader;
+		static UniformHandle<glm::mat4> modelUniform;
+		static UniformHandle<glm::vec4> colorUniform;
 
-		// Triangle
+		// Lines and heads of both axes
 		static Buffer* vaoBuffer;
 		static Buffer* vertexBuffer;
 	private:
@@ -39,15 +39,28 @@ namespace ExoEngine
 
 		virtual void initialize(unsigned long count, unsigned int size, const void* data, BufferType type, BufferDraw usage, unsigned char attribArray, bool normalized);
 		virtual void updateSubData(unsigned long count, const void* data);
+		virtual void resize(unsigned long count, const void* data);
+
+		// Instanced attributes (stride and offset are expressed in floats)
+		void setAttribute(unsigned char attribArray, unsigned int size, unsigned int stride, unsigned long offset, unsigned int divisor) const;
+
+		// Ranges and uniform buffers (offsets and sizes are expressed in bytes)
+		void updateSubData(unsigned long offset, unsigned long size, const void* data);
+		void bindBase(unsigned int binding) const;
+		void bindRange(unsigned int binding, unsigned long offset, unsigned long size) const;
 
 		virtual void bind(void) const;
 		virtual void unbind(void) const;
 
 		// Getters
 		GLuint getBuffer(void) const;
+		unsigned long getCount(void) const;
+	private:
+		GLenum getTarget(void) const;
 	private:
 		unsigned long _count;
 		BufferType _type;
+		BufferDraw _usage;
 
 		GLuint _id;
 	};
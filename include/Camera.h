@@ -25,6 +25,7 @@
 #pragma once
 
 #include "ICamera.h"
+#include "IWindow.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace ExoEngine
@@ -33,7 +34,8 @@ namespace ExoEngine
 	class Camera : public ICamera
 	{
 	public:
-		Camera(void);
+		// The window gives the frame delta of the keyboard moves
+		Camera(IWindow* window);
 		~Camera(void);
 
 		virtual void update(Mouse* mouse, Keyboard* keyboard);
@@ -41,6 +43,7 @@ namespace ExoEngine
 		// Getters
 		glm::mat4 getLookAt(void);
 	private:
+		IWindow* _pWindow;
 		glm::mat4 _lookAt;
 	};
 
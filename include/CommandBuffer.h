@@ -0,0 +1,68 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "RenderQueue.h"
+
+namespace ExoEngine
+{
+
+	// Draw recorded away from the GL thread, the range indexes the buffers of the renderer which recorded it
+	struct drawPacket
+	{
+		uint64_t key;
+		const void* state;
+		uint32_t first;
+		uint32_t count;
+	};
+
+	class CommandBuffer
+	{
+	public:
+		CommandBuffer(void);
+		~CommandBuffer(void);
+
+		// A range following the previous one with the same state extends it
+		void add(uint64_t key, const void* state, uint32_t first, uint32_t count);
+		void append(const CommandBuffer& other);
+		void clear(void);
+
+		// Stable on the key, equal keys keep the recording order
+		const std::vector<drawPacket>& sort(void);
+
+		// Getters
+		const std::vector<drawPacket>& getPackets(void) const;
+		size_t size(void) const;
+		bool empty(void) const;
+	private:
+		std::vector<drawPacket> _packets;
+		std::vector<drawPacket> _sorted;
+		std::vector<renderEntry> _entries;
+		std::vector<renderEntry> _swap;
+	};
+
+}
@@ -46,6 +46,8 @@ namespace ExoEngine
 			Audio*		getAudio(void) const;
 
 		private:
+			IRenderer*	_renderer;
+			Audio*		_audio;
 			ResourceManager* _resourceManager;
 			SettingsManager* _settingsManager;
 	};
@@ -42,6 +42,9 @@ namespace ExoEngine
 		ARRAYBUFFER,
 		INDEXBUFFER,
 		RENDERBUFFER,
+		INSTANCEBUFFER,
+		UNIFORMBUFFER,
+		TEXTUREBUFFER,
 	};
 
 	enum BufferDraw
@@ -55,6 +58,7 @@ namespace ExoEngine
 	{
 		NEAREST,
 		LINEAR,
+		MIPMAP	// Trilinear
 	};
 
 	enum TextureFormat
@@ -69,7 +73,8 @@ namespace ExoEngine
 	{
 		WINDOWED = 0,
 		FULLSCREEN,
-		BORDERLESS
+		BORDERLESS,
+		HEADLESS
 	};
 
 	// Inputs
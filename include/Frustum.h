@@ -0,0 +1,56 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+namespace ExoEngine
+{
+
+	// View volume extracted from a projection * view matrix, boxes are tested in the z = 0 plane
+	class Frustum
+	{
+	public:
+		Frustum(void);
+		~Frustum(void);
+
+		void update(const glm::mat4& viewProjection);
+
+		bool intersects(const glm::vec2& center, const glm::vec2& extent) const;
+
+		// Test count boxes stored as separate arrays, visible[i] is set to 1 or 0
+		void intersects(const float* centerX, const float* centerY, const float* extentX, const float* extentY, size_t count, uint8_t* visible) const;
+
+		// Getters
+		bool getBounds(glm::vec2& min, glm::vec2& max) const;
+	private:
+		glm::vec4 _planes[6];
+		glm::mat4 _inverse;
+	};
+
+}
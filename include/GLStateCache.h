@@ -0,0 +1,119 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "OGLCall.h"
+
+#define MAX_TEXTURE_UNITS 32
+#define MAX_UNIFORM_BINDINGS 16
+
+namespace ExoEngine
+{
+
+	struct glStateCounters
+	{
+		unsigned long issued;
+		unsigned long elided;
+		unsigned long drawCalls;
+		unsigned long uniformUploads;
+	};
+
+	// Mirror of the GL bindings, a call is only issued when it changes the state.
+	// Every thread owns its context so every thread owns its cache.
+	class GLStateCache
+	{
+	public:
+		static GLStateCache& Get(void);
+
+		void useProgram(GLuint program);
+		void bindVertexArray(GLuint vertexArray);
+		void bindBuffer(GLenum target, GLuint buffer);
+		void bindBufferBase(GLenum target, unsigned int index, GLuint buffer);
+		void bindBufferRange(GLenum target, unsigned int index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+		void activeTexture(unsigned int unit);
+		void bindTexture(unsigned int unit, GLenum target, GLuint texture);
+
+		void setBlend(bool enabled);
+		void setBlendFunc(GLenum source, GLenum destination);
+		void setScissorTest(bool enabled);
+		void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// Texture names are shared with the loader context: a name deleted by another thread is reused
+		// by glGenTextures while this cache still holds it as bound, so a new name is always bound again
+		GLuint genTexture(void);
+
+		// Names can be reused by glGen*, forget them when they are deleted
+		void deleteProgram(GLuint program);
+		void deleteVertexArray(GLuint vertexArray);
+		void deleteBuffer(GLuint buffer);
+		void deleteTexture(GLuint texture);
+
+		// Forget everything, for code which calls GL directly
+		void invalidate(void);
+		void resetCounters(void);
+
+		// Work which is not state, counted with the rest of the frame. Uniform uploads are the Shader::set* calls,
+		// the UniformRing pushes (one per particle emitter, its Emitter block) and the frame uniform block.
+		void countDrawCall(void);
+		void countUniformUpload(void);
+
+		// Getters
+		unsigned int getActiveTexture(void) const;
+		void getScissor(GLint box[4]);
+		const glStateCounters& getCounters(void) const;
+	private:
+		GLStateCache(void);
+
+		bool change(bool changed);
+		void forgetTexture(GLuint texture);
+		static int getTargetIndex(GLenum target);
+	private:
+		struct indexedBinding
+		{
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr size;
+		};
+
+		GLuint _program;
+		GLuint _vertexArray;
+		GLuint _arrayBuffer;
+		GLuint _elementBuffer;
+		GLuint _uniformBuffer;
+		indexedBinding _uniformBindings[MAX_UNIFORM_BINDINGS];
+		unsigned int _activeTexture;
+		GLuint _textures[MAX_TEXTURE_UNITS][2];
+
+		int _blend;
+		GLenum _blendSource;
+		GLenum _blendDestination;
+		int _scissorTest;
+		GLint _scissor[4];
+		bool _scissorKnown;
+
+		glStateCounters _counters;
+	};
+
+}
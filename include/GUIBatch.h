@@ -0,0 +1,110 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+#include "ITexture.h"
+
+namespace ExoEngine
+{
+
+	// Everything a widget quad depends on, the cached geometry is rebuilt when it changes
+	struct guiQuadSource
+	{
+		const ITexture* texture;
+		glm::vec2 position;
+		glm::vec2 size;
+		glm::vec2 offset;
+		float rotation;
+		float opacity;
+		float numberOfRows;
+		float numberOfColumns;
+		bool sliced;
+		bool hover;
+
+		bool operator==(const guiQuadSource& b) const
+		{
+			return (texture == b.texture && position == b.position && size == b.size && offset == b.offset
+				&& rotation == b.rotation && opacity == b.opacity && numberOfRows == b.numberOfRows
+				&& numberOfColumns == b.numberOfColumns && sliced == b.sliced && hover == b.hover);
+		}
+	};
+
+	// Consecutive quads sharing a GL texture, in vertices
+	struct guiRun
+	{
+		const ITexture* texture;
+		size_t first;
+		size_t count;
+	};
+
+	// Retained UI geometry: x y u v opacity per vertex, two triangles per quad
+	class GUIBatch
+	{
+	public:
+		GUIBatch(void);
+		~GUIBatch(void);
+
+		void begin(void);
+		void add(const void* key, const guiQuadSource& source);
+
+		// Close the current run, the next quad starts a new one
+		void split(void);
+
+		// Return true when the vertex stream differs from the previous frame
+		bool end(void);
+
+		// Getters
+		const std::vector<float>& getVertices(void) const;
+		const std::vector<guiRun>& getRuns(void) const;
+		size_t getRebuildCount(void) const;
+	private:
+		struct widgetGeometry
+		{
+			guiQuadSource source;
+			std::vector<float> vertices;
+			unsigned int lastUse;
+		};
+
+		static void buildQuad(std::vector<float>& vertices, const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec2& offset, float numberOfRows, float numberOfColumns, float opacity, const glm::vec4& uvRect);
+		static void buildSliced(std::vector<float>& vertices, const guiQuadSource& source);
+	private:
+		std::unordered_map<const void*, widgetGeometry> _geometry;
+		std::vector<float> _vertices;
+		std::vector<guiRun> _runs;
+
+		// Sequence of the previous frame, a different order also needs an upload
+		std::vector<const void*> _sequence;
+		std::vector<const void*> _lastSequence;
+
+		unsigned int _frame;
+		size_t _rebuildCount;
+		bool _split;
+	};
+
+}
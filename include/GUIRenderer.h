@@ -29,6 +29,7 @@
 
 #include "Shader.h"
 #include "Buffer.h"
+#include "GUIBatch.h"
 
 #include "TextRenderer.h"
 #include "UI/IWidget.h"
@@ -44,36 +45,85 @@
 namespace ExoEngine
 {
 
+	class IRenderer;
+
 	class GUIRenderer
 	{
 	public:
-		GUIRenderer(void);
+		struct guiCommand
+		{
+			enum commandType
+			{
+				QUADS,
+				BEGIN_SCISSOR,
+				END_SCISSOR,
+				LABELS
+			};
+
+			commandType type = QUADS;
+			size_t first = 0;
+			size_t last = 0;
+			glm::vec2 position = glm::vec2(0.0f), size = glm::vec2(0.0f), parentPosition = glm::vec2(0.0f), parentSize = glm::vec2(0.0f);
+
+			// Runs of quads or label lists from first to last, the scissor commands set their boxes
+			static guiCommand make(commandType type, size_t first, size_t last)
+			{
+				guiCommand command;
+				command.type = type;
+				command.first = first;
+				command.last = last;
+				return (command);
+			}
+		};
+
+		// The renderer gives the window size and the UI scale of the frame
+		GUIRenderer(IRenderer* renderer);
 		~GUIRenderer(void);
 
 		void add(IWidget* widget);
 		void remove(IWidget* widget);
-		void render(const glm::mat4& orthographic);
+		void render(void);
+
+		// Walk the widgets and rebuild their geometry without any GL call, then upload and draw on the GL thread
+		void record(void);
+		void submit(void);
+
+		// Getters, what record() produced: QUADS are runs of the batch, LABELS a label list
+		const GUIBatch& getBatch(void) const;
+		const std::vector<guiCommand>& getCommands(void) const;
+		const std::vector<Label*>& getLabels(size_t list) const;
 	private:
-		void prepare(const glm::mat4& orthographic);
+		void prepare(void);
+		void execute(void);
+		void flushQuads(void);
+		void pushQuad(const void* key, const std::shared_ptr<ITexture>& texture, const glm::vec2& position, const glm::vec2& size, float opacity, const glm::vec2& offset = glm::vec2(0.0f), float numberOfRows = 1.0f, float numberOfColumns = 1.0f, float rotation = 0.0f);
+		void pushSliced(const void* key, const std::shared_ptr<ITexture>& texture, const glm::vec2& position, const glm::vec2& size, float opacity, bool hover);
 	private:
-		unsigned char render(IWidget* widget, Shader* shader);
-		unsigned char render(Button* button, Shader* shader);
-		unsigned char render(Checkbox* checkbox, Shader* shader);
-		unsigned char render(Select* select, Shader* shader);
-		unsigned char render(Input* input, Shader* shader);
-		unsigned char render(Image* image, Shader* shader);
-		unsigned char render(Spinner* spinner, Shader* shader);
-		unsigned char render(View* view, Shader* shader);
-		unsigned char render(Slider* slider, Shader* shader);
-
-		static void drawSliced(Shader* shader, unsigned int offsetX, unsigned int offsetY, float positionX, float positionY, float sizeX, float sizeY, bool isHoverOffset, unsigned int numberOfRows, unsigned int numberOfColumns);
+		void record(IWidget* widget);
+		void record(Button* button);
+		void record(Checkbox* checkbox);
+		void record(Select* select);
+		void record(Input* input);
+		void record(Image* image);
+		void record(Spinner* spinner);
+		void record(View* view);
+		void record(Slider* slider);
 	public:
 		static Shader* pGuiShader;
 	private:
+		IRenderer* _pRenderer;
 		std::deque<IWidget*> _renderQueue;
 		std::deque<IWidget*> _renderFrontQueue;
 
-		glm::mat4 _orthographic;
+		// Retained geometry and the commands of the frame
+		GUIBatch _batch;
+		std::vector<guiCommand> _commands;
+		std::vector<std::vector<Label*>> _labelLists;
+		size_t _labelListCount;
+		size_t _lastRun;
+		bool _uploadPending;
+		TextRenderer _viewTextRenderer;
+
 		Buffer* _vaoBuffer;
 		Buffer* _vertexBuffer;
 	};	
@@ -24,28 +24,43 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Shader.h"
 #include "Buffer.h"
 
 namespace ExoEngine
 {
 
+	// Every line of the grid lives in one vertex buffer, drawn with a single call. The buffer is rebuilt
+	// only when the size changes, moving the grid only changes its model matrix.
 	class Grid
 	{
 		public:
 			Grid(int width, int height, glm::vec2 pos);
 			virtual ~Grid(void);
 
-			void render(const glm::mat4& lookAt, const glm::mat4& perspective);
+			void render(void);
+
+			// Setters
+			void setSize(unsigned int width, unsigned int height);
+			void setPosition(const glm::vec2& pos);
 		private:
-			void drawLine(int x, int y, float angle);
+			void build(void);
 		public:
+			static void loadUniforms(void);
+
 			static Shader* pShader;
-			static Buffer* vaoBuffer;
-			static Buffer* vertexBuffer;
+			static UniformHandle<glm::mat4> modelUniform;
+			static UniformHandle<glm::vec4> colorUniform;
 		private:
 			unsigned int _width, _height;
 			glm::vec2 _pos;
+
+			Buffer* _pVaoBuffer;
+			Buffer* _pVertexBuffer;
+			std::vector<float> _vertices;
+			bool _dirty;
 	};
 
-}
+}
\ No newline at end of file
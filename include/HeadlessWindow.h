@@ -0,0 +1,69 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#ifdef EXO_HEADLESS
+
+#include <EGL/egl.h>
+
+#include "Window.h"
+
+namespace ExoEngine
+{
+
+	// Window without a display: EGL contexts on Mesa's surfaceless platform (or the default display),
+	// the post-processing chain writes an offscreen target which readPixels copies back.
+	// Picked by RendererSDLOpenGL::initialize with WindowMode::HEADLESS, for benchmarks and CI.
+	class HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(uint32_t width, uint32_t height);
+		virtual ~HeadlessWindow(void);
+
+		virtual void handleEvents(Keyboard& keyboard, Mouse& mouse);
+		virtual void swap(void);
+		virtual void handleThread(void);
+
+		// Setters
+		virtual void setWindowSize(int w, int h);
+		virtual void setWindowMode(const WindowMode &mode);
+		virtual void setVsync(bool vsync);
+		virtual void isCursorVisible(bool visible);
+
+		// Getters
+		virtual void* getWindowID();
+		virtual void* getGLContext();
+	private:
+		void initialize(uint32_t width, uint32_t height);
+		void initializeEGL(void);
+		void releaseEGL(void);
+	private:
+		EGLDisplay		_display;
+		EGLContext		_eglContext;
+		EGLContext		_eglThreadContext;
+	};
+
+}
+
+#endif
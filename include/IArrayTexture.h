@@ -45,6 +45,12 @@ namespace ExoEngine
 
 		virtual void bind(int unit = 0) const = 0;
 		virtual void unbind() const = 0;
+
+		// False while an asynchronous upload is still running, binding is allowed anyway
+		virtual bool isReady(void) const
+		{
+			return (true);
+		}
 	};
 
 }
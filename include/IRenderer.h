@@ -34,10 +34,17 @@
 #include "IShader.h"
 #include "ITexture.h"
 #include "IArrayTexture.h"
+#include "ITextureAtlas.h"
 #include "IFrameBuffer.h"
 #include "sprite.h"
+#include "frameStats.h"
+#include "RenderQueue.h"
 #include "MousePicker.h"
 #include "Axis.h"
+#include "TileMap.h"
+#include "Lighting.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
 #include "UI/ICursor.h"
 #include "UI/Label.h"
 
@@ -64,17 +71,25 @@ namespace ExoEngine
 		virtual ITexture		*createTexture(const std::string& filePath, TextureFilter filter = TextureFilter::LINEAR) = 0;
 		virtual ITexture		*createTexture(unsigned int width, unsigned int height, TextureFormat format = TextureFormat::RGBA, TextureFilter filter = TextureFilter::LINEAR) = 0;
 		virtual IArrayTexture	*createArrayTexture(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR) = 0;
+		virtual ITextureAtlas	*createTextureAtlas(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR) = 0;
 		virtual IFrameBuffer	*createFrameBuffer(void) = 0;
 
 		virtual IImage* createImage(const std::shared_ptr<ITexture>& texture) = 0;
 
-		virtual void add(sprite &s) = 0;
+		virtual RenderHandle add(sprite &s) = 0;
 		virtual void add(IWidget* widget) = 0;
 		virtual void add(Label* label) = 0;
+		virtual void add(TileMap* tileMap) = 0;
+		virtual void add(ParticleEmitter* emitter) = 0;
 
+		virtual void update(RenderHandle handle, const sprite &s) = 0;
+
+		virtual void remove(RenderHandle handle) = 0;
 		virtual void remove(sprite &s) = 0;
 		virtual void remove(IWidget* widget) = 0;
 		virtual void remove(Label* label) = 0;
+		virtual void remove(TileMap* tileMap) = 0;
+		virtual void remove(ParticleEmitter* emitter) = 0;
 
 		virtual void draw(void) = 0;
 		virtual void swap(void) = 0;
@@ -89,6 +104,10 @@ namespace ExoEngine
 		virtual Keyboard *getKeyboard(void) = 0;
 		virtual Mouse *getMouse(void) = 0;
 		virtual unsigned int getTime(void) const = 0;
+		virtual Lighting *getLighting(void) = 0;
+		virtual const particleStats &getParticleStats(void) const = 0;
+		virtual const frameStats &getFrameStats(void) const = 0;
+		virtual Profiler *getProfiler(void) = 0;
 
 		// Setters
 		void setNavigationType(const NavigationType& type) { _currentNavigationType = type; }
@@ -97,6 +116,19 @@ namespace ExoEngine
 		virtual void setMousePicker(MousePicker* picker) = 0;
 		virtual void setAxis(Axis* axis) = 0;
 		virtual void setGridEnable(bool val) = 0;
+		virtual void setCulling(bool enabled, float cellSize = 0.0f) = 0;
+
+		// Sprites shaded by the lights of getLighting, normal mapped when they have a normal map
+		virtual void setLighting(bool enabled) = 0;
+
+		// Live particles allowed over every emitter, the spawns past it are dropped
+		virtual void setParticleBudget(unsigned int budget) = 0;
+
+		// Block compression of the textures loaded afterwards, when the driver supports it
+		virtual void setTextureCompression(bool enabled) = 0;
+
+		// Profiler times in the top left corner, GPU timers turned on; nullptr removes them
+		virtual void setProfilerOverlay(const std::shared_ptr<Font>& font) = 0;
 	protected:
 		NavigationType _currentNavigationType;
 		float		_UIScaleFactor;
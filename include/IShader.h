@@ -30,6 +30,26 @@
 namespace ExoEngine
 {
 
+	// Uniform location resolved once after link, T is the GLSL type it is bound to
+	template <typename T>
+	struct UniformHandle
+	{
+		UniformHandle(void)
+		: location(-1)
+		{	}
+
+		explicit UniformHandle(int location)
+		: location(location)
+		{	}
+
+		bool isValid(void) const
+		{
+			return (location >= 0);
+		}
+
+		int location;
+	};
+
 	class IShader
 	{
 	public:
@@ -42,8 +62,28 @@ namespace ExoEngine
 		virtual void bind() const = 0;
 		virtual void unbind() const = 0;
 
+		// Uniforms
+		virtual int getUniformLocation(const std::string &name) const = 0;
+
+		template <typename T>
+		UniformHandle<T> getUniform(const std::string &name) const
+		{
+			return (UniformHandle<T>(getUniformLocation(name)));
+		}
+
+		virtual void set(const UniformHandle<glm::mat4> &handle, const glm::mat4 &value) const = 0;
+		virtual void set(const UniformHandle<glm::vec4> &handle, const glm::vec4 &value) const = 0;
+		virtual void set(const UniformHandle<glm::vec3> &handle, const glm::vec3 &value) const = 0;
+		virtual void set(const UniformHandle<glm::vec2> &handle, const glm::vec2 &value) const = 0;
+		virtual void set(const UniformHandle<float> &handle, float value) const = 0;
+		virtual void set(const UniformHandle<int> &handle, int value) const = 0;
+
+		virtual void bindUniformBlock(const std::string &name, unsigned int binding) const = 0;
+
 		// Setters
 		virtual void setMat4(const std::string &name, const glm::mat4 &value) const = 0;
+		virtual void setVec4(const std::string &name, const glm::vec4 &value) const = 0;
+		virtual void setVec4(const std::string &name, float x, float y, float z, float w) const = 0;
 		virtual void setVec3(const std::string &name, const glm::vec3 &value) const = 0;
 		virtual void setVec3(const std::string &name, float x, float y, float z) const = 0;
 		virtual void setVec2(const std::string &name, const glm::vec2 &value) const = 0;
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <string>
+#include <glm/glm.hpp>
 #include "Enums.h"
 #include "IResource.h"
 
@@ -44,10 +45,22 @@ namespace ExoEngine
 		virtual void unbind() const = 0;
 
 		// Getters
+		// False while an asynchronous upload is still running, binding is allowed anyway
+		virtual bool isReady(void) const
+		{
+			return (true);
+		}
+
 		virtual int getEngineId(void) const = 0;
 
 		virtual int getWidth(void) const = 0;
 		virtual int getHeight(void) const = 0;
+
+		// Area of the bound texture covered by this one, as u, v, width, height
+		virtual glm::vec4 getUVRect(void) const
+		{
+			return (glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+		}
 	};
 
 }
@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "Enums.h"
 #include "IFrameBuffer.h"
 
@@ -45,6 +49,15 @@ namespace ExoEngine
 		virtual void setWindowMode(const WindowMode &mode) = 0;
 		virtual void setVsync(bool vsync) = 0;
 
+		// Post processing: passes run in the order they are added, the scene can be rendered at a
+		// fraction of the context size (frame time target in milliseconds, 0 keeps the scale fixed)
+		virtual void addPostProcess(const std::string& name, const std::string& filePath) = 0;
+		virtual void removePostProcess(const std::string& name) = 0;
+		virtual void setPostProcessEnabled(const std::string& name, bool enabled) = 0;
+		virtual void setResolutionScale(float scale) = 0;
+		virtual void setFrameTimeTarget(double frameTime) = 0;
+		virtual float getResolutionScale(void) const = 0;
+
 		// Getters
 		virtual void* getWindowID() = 0;
 		virtual void* getGLContext() = 0;
@@ -62,6 +75,9 @@ namespace ExoEngine
 		virtual bool getIsClosing(void) const = 0;
 
 		virtual IFrameBuffer *getFrameBuffer(void) const = 0;
+
+		// Last presented frame, RGBA8 at the context size, rows from top to bottom
+		virtual void readPixels(std::vector<uint8_t>& pixels) const = 0;
 	protected:
 		uint64_t		_now, _last;
 		int			 _width, _height;
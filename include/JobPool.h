@@ -0,0 +1,74 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ExoEngine
+{
+
+	// Worker threads for the per frame jobs. A thread waiting for its jobs runs queued ones meanwhile,
+	// so jobs can start other jobs without blocking a worker.
+	class JobPool
+	{
+	public:
+		// 0 uses every hardware thread but the calling one
+		JobPool(unsigned int workers = 0);
+		~JobPool(void);
+
+		// Run the jobs and return once they are all done
+		void run(const std::vector<std::function<void(void)>>& jobs);
+
+		// Split [0, count) in chunks of grain items, the chunks only depend on the grain so the
+		// split is the same whatever the number of workers
+		void parallelFor(size_t count, size_t grain, const std::function<void(size_t chunk, size_t begin, size_t end)>& function);
+
+		// Getters
+		unsigned int getWorkerCount(void) const;
+	private:
+		struct pendingJob
+		{
+			std::function<void(void)> function;
+			std::atomic<size_t>* remaining;
+		};
+
+		bool execute(void);
+		void wait(std::atomic<size_t>& remaining);
+		void loop(void);
+	private:
+		std::vector<std::thread> _threads;
+		std::deque<pendingJob> _jobs;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		bool _joining;
+	};
+
+}
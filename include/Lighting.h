@@ -0,0 +1,153 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Buffer.h"
+#include "Texture.h"
+#include "FrameBuffer.h"
+
+// Side of a screen tile in pixels, the lights are binned per tile
+#define LIGHT_TILE_SIZE			32
+
+// Texels of the light buffer per light: position, radius, intensity then color, shadows
+#define LIGHT_TEXELS			2
+
+// The shadow mask is drawn at a fraction of the render resolution
+#define LIGHT_SHADOW_DOWNSAMPLE	2
+
+namespace ExoEngine
+{
+
+	typedef uint32_t LightHandle;
+
+	static const LightHandle INVALID_LIGHT_HANDLE = 0xFFFFFFFF;
+
+	struct pointLight
+	{
+		glm::vec2 position;
+		glm::vec3 color;
+		float radius;
+		float intensity;
+		bool castShadows;
+
+		pointLight()
+		: position(0.0f), color(1.0f), radius(1.0f), intensity(1.0f), castShadows(false)
+		{	}
+
+		pointLight(const glm::vec2& position, const glm::vec3& color, float radius, float intensity = 1.0f, bool castShadows = false)
+		: position(position), color(color), radius(radius), intensity(intensity), castShadows(castShadows)
+		{	}
+	};
+
+	// Point lights in the z = 0 plane. Every frame the lights are projected and binned into screen tiles
+	// (four lights per SSE iteration), then the visible lights and the per-tile lists are uploaded in
+	// three buffer textures. A fragment only loops over the lights of its tile.
+	//
+	// Sprite shader inputs: "lights" (two RGBA32F texels per light), "lightTiles" (offset and count per
+	// tile, RG32UI), "lightIndices" (R32UI) and "shadowMask" when shadows are enabled.
+	class Lighting
+	{
+	public:
+		Lighting(void);
+		~Lighting(void);
+
+		LightHandle add(const pointLight& light);
+		void update(LightHandle handle, const pointLight& light);
+		void remove(LightHandle handle);
+		void clear(void);
+
+		// Bins the lights for a viewport of width x height pixels, no GL call
+		void cull(const glm::mat4& viewProjection, int width, int height);
+
+		// Uploads what cull produced and binds the buffer textures from unit
+		void upload(void);
+		void bind(unsigned int unit) const;
+
+		// The occluders are drawn in the shadow mask between these calls, the previous target is restored after
+		void beginShadows(void);
+		void endShadows(void);
+
+		// Setters
+		void setAmbient(const glm::vec3& ambient);
+		void setShadows(bool enabled);
+
+		// Getters
+		const pointLight& get(LightHandle handle) const;
+		bool contains(LightHandle handle) const;
+		size_t size(void) const;
+		const glm::vec3& getAmbient(void) const;
+		bool isShadowEnabled(void) const;
+		bool hasShadowCasters(void) const;
+		unsigned int getVisibleCount(void) const;
+		unsigned int getTilesX(void) const;
+		unsigned int getTilesY(void) const;
+		const glm::vec2& getViewport(void) const;
+		Texture* getShadowMask(void) const;
+	private:
+		void project(const glm::mat4& viewProjection, size_t begin, size_t end);
+		void bin(void);
+		void createBuffers(void);
+		void createShadowMask(int width, int height);
+		void destroyShadowMask(void);
+	private:
+		// Packed lights, positions and radii also stored as arrays for the projection
+		std::vector<pointLight> _lights;
+		std::vector<float> _positionX;
+		std::vector<float> _positionY;
+		std::vector<float> _radius;
+		std::vector<LightHandle> _indexToHandle;
+		std::vector<uint32_t> _handleToIndex;
+		std::vector<LightHandle> _freeHandles;
+
+		// Tiles covered by every light, minX, minY, maxX, maxY, empty when minX > maxX
+		std::vector<int32_t> _rects;
+
+		// Output of the culling
+		unsigned int _tilesX, _tilesY;
+		glm::vec2 _viewport;
+		std::vector<float> _visibleLights;
+		std::vector<uint32_t> _tiles;
+		std::vector<uint32_t> _cursors;
+		std::vector<uint32_t> _indices;
+		bool _shadowCasters;
+
+		glm::vec3 _ambient;
+		bool _shadows;
+
+		// Buffer textures: lights, tiles, indices
+		Buffer* _pBuffers[3];
+		GLuint _textures[3];
+
+		FrameBuffer* _pShadowFrameBuffer;
+		Texture* _pShadowMask;
+		GLint _previousFrameBuffer;
+		GLint _previousViewport[4];
+	};
+
+}
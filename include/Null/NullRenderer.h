@@ -0,0 +1,119 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "IRenderer.h"
+
+#include "Keyboard.h"
+#include "Mouse.h"
+#include "Camera.h"
+#include "Null/NullWindow.h"
+#include "Null/NullTexture.h"
+
+#include "Utils/Singleton.h"
+
+namespace ExoEngine
+{
+
+	// Renderer of dedicated servers: no window, GL context nor pixels. Everything is accepted and nothing is
+	// drawn, textures only keep their dimensions so the resources can still be loaded and measured
+	class NullRenderer : public IRenderer, public Singleton<NullRenderer>
+	{
+	public:
+
+		//	class methods
+		virtual void initialize(const std::string& title, const int width, const int height, const WindowMode &mode, bool resizable);
+		virtual void resize();
+
+		virtual ICamera		*createCamera(void);
+		virtual ITexture		*createTexture(const std::string& filePath, TextureFilter filter = TextureFilter::LINEAR);
+		virtual ITexture		*createTexture(unsigned int width, unsigned int height, TextureFormat format = TextureFormat::RGBA, TextureFilter filter = TextureFilter::LINEAR);
+		virtual IArrayTexture	*createArrayTexture(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR);
+		virtual ITextureAtlas	*createTextureAtlas(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR);
+		virtual IFrameBuffer	*createFrameBuffer(void);
+
+		virtual IImage* createImage(const std::shared_ptr<ITexture>& texture);
+
+		virtual RenderHandle add(sprite &s);
+		virtual void add(IWidget* widget);
+		virtual void add(Label* label);
+		virtual void add(TileMap* tileMap);
+		virtual void add(ParticleEmitter* emitter);
+
+		virtual void update(RenderHandle handle, const sprite &s);
+
+		virtual void remove(RenderHandle handle);
+		virtual void remove(sprite &s);
+		virtual void remove(IWidget *widget);
+		virtual void remove(Label *label);
+		virtual void remove(TileMap *tileMap);
+		virtual void remove(ParticleEmitter *emitter);
+
+		virtual void draw(void);
+		virtual void swap(void);
+
+		// Getters
+		virtual IWindow *getWindow(void);
+
+		virtual Keyboard *getKeyboard(void);
+		virtual Mouse *getMouse(void);
+		virtual unsigned int getTime(void) const;
+		virtual Lighting *getLighting(void);
+		virtual const particleStats &getParticleStats(void) const;
+		virtual const frameStats &getFrameStats(void) const;
+		virtual Profiler *getProfiler(void);
+
+		// Setters
+		virtual void setCursor(ICursor* cursor);
+		virtual void setMousePicker(MousePicker* picker);
+		virtual void setAxis(Axis* axis);
+		virtual void setGridEnable(bool val);
+		virtual void setCulling(bool enabled, float cellSize = 0.0f);
+		virtual void setLighting(bool enabled);
+		virtual void setParticleBudget(unsigned int budget);
+		virtual void setTextureCompression(bool enabled);
+		virtual void setProfilerOverlay(const std::shared_ptr<Font>& font);
+	private:
+		NullRenderer(void);
+		virtual ~NullRenderer(void);
+	private:
+		friend class Singleton<NullRenderer>;
+		NullWindow* _pWindow;
+
+		// Never pressed, there is no input without a window
+		Keyboard _keyboard;
+		Mouse _mouse;
+
+		// Handles are only given back to the callers, nothing is stored
+		RenderHandle _nextHandle;
+
+		Profiler* _pProfiler;
+		particleStats _particleStats;
+		frameStats _frameStats;
+	};
+
+}
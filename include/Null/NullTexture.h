@@ -0,0 +1,97 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ITexture.h"
+#include "IArrayTexture.h"
+#include "ITextureAtlas.h"
+
+namespace ExoEngine
+{
+
+	// Texture of NullRenderer: only the dimensions, read from the image header without decoding
+	class NullTexture : public ITexture
+	{
+	public:
+		NullTexture(const std::string& filePath);
+		NullTexture(unsigned int width, unsigned int height);
+		virtual ~NullTexture(void);
+
+		virtual void bind(int unit = 0) const;
+		virtual void unbind(void) const;
+
+		// Getters
+		virtual int getEngineId(void) const;
+
+		virtual int getWidth(void) const;
+		virtual int getHeight(void) const;
+
+		// PNG and JPEG sizes come from their header, other formats are decoded by SDL_image then freed;
+		// a missing file is 1x1 like the magenta pixel of the other renderers
+		static void readSize(const std::string& filePath, int& width, int& height);
+	private:
+		int	_id;
+		int	_width, _height;
+	};
+
+	// Array texture of NullRenderer: its size and layer count, the layers are never opened
+	class NullArrayTexture : public IArrayTexture
+	{
+	public:
+		NullArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
+		virtual ~NullArrayTexture(void);
+
+		virtual void initialize(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
+
+		virtual void bind(int unit = 0) const;
+		virtual void unbind(void) const;
+
+		// Getters
+		int getWidth(void) const;
+		int getHeight(void) const;
+		int getLayerCount(void) const;
+	private:
+		int	_width, _height, _layers;
+	};
+
+	// Atlas of NullRenderer: one NullTexture per path, nothing to pack
+	class NullTextureAtlas : public ITextureAtlas
+	{
+	public:
+		NullTextureAtlas(std::vector<std::string>& textures);
+		virtual ~NullTextureAtlas(void);
+
+		// Getters
+		virtual const std::shared_ptr<ITexture>& getTexture(size_t index) const;
+		virtual size_t size(void) const;
+		virtual size_t getPageCount(void) const;
+	private:
+		std::vector<std::shared_ptr<ITexture>>	_textures;
+	};
+
+}
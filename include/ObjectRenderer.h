@@ -24,45 +24,146 @@
 
 #pragma once
 
+#include <vector>
 #include <deque>
+#include <map>
+#include <unordered_map>
 
 #include "Camera.h"
 #include "Shader.h"
 #include "Buffer.h"
+#include "StreamBuffer.h"
 #include "sprite.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include "SpatialGrid.h"
+#include "CommandBuffer.h"
+#include "JobPool.h"
 #include "Grid.h"
+#include "Lighting.h"
 
 #include "Axis.h"
 
+// Sprites packed by one recording job
+#define SPRITE_RECORD_GRAIN 2048
+
+// Texture pairs in use at once, the material id is the 16 bit texture field of the render key
+#define SPRITE_MATERIAL_LIMIT 0x10000
+
 namespace ExoEngine
 {
 
+	// Per instance data streamed to the sprite shader (attributes 2, 3 and 4)
+	struct spriteInstance
+	{
+		glm::vec2 position;
+		glm::vec2 scale;
+		float angle;
+		float layer;
+		float flipHorizontal;
+		float flipVertical;
+		float animationStart;
+		float frameCount;		// 0 without animation
+		float frameDuration;
+		float loop;
+	};
+
+	// State of a draw packet, the normal map is sampled with the layer of the sprite
+	struct spriteMaterial
+	{
+		const IArrayTexture* texture;
+		const IArrayTexture* normalMap;
+	};
+
 	class ObjectRenderer
 	{
 	public:
 		ObjectRenderer(void);
 		virtual ~ObjectRenderer(void);
 
-		void add(const sprite &s);
+		RenderHandle add(const sprite &s);
+		void update(RenderHandle handle, const sprite &s);
+		void remove(RenderHandle handle);
 		void remove(const sprite &s);
 		void render(Camera* camera, const glm::mat4& perspective);
 
+		// Cull and pack the visible sprites without any GL call, the jobs of the pool share the work
+		void record(const glm::mat4& viewProjection, JobPool* pool = nullptr);
+
+		// Upload and draw what was recorded, on the GL thread
+		void submit(void);
+
 		// Setters
 		void setGrid(bool val);
+		void setCulling(bool enabled, float cellSize = 0.0f);
+
+		// Lights culled by the caller before submit, nullptr draws the sprites unlit
+		void setLighting(Lighting* lighting);
 	private:
-		void prepare(Camera* camera, const glm::mat4& perspective);
-		static void renderObject(sprite& s, Shader* shader);
+		void prepare(void);
+		const std::vector<renderEntry>& cull(const glm::mat4& viewProjection, JobPool* pool);
+		void recordChunk(const std::vector<renderEntry>& entries, size_t chunk, size_t begin, size_t end);
+		void uploadInstances(void);
+		static void forEachChunk(JobPool* pool, size_t count, size_t grain, const std::function<void(size_t chunk, size_t begin, size_t end)>& function);
+		static void spriteBounds(const sprite& s, glm::vec2& center, glm::vec2& extent);
+		uint16_t acquireMaterial(const sprite& s);
+		void releaseMaterial(uint16_t material);
+		static uint64_t makeKey(const sprite& s, uint16_t material, uint32_t depth);
+		void prepareLighting(const std::vector<drawPacket>& packets);
+		static void renderBatch(const spriteMaterial* material, bool lit, unsigned long instanceOffset, size_t first, size_t count);
 	public:
+		static void loadUniforms(void);
+
 		static Shader* pShader;
+		static UniformHandle<float> sizeUniform;
+		static UniformHandle<int> lightingUniform;
+		static UniformHandle<int> normalMappedUniform;
+		static UniformHandle<int> occluderUniform;
+		static UniformHandle<int> shadowsUniform;
+		static UniformHandle<glm::vec3> ambientUniform;
+		static UniformHandle<float> lightTileSizeUniform;
+		static UniformHandle<int> lightTilesXUniform;
+		static UniformHandle<glm::vec2> lightViewportUniform;
+
 		static Buffer* vaoBuffer;
 		static Buffer* vertexBuffer;
 		static Buffer* indexBuffer;
 		static Buffer* uvBuffer;
+		static StreamBuffer* instanceStream;
 	private:
 		bool _gridEnabled;
 		bool _axisEnabled;
+		bool _cullingEnabled;
+
+		RenderQueue _renderQueue;
+		std::unordered_map<const sprite*, RenderHandle> _spriteHandles;
+		std::map<std::pair<const IArrayTexture*, const IArrayTexture*>, uint16_t> _materialIds;
+		std::deque<spriteMaterial> _materials;
+		std::vector<uint32_t> _materialUsers;
+		std::vector<uint16_t> _freeMaterials;
+		std::vector<uint16_t> _handleMaterials;
+		std::vector<uint32_t> _depths;
+		std::vector<const sprite*> _owners;
+		uint32_t _depth;
+		std::vector<spriteInstance> _instances;
+		unsigned long _instanceOffset;
+
+		// Runs of sprites sharing an array texture, one buffer per recording chunk then merged
+		CommandBuffer _commands;
+		std::vector<CommandBuffer> _chunkCommands;
+
+		// Culling
+		Frustum _frustum;
+		SpatialGrid *_pSpatialGrid;
+		std::vector<uint32_t> _queryHandles;
+		std::vector<renderEntry> _candidates;
+		std::vector<renderEntry> _visible;
+		std::vector<renderEntry> _swap;
+		std::vector<float> _bounds;
+		std::vector<uint8_t> _visibility;
+
+		Lighting *_pLighting;
 
-		std::deque<sprite> _renderQueue;
 		Grid	*_pGrid;
 	};
 
@@ -0,0 +1,118 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <glm/glm.hpp>
+
+#include "IArrayTexture.h"
+
+// Floats per packed particle: position (2), life fraction, angle
+#define PARTICLE_INSTANCE_SIZE 4
+
+namespace ExoEngine
+{
+
+	// Ranges are (min, max), interpolated values are (start, end) over the life of a particle
+	struct emitterSettings
+	{
+		unsigned int capacity;
+		float rate;				// particles per second
+		glm::vec2 lifetime;		// seconds
+		glm::vec2 speed;
+		glm::vec2 direction;	// radians
+		glm::vec2 spin;			// radians per second
+		glm::vec2 gravity;
+		glm::vec2 scale;
+		glm::vec4 startColor;
+		glm::vec4 endColor;
+		int firstFrame;			// layers of the array texture played over the life
+		int frameCount;
+		bool additive;
+
+		emitterSettings()
+		: capacity(10000), rate(100.0f), lifetime(1.0f, 2.0f), speed(50.0f, 100.0f), direction(0.0f, 6.2831853f), spin(0.0f),
+		gravity(0.0f), scale(16.0f, 16.0f), startColor(1.0f), endColor(1.0f, 1.0f, 1.0f, 0.0f), firstFrame(0), frameCount(1), additive(false)
+		{	}
+	};
+
+	// Particles stored as arrays of floats, updated four at a time. Only the simulation lives here,
+	// the ParticleSystem packs and draws the emitters.
+	class ParticleEmitter
+	{
+	public:
+		ParticleEmitter(const std::shared_ptr<IArrayTexture>& texture, const emitterSettings& settings);
+		~ParticleEmitter(void);
+
+		// Moves the particles, removes the dead ones then spawns at most budget particles, which is decreased
+		void update(float delta, unsigned int& budget);
+
+		// Spawned by the next update, on top of the rate
+		void burst(unsigned int count);
+
+		// Writes PARTICLE_INSTANCE_SIZE floats per live particle
+		void pack(float* out) const;
+
+		// Getters
+		unsigned int getCount(void) const;
+		unsigned int getDropped(void) const;
+		unsigned int getSpawned(void) const;
+		const glm::vec2& getPosition(void) const;
+		const emitterSettings& getSettings(void) const;
+		const std::shared_ptr<IArrayTexture>& getTexture(void) const;
+		bool isEmitting(void) const;
+
+		// Setters
+		void setPosition(const glm::vec2& position);
+		void setEmitting(bool emitting);
+		void setRate(float rate);
+	private:
+		void simulate(float delta);
+		void kill(void);
+		void spawn(unsigned int count);
+		float random(const glm::vec2& range);
+	private:
+		std::shared_ptr<IArrayTexture> _texture;
+		emitterSettings _settings;
+		glm::vec2 _position;
+		bool _emitting;
+
+		// Live particles are the first _count entries
+		std::vector<float> _x, _y;
+		std::vector<float> _velocityX, _velocityY;
+		std::vector<float> _age, _inverseLife;
+		std::vector<float> _angle, _spin;
+		unsigned int _count;
+
+		float _accumulator;
+		unsigned int _pending;
+		unsigned int _spawned;
+		unsigned int _dropped;
+		std::minstd_rand _random;
+	};
+
+}
@@ -0,0 +1,101 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Buffer.h"
+#include "StreamBuffer.h"
+#include "UniformRing.h"
+#include "ParticleEmitter.h"
+
+// Live particles allowed by default, over every emitter
+#define PARTICLE_DEFAULT_BUDGET 100000
+
+// Binding point of the "Emitter" uniform block
+#define EMITTER_UNIFORM_BINDING 1
+
+namespace ExoEngine
+{
+
+	struct particleStats
+	{
+		unsigned int emitters;
+		unsigned int alive;
+		unsigned int spawned;
+		unsigned int dropped;	// spawns refused by the budget or the capacity
+		unsigned int drawCalls;
+		double updateTime;		// milliseconds
+	};
+
+	// std140 layout of the "Emitter" uniform block, one per draw call
+	struct emitterUniforms
+	{
+		glm::vec4 startColor;
+		glm::vec4 endColor;
+		glm::vec2 scale;
+		glm::vec2 frames;	// first layer, layer count
+	};
+
+	// Updates the emitters within a per-frame budget of live particles, then draws each emitter with one
+	// instanced call. A particle is streamed as one vec4, size, color and frame are interpolated on the GPU.
+	class ParticleSystem
+	{
+	public:
+		ParticleSystem(void);
+		~ParticleSystem(void);
+
+		void add(ParticleEmitter* emitter);
+		void remove(ParticleEmitter* emitter);
+
+		// Simulation and packing, no GL call. delta in milliseconds.
+		void update(double delta);
+
+		// Upload and draw, on the GL thread. The parameters of every emitter are pushed in the ring.
+		void render(UniformRing* ring);
+
+		// Setters
+		void setBudget(unsigned int budget);
+
+		// Getters
+		unsigned int getBudget(void) const;
+		const particleStats& getStats(void) const;
+	public:
+		static Shader* pShader;
+
+		static Buffer* vaoBuffer;
+		static Buffer* vertexBuffer;
+		static StreamBuffer* instanceStream;
+	private:
+		std::vector<ParticleEmitter*> _emitters;
+		std::vector<unsigned int> _offsets;
+		std::vector<float> _instances;
+		unsigned int _budget;
+		particleStats _stats;
+	};
+
+}
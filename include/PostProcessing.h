@@ -0,0 +1,136 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "Buffer.h"
+#include "Texture.h"
+#include "FrameBuffer.h"
+
+// Dynamic resolution: bounds of the scale, size of a change and frames between two changes
+#define DYNAMIC_RESOLUTION_MIN		0.5f
+#define DYNAMIC_RESOLUTION_STEP		0.05f
+#define DYNAMIC_RESOLUTION_DELAY	15
+
+namespace ExoEngine
+{
+
+	struct postProcessPass
+	{
+		std::string name;
+		Shader* pShader;
+		UniformHandle<glm::vec2> uvScaleUniform;
+		UniformHandle<glm::vec2> texelSizeUniform;
+		bool enabled;
+	};
+
+	// Ordered chain of full screen passes. The scene is drawn in a corner of the scene target, scaled by
+	// the resolution scale, the passes ping-pong between two targets of the same size and the last one
+	// upscales to the default framebuffer.
+	//
+	// A pass samples "screenTexture" and must multiply its texture coordinates by "uvScale", the part of
+	// the target holding the image. "texelSize" gives the size of one texel of the input.
+	//
+	// Offscreen, the last pass writes an output target of the context size instead of the default
+	// framebuffer, for contexts without one (headless).
+	class PostProcessing
+	{
+	public:
+		PostProcessing(void);
+		~PostProcessing(void);
+
+		// (Re)creates the targets, at the size of the context
+		void initialize(int width, int height);
+
+		// Frees the GL objects, before the context goes away
+		void release(void);
+
+		// Binds and clears the scene target, viewport at the render resolution
+		void begin(void);
+
+		// Runs the enabled passes, the result lands in the default framebuffer (or the output target)
+		void apply(void);
+
+		// Copies the last applied frame, RGBA8 rows from top to bottom
+		void readPixels(std::vector<uint8_t>& pixels) const;
+
+		// Passes, run in the order they are added. The chain takes the ownership of the shader.
+		void addPass(const std::string& name, Shader* shader);
+		void removePass(const std::string& name);
+		void setPassEnabled(const std::string& name, bool enabled);
+		bool isPassEnabled(const std::string& name) const;
+
+		// Dynamic resolution, frameTime in milliseconds
+		void update(double frameTime);
+
+		// Setters
+		void setResolutionScale(float scale);
+		void setFrameTimeTarget(double frameTime);
+		void setOffscreen(bool offscreen);
+
+		// Getters
+		float getResolutionScale(void) const;
+		double getFrameTimeTarget(void) const;
+		int getRenderWidth(void) const;
+		int getRenderHeight(void) const;
+		FrameBuffer* getSceneFrameBuffer(void) const;
+		Texture* getSceneTexture(void) const;
+		FrameBuffer* getOutputFrameBuffer(void) const;
+		bool isOffscreen(void) const;
+	private:
+		void createTarget(FrameBuffer*& frameBuffer, Texture*& texture);
+		void destroyTargets(void);
+		void drawPass(const postProcessPass& pass, Texture* input);
+		postProcessPass* findPass(const std::string& name);
+	private:
+		int _width, _height;
+		float _scale;
+
+		double _frameTimeTarget;
+		double _averageFrameTime;
+		unsigned int _framesSinceChange;
+
+		FrameBuffer* _pSceneFrameBuffer;
+		Texture* _pSceneTexture;
+		FrameBuffer* _pPingPongFrameBuffers[2];
+		Texture* _pPingPongTextures[2];
+
+		bool _offscreen;
+		FrameBuffer* _pOutputFrameBuffer;
+		Texture* _pOutputTexture;
+
+		std::vector<postProcessPass> _passes;
+		postProcessPass _copyPass;
+
+		Buffer _vertexArrayObject;
+		Buffer _arrayBuffer;
+		Buffer _uvMappingBuffer;
+	};
+
+}
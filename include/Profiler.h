@@ -0,0 +1,127 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "OGLCall.h"
+
+// Frames kept for the statistics
+#define PROFILER_HISTORY		256
+
+// GPU timers are read back this many frames later, the driver has finished them by then
+#define PROFILER_QUERY_FRAMES	4
+
+// Frames between two refreshes of the overlay
+#define PROFILER_OVERLAY_INTERVAL	30
+
+namespace ExoEngine
+{
+
+	// Stages of RendererSDLOpenGL::draw and swap, in the order they run
+	enum ProfileStage
+	{
+		PROFILE_MOUSE_PICKER = 0,
+		PROFILE_RECORD,
+		PROFILE_TILE_MAPS,
+		PROFILE_OBJECTS,
+		PROFILE_PARTICLES,
+		PROFILE_AXIS,
+		PROFILE_GUI,
+		PROFILE_TEXT,
+		PROFILE_POST_PROCESSING,
+		PROFILE_STAGE_COUNT
+	};
+
+	// Times of a stage over the history, milliseconds
+	struct profileStats
+	{
+		double min;
+		double average;
+		double p99;
+	};
+
+	// CPU and GPU time of every stage of the frame. The CPU side is always measured, the GPU side uses a
+	// GL_TIME_ELAPSED query per stage when enabled (one query can run at a time: stages never nest).
+	// A stage which did not run in a frame counts for 0.
+	class Profiler
+	{
+	public:
+		Profiler(void);
+		~Profiler(void);
+
+		void beginFrame(void);
+		void endFrame(void);
+
+		void begin(ProfileStage stage);
+		void end(ProfileStage stage);
+
+		// Setters
+		void setGpuTimers(bool enabled);
+
+		// Getters
+		bool hasGpuTimers(void) const;
+		unsigned long getFrameCount(void) const;
+		double getCpuTime(ProfileStage stage) const;
+		double getGpuTime(ProfileStage stage) const;
+		profileStats getCpuStats(ProfileStage stage) const;
+		profileStats getGpuStats(ProfileStage stage) const;
+
+		// One line per stage: CPU then GPU average and p99
+		std::string getReport(void) const;
+
+		static const char* getStageName(ProfileStage stage);
+	private:
+		void collect(unsigned int slot);
+		static profileStats computeStats(const double (*history)[PROFILE_STAGE_COUNT], unsigned int count, ProfileStage stage);
+	private:
+		// Rings of the last frames, the newest row is the one before the index
+		double _cpu[PROFILER_HISTORY][PROFILE_STAGE_COUNT];
+		double _gpu[PROFILER_HISTORY][PROFILE_STAGE_COUNT];
+		unsigned int _cpuIndex, _cpuCount;
+		unsigned int _gpuIndex, _gpuCount;
+		unsigned long _frame;
+
+		std::chrono::high_resolution_clock::time_point _starts[PROFILE_STAGE_COUNT];
+		double _current[PROFILE_STAGE_COUNT];
+
+		bool _gpuTimers;
+		bool _gpuSupported;
+		GLuint _queries[PROFILER_QUERY_FRAMES][PROFILE_STAGE_COUNT];
+		bool _pending[PROFILER_QUERY_FRAMES][PROFILE_STAGE_COUNT];
+	};
+
+	// Times the enclosing block
+	class ProfileScope
+	{
+	public:
+		ProfileScope(Profiler* profiler, ProfileStage stage) : _pProfiler(profiler), _stage(stage) { _pProfiler->begin(_stage); }
+		~ProfileScope(void) { _pProfiler->end(_stage); }
+	private:
+		Profiler* _pProfiler;
+		ProfileStage _stage;
+	};
+
+}
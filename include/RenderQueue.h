@@ -0,0 +1,98 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "sprite.h"
+
+namespace ExoEngine
+{
+
+	typedef uint32_t RenderHandle;
+
+	static const RenderHandle INVALID_RENDER_HANDLE = 0xFFFFFFFF;
+
+	// Sort key layout, most significant bits first:
+	// [63..48] sprite zOrder, [47..40] shader, [39..24] texture, [23..0] depth (insertion order)
+	struct renderKey
+	{
+		static uint64_t make(int zOrder, uint8_t shader, uint16_t texture, uint32_t depth)
+		{
+			return ((uint64_t)(uint16_t)(zOrder + 0x8000) << 48)
+				| ((uint64_t)shader << 40)
+				| ((uint64_t)texture << 24)
+				| ((uint64_t)(depth & 0xFFFFFF));
+		}
+	};
+
+	struct renderEntry
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	// Retained sprite queue: sprites are stored packed, removal is O(1) through handles
+	// and the draw order is rebuilt with a radix sort on the 64 bits keys
+	class RenderQueue
+	{
+	public:
+		RenderQueue(void);
+		~RenderQueue(void);
+
+		RenderHandle add(const sprite& s, uint64_t key);
+		void update(RenderHandle handle, const sprite& s, uint64_t key);
+		void remove(RenderHandle handle);
+		void clear(void);
+
+		// Sort the entries by key, sprites are left in place
+		const std::vector<renderEntry>& sort(void);
+
+		// Stable sort of any set of entries by key
+		static void radixSort(std::vector<renderEntry>& entries, std::vector<renderEntry>& swap);
+
+		// Getters
+		bool contains(RenderHandle handle) const;
+		size_t size(void) const;
+		bool empty(void) const;
+		uint32_t indexOf(RenderHandle handle) const;
+		RenderHandle handleAt(uint32_t index) const;
+		uint64_t keyAt(uint32_t index) const;
+		const sprite& operator[](uint32_t index) const;
+	private:
+		std::vector<sprite> _sprites;
+		std::vector<uint64_t> _keys;
+		std::vector<RenderHandle> _indexToHandle;
+
+		std::vector<uint32_t> _handleToIndex;
+		std::vector<RenderHandle> _freeHandles;
+
+		std::vector<renderEntry> _entries;
+		std::vector<renderEntry> _swap;
+		bool _dirty;
+	};
+
+}
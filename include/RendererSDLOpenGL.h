@@ -31,23 +31,42 @@
 #include "IRenderer.h"
 
 #include "Window.h"
+#include "HeadlessWindow.h"
 #include "Keyboard.h"
 #include "Mouse.h"
 #include "ObjectRenderer.h"
 #include "GUIRenderer.h"
 #include "Grid.h"
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "TextureCache.h"
 #include "Texture.h"
 #include "ArrayTexture.h"
+#include "TextureAtlas.h"
+#include "UniformRing.h"
+#include "GLStateCache.h"
+#include "JobPool.h"
 
 #include <vector>
 #include <UI/Cursor.h>
 
 #include "Utils/Singleton.h"
 
+#define FRAME_UNIFORM_BINDING 0
+#define UNIFORM_RING_SIZE 65536
+
 namespace ExoEngine
 {
 
+	// std140 layout of the "Frame" uniform block
+	struct frameUniforms
+	{
+		glm::mat4 projection;
+		glm::mat4 view;
+		glm::mat4 orthographic;
+		glm::vec4 time;		// x: renderer time in seconds
+	};
+
 	class RendererSDLOpenGL : public IRenderer, public Singleton<RendererSDLOpenGL>
 	{
 	public:
@@ -60,6 +79,7 @@ namespace ExoEngine
 		virtual ITexture		*createTexture(const std::string& filePath, TextureFilter filter = TextureFilter::LINEAR);
 		virtual ITexture		*createTexture(unsigned int width, unsigned int height, TextureFormat format = TextureFormat::RGBA, TextureFilter filter = TextureFilter::LINEAR);
 		virtual IArrayTexture	*createArrayTexture(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR);
+		virtual ITextureAtlas	*createTextureAtlas(int width, int height, std::vector<std::string> &textures, TextureFilter filter = TextureFilter::LINEAR);
 
 		virtual IImage* createImage(const std::shared_ptr<ITexture>& texture);
 
@@ -74,13 +94,20 @@ namespace ExoEngine
 		virtual IView* createView(const std::shared_ptr<ITexture>& backgroundTexture, const std::shared_ptr<ITexture>& scrollTexture, unsigned int numberOfRows = 1, unsigned int numberOfColumns = 1);*/
 		virtual IFrameBuffer* createFrameBuffer(void);
 
-		virtual void add(sprite &s);
+		virtual RenderHandle add(sprite &s);
 		virtual void add(IWidget* widget);
 		virtual void add(Label* label);
+		virtual void add(TileMap* tileMap);
+		virtual void add(ParticleEmitter* emitter);
+
+		virtual void update(RenderHandle handle, const sprite &s);
 
+		virtual void remove(RenderHandle handle);
 		virtual void remove(sprite &s);
 		virtual void remove(IWidget *widget);
 		virtual void remove(Label *label);
+		virtual void remove(TileMap *tileMap);
+		virtual void remove(ParticleEmitter *emitter);
 
 		virtual void draw(void);
 		virtual void swap(void);
@@ -94,12 +121,23 @@ namespace ExoEngine
 		virtual Keyboard *getKeyboard(void);
 		virtual Mouse *getMouse(void);
 		virtual unsigned int getTime(void) const;
+		virtual Lighting *getLighting(void);
+		virtual const particleStats &getParticleStats(void) const;
+		virtual const frameStats &getFrameStats(void) const;
+		virtual Profiler *getProfiler(void);
+		UniformRing *getUniformRing(void);
+		const glStateCounters &getStateCounters(void) const;
 
 		// Setters
 		virtual void setCursor(ICursor* cursor);
 		virtual void setMousePicker(MousePicker* picker);
 		virtual void setAxis(Axis* axis);
 		virtual void setGridEnable(bool val);
+		virtual void setCulling(bool enabled, float cellSize = 0.0f);
+		virtual void setLighting(bool enabled);
+		virtual void setParticleBudget(unsigned int budget);
+		virtual void setTextureCompression(bool enabled);
+		virtual void setProfilerOverlay(const std::shared_ptr<Font>& font);
 	private:
 		RendererSDLOpenGL(void);
 		virtual ~RendererSDLOpenGL(void);
@@ -116,9 +154,21 @@ namespace ExoEngine
 		ObjectRenderer* _pObjectRenderer;
 		GUIRenderer* _pGUIRenderer;
 		TextRenderer* _pTextRenderer;
+		std::vector<TileMap*> _tileMaps;
+		Lighting* _pLighting;
+		bool _lightingEnabled;
+		ParticleSystem* _pParticleSystem;
+		Profiler* _pProfiler;
+		Label* _pProfilerOverlay;
 
 		glm::mat4 _perspective, _orthographic;
+		frameUniforms _frameUniforms;
+		Buffer* _pFrameUniformBuffer;
+		UniformRing* _pUniformRing;
+		JobPool* _pJobPool;
 		int _scissorBit[4];
+		glStateCounters _stateCounters;
+		frameStats _frameStats;
 
 		std::thread::id _mainThread;
 		Cursor* _pCursor;
@@ -32,6 +32,7 @@
 
 #include "IShader.h"
 #include "hitboxes.h"
+#include "animation.h"
 #include "IRenderer.h"
 #include "Audio/Audio.h"
 #include "IResource.h"
@@ -73,6 +74,8 @@ namespace ExoEngine
 			void	loadFont(const std::string& path, xmlNodePtr node);
 			void	loadTexture(const std::string &path, xmlNodePtr node);
 			void	loadArrayTexture(const std::string &path, xmlNodePtr node);
+			void	loadAnimation(const std::string &path, xmlNodePtr node);
+			void	loadAtlas(const std::string &path, xmlNodePtr node);
 			void	loadSound(const std::string &path, xmlNodePtr node);
 			void	loadSubResource(const std::string &path, xmlNodePtr node);
 			void	loadHitboxes(const std::string &path, xmlNodePtr node);
@@ -30,8 +30,10 @@
 #include <GL/glew.h>
 #endif
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "IShader.h"
 
@@ -49,9 +51,27 @@ namespace ExoEngine
 		void initialize(const std::string& filePath);
 		void initialize(const std::vector<std::string>& shaderSource);
 
+		// initialize in two steps: compile starts the work (or loads the cached binary), finishCompile
+		// checks the result. Starting every program before finishing any lets the driver compile in parallel.
+		void compile(const std::string& filePath);
+		void compile(const std::vector<std::string>& shaderSource);
+		void finishCompile(void);
+
 		virtual void bind(void) const;
 		virtual void unbind(void) const;
 
+		// Uniforms
+		virtual int getUniformLocation(const std::string& name) const;
+
+		virtual void set(const UniformHandle<glm::mat4>& handle, const glm::mat4& value) const;
+		virtual void set(const UniformHandle<glm::vec4>& handle, const glm::vec4& value) const;
+		virtual void set(const UniformHandle<glm::vec3>& handle, const glm::vec3& value) const;
+		virtual void set(const UniformHandle<glm::vec2>& handle, const glm::vec2& value) const;
+		virtual void set(const UniformHandle<float>& handle, float value) const;
+		virtual void set(const UniformHandle<int>& handle, int value) const;
+
+		virtual void bindUniformBlock(const std::string& name, unsigned int binding) const;
+
 		// Setters
 		virtual void setMat4(const std::string& name, const glm::mat4& value) const;
 		virtual void setVec4(const std::string& name, const glm::vec4& value) const;
@@ -68,9 +88,17 @@ namespace ExoEngine
 	private:
 		void loadShader(const std::string& filePath, std::string& vertexShaderCode, std::string& fragmentShaderCode);
 		void loadShader(const std::vector<std::string>& shaderSource, std::string& vertexShaderCode, std::string& fragmentShaderCode);
+		void compileProgram(const std::string& vertexShaderCode, const std::string& fragmentShaderCode);
 		unsigned int compileShader(const std::string& shaderCode, const GLenum& type);
+		void checkShader(unsigned int shaderId);
+		void deleteShaders(void);
+		void reflectUniforms(void);
 	private:
 		GLuint _programId;
+		GLuint _vertexShaderId;
+		GLuint _fragmentShaderId;
+		uint64_t _cacheKey;
+		std::unordered_map<std::string, GLint> _uniforms;
 	};
 
 }
@@ -0,0 +1,74 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "OGLCall.h"
+#include "Utils/Singleton.h"
+
+// First bytes of a cached program binary ("EXOP")
+#define SHADER_CACHE_MAGIC 0x504F5845
+
+namespace ExoEngine
+{
+
+	// Linked program binaries saved between runs. The key hashes the sources with the driver strings,
+	// a binary from another driver or version is never loaded, and one the driver rejects is compiled again.
+	class ShaderCache : public Singleton<ShaderCache>
+	{
+	public:
+		// Folder of the binaries, empty disables the cache
+		void setDirectory(const std::string& directory);
+		bool isEnabled(void);
+
+		uint64_t getKey(const std::string& vertexShaderCode, const std::string& fragmentShaderCode);
+
+		// Returns a linked program, 0 when there is no usable binary
+		GLuint load(uint64_t key);
+		void store(uint64_t key, GLuint programId);
+
+		// Getters
+		unsigned int getHits(void) const;
+		unsigned int getMisses(void) const;
+	private:
+		friend class Singleton<ShaderCache>;
+
+		ShaderCache(void);
+		~ShaderCache(void);
+
+		void queryDriver(void);
+		std::string getPath(uint64_t key) const;
+	private:
+		std::string _directory;
+		std::string _driver;
+		bool _queried;
+		bool _supported;
+		unsigned int _hits;
+		unsigned int _misses;
+	};
+
+}
@@ -0,0 +1,125 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/vec4.hpp>
+
+#include "JobPool.h"
+
+// Side of the square tiles the frame is split in, every tile is rasterized by one job
+#define RASTERIZER_TILE_SIZE 64
+
+namespace ExoEngine
+{
+
+	// How the texel of a triangle turns into the color blended over the frame
+	enum RasterMode
+	{
+		RASTER_SPRITE,	// texel, discarded under 0.1 alpha like the sprite shader
+		RASTER_GUI,		// texel, alpha lowered by the opacity of the widget
+		RASTER_TEXT		// color of the state, alpha from the red channel of the font atlas
+	};
+
+	// RGBA8 pixels sampled at the nearest texel, coordinates wrap like GL_REPEAT
+	struct rasterTexture
+	{
+		const uint8_t* pixels;
+		int width;
+		int height;
+	};
+
+	struct rasterState
+	{
+		rasterTexture texture;
+		RasterMode mode;
+		glm::vec4 color;	// rgb: text color, a: widget opacity
+		int scissor[4];		// x0, y0, x1, y1 in pixels, rows from the top, x1 and y1 excluded
+	};
+
+	// Position in pixels of the target, rows from the top
+	struct rasterVertex
+	{
+		float x, y;
+		float u, v;
+	};
+
+	// Textured triangles drawn in memory: the triangles are set up as they are added, binned to the
+	// tiles they cover, then every tile draws its triangles in order so blending is the same as on the GPU
+	class Rasterizer
+	{
+	public:
+		Rasterizer(void);
+		~Rasterizer(void);
+
+		// Frame of the next flushes, RGBA8 rows from top to bottom
+		void setTarget(uint8_t* pixels, int width, int height);
+
+		// State of the triangles given its index
+		uint32_t addState(const rasterState& state);
+
+		// Room for count states or triangles, their index is the returned one onwards; distinct ones
+		// may then be set from several threads, a state before the triangles using it
+		size_t reserveStates(size_t count);
+		size_t reserve(size_t count);
+		void setState(size_t index, const rasterState& state);
+		void setTriangle(size_t index, const rasterVertex& a, const rasterVertex& b, const rasterVertex& c, uint32_t state);
+		void addTriangle(const rasterVertex& a, const rasterVertex& b, const rasterVertex& c, uint32_t state);
+
+		// Draw what was added then forget it, the tiles are spread over the pool
+		void flush(JobPool* pool);
+
+		// Getters
+		size_t getTriangleCount(void) const;
+		size_t getTileCount(void) const;
+
+		// Opaque texel over the whole target
+		static rasterState defaultState(void);
+	private:
+		// Edge functions and attribute planes, x and y at the pixel centers
+		struct triangleSetup
+		{
+			float edgeA[3], edgeB[3], edgeC[3];
+			uint32_t inclusive;	// bit per edge, pixels exactly on a top or left edge belong to the triangle
+			float uA, uB, uC;
+			float vA, vB, vC;
+			int minX, minY, maxX, maxY;
+			uint32_t state;
+		};
+
+		void rasterizeTile(size_t tile);
+		void rasterize(const triangleSetup& triangle, const rasterState& state, int minX, int minY, int maxX, int maxY);
+		static void shade(uint8_t* pixel, const rasterState& state, float u, float v);
+	private:
+		uint8_t*	_pixels;
+		int			_width, _height;
+		int			_tilesX, _tilesY;
+
+		std::vector<triangleSetup>			_triangles;
+		std::vector<rasterState>			_states;
+		std::vector<std::vector<uint32_t>>	_bins;
+	};
+
+}
@@ -0,0 +1,61 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IArrayTexture.h"
+
+namespace ExoEngine
+{
+
+	// Layers of the same size kept in memory for RendererSoftware, RGBA8 rows from top to bottom
+	class SoftwareArrayTexture : public IArrayTexture
+	{
+	public:
+		SoftwareArrayTexture(void);
+		SoftwareArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
+		virtual ~SoftwareArrayTexture(void);
+
+		// The images of another size are resampled to the size of the array
+		virtual void initialize(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
+
+		virtual void bind(int unit = 0) const;
+		virtual void unbind(void) const;
+
+		// Getters
+		int getWidth(void) const;
+		int getHeight(void) const;
+		int getLayerCount(void) const;
+
+		// Layer clamped to the existing ones, like the GL array textures
+		const uint8_t* getLayer(int layer) const;
+	private:
+		int	_width, _height, _layers;
+		std::vector<uint8_t>	_pixels;
+	};
+
+}
@@ -0,0 +1,66 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ITexture.h"
+
+namespace ExoEngine
+{
+
+	// Texture kept in memory for RendererSoftware, RGBA8 rows from top to bottom
+	class SoftwareTexture : public ITexture
+	{
+	public:
+		SoftwareTexture(const std::string& filePath);
+		SoftwareTexture(unsigned int width, unsigned int height, const void* pixels = nullptr);
+		virtual ~SoftwareTexture(void);
+
+		// Nothing to bind, the rasterizer reads the pixels
+		virtual void bind(int unit = 0) const;
+		virtual void unbind(void) const;
+
+		// Getters
+		virtual int getEngineId(void) const;
+
+		virtual int getWidth(void) const;
+		virtual int getHeight(void) const;
+
+		const uint8_t* getPixels(void) const;
+
+		// Any image SDL_image reads, as RGBA8; a missing file gives a magenta pixel like the GL textures
+		static void load(const std::string& filePath, std::vector<uint8_t>& pixels, int& width, int& height);
+
+		// Nearest resampling of RGBA8 pixels
+		static void resize(const std::vector<uint8_t>& source, int sourceWidth, int sourceHeight, uint8_t* destination, int width, int height);
+	private:
+		int	_id;
+		int	_width, _height;
+		std::vector<uint8_t>	_pixels;
+	};
+
+}
@@ -0,0 +1,51 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ITextureAtlas.h"
+#include "Software/SoftwareTexture.h"
+
+namespace ExoEngine
+{
+
+	// Without draw calls to merge there is nothing to pack, every texture is its own page
+	class SoftwareTextureAtlas : public ITextureAtlas
+	{
+	public:
+		SoftwareTextureAtlas(std::vector<std::string>& textures);
+		virtual ~SoftwareTextureAtlas(void);
+
+		// Getters
+		virtual const std::shared_ptr<ITexture>& getTexture(size_t index) const;
+		virtual size_t size(void) const;
+		virtual size_t getPageCount(void) const;
+	private:
+		std::vector<std::shared_ptr<ITexture>>	_textures;
+	};
+
+}
@@ -0,0 +1,94 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+
+#include "IWindow.h"
+#include "Keyboard.h"
+#include "Mouse.h"
+
+namespace ExoEngine
+{
+
+	// Window of RendererSoftware: frames are drawn in memory then copied to an SDL window surface,
+	// WindowMode::HEADLESS keeps them in memory only (no video subsystem needed)
+	class SoftwareWindow : public IWindow
+	{
+	public:
+		SoftwareWindow(const std::string& title, uint32_t width, uint32_t height, const WindowMode &mode, bool resizable);
+		virtual ~SoftwareWindow(void);
+
+		void handleEvents(Keyboard& keyboard, Mouse& mouse);
+		void clearScreen(void);
+		void swap(void);
+
+		// Setters
+		virtual void isCursorVisible(bool visible);
+		virtual void setWindowSize(int w, int h);
+		virtual void setWindowMode(const WindowMode &mode);
+		virtual void setVsync(bool vsync);
+
+		// No post-processing on the CPU, the frame is presented as drawn
+		virtual void addPostProcess(const std::string& name, const std::string& filePath);
+		virtual void removePostProcess(const std::string& name);
+		virtual void setPostProcessEnabled(const std::string& name, bool enabled);
+		virtual void setResolutionScale(float scale);
+		virtual void setFrameTimeTarget(double frameTime);
+		virtual float getResolutionScale(void) const;
+
+		// Getters
+		virtual void* getWindowID();
+		virtual void* getGLContext();
+
+		virtual double getDelta(void) const;
+		virtual float getWidth(void) const;
+		virtual float getHeight(void) const;
+
+		virtual int getContextWidth(void) const;
+		virtual int getContextHeight(void) const;
+
+		virtual int getHighDPIFactor(void) const;
+		virtual bool isFullscreen(void) const;
+
+		virtual bool getIsClosing(void) const;
+
+		virtual IFrameBuffer *getFrameBuffer(void) const;
+		virtual void readPixels(std::vector<uint8_t>& pixels) const;
+
+		// Frame being drawn, RGBA8 at the context size, rows from top to bottom
+		uint8_t* getPixels(void);
+	private:
+		void initialize(const std::string& title, uint32_t width, uint32_t height, const WindowMode &mode, bool resizable);
+		void present(void);
+	private:
+		SDL_Window*	_window;
+		SDL_Event	_event;
+
+		std::vector<uint8_t>	_pixels;
+		std::vector<uint8_t>	_presented;
+	};
+
+}
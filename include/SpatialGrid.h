@@ -0,0 +1,72 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+namespace ExoEngine
+{
+
+	// Uniform grid over the z = 0 plane, an id is stored in every cell its bounds overlap
+	class SpatialGrid
+	{
+	public:
+		SpatialGrid(float cellSize);
+		~SpatialGrid(void);
+
+		void insert(uint32_t id, const glm::vec2& min, const glm::vec2& max);
+		void update(uint32_t id, const glm::vec2& min, const glm::vec2& max);
+		void remove(uint32_t id);
+		void clear(void);
+
+		// Append every id overlapping the area once to result
+		void query(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t>& result);
+
+		// Getters
+		float getCellSize(void) const;
+	private:
+		struct cellRange
+		{
+			int x0, y0, x1, y1;
+			bool used;
+		};
+
+		static uint64_t cellKey(int x, int y);
+		cellRange makeRange(const glm::vec2& min, const glm::vec2& max) const;
+		void removeFromCells(uint32_t id, const cellRange& range);
+	private:
+		float _cellSize;
+
+		std::unordered_map<uint64_t, std::vector<uint32_t>> _cells;
+		std::vector<cellRange> _ranges;
+		std::vector<uint32_t> _stamps;
+		uint32_t _stamp;
+	};
+
+}
@@ -0,0 +1,75 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "OGLCall.h"
+
+// Frames the GPU can still be reading while the CPU writes the next one
+#define STREAM_BUFFER_REGIONS 3
+#define STREAM_BUFFER_ALIGNMENT 16
+
+namespace ExoEngine
+{
+
+	// Vertex data rewritten every frame. The store is split in regions used in turn and guarded by fences,
+	// it is persistently mapped when ARB_buffer_storage is available and mapped unsynchronized otherwise.
+	class StreamBuffer
+	{
+	public:
+		StreamBuffer(unsigned long size);
+		~StreamBuffer(void);
+
+		// Copy size bytes in the region of the frame, return their offset in the buffer. When the region is full
+		// the store grows and the bytes of the frame are copied at the same offsets, earlier offsets stay valid.
+		unsigned long push(const void* data, unsigned long size);
+
+		// Fence the region of the frame and move to the next one
+		void endFrame(void);
+
+		void bind(void) const;
+
+		// Same as Buffer::setAttribute, the offset in floats is relative to the start of the buffer
+		void setAttribute(unsigned char attribArray, unsigned int size, unsigned int stride, unsigned long offset, unsigned int divisor) const;
+
+		// Getters
+		GLuint getBuffer(void) const;
+		unsigned long getSize(void) const;
+		bool isPersistent(void) const;
+	private:
+		void allocate(unsigned long size);
+		void grow(unsigned long size);
+		void release(void);
+		void waitRegion(unsigned int region);
+	private:
+		GLuint _id;
+		unsigned long _size;
+		unsigned int _region;
+		unsigned long _offset;
+		GLsync _fences[STREAM_BUFFER_REGIONS];
+		unsigned char* _pMapped;
+		bool _persistent;
+	};
+
+}
@@ -25,36 +25,84 @@
 #pragma once
 
 #include <deque>
+#include <vector>
+#include <unordered_map>
 #include <cwchar>
 
 #include "Shader.h"
 #include "UI/Label.h"
 #include "UI/Font.h"
 #include "Buffer.h"
+#include "StreamBuffer.h"
+#include "CommandBuffer.h"
 
 namespace ExoEngine
 {
 
+// Glyph quads of a label laid out from its origin, x y u v per vertex
+struct glyphCache
+{
+	std::string text;
+	const Font* font = nullptr;
+	float fontScale = 0.0f;
+	std::vector<float> vertices;
+	unsigned int lastUse = 0;
+};
+
 class TextRenderer
 {
 public:
+	// Vertices of one font atlas, x y u v r g b per vertex
+	struct textBatch
+	{
+		ITexture* texture;
+		size_t first;
+		size_t count;
+	};
+
 	TextRenderer(void);
 	~TextRenderer(void);
 
 	void add(Label *element);
 	void remove(Label *element);
-	void render(const glm::mat4& orthographic);
+	void clear(void);
+	void render(void);
+
+	// Lay the labels out without any GL call, then upload and draw them on the GL thread
+	void record(void);
+	void submit(void);
+
+	// Getters, what record() produced
+	const std::vector<float>& getVertices(void) const;
+	const std::vector<textBatch>& getBatches(void) const;
 private:
-	void prepare(const glm::mat4& orthographic);
-	static void renderCharacter(const wchar_t c, float& x, float& y, Label* label);
+	struct labelGlyphs
+	{
+		Label* label;
+		const glyphCache* glyphs;
+		size_t batch;
+	};
+
+	void prepare(void);
+	static const glyphCache& getGlyphs(Label* label);
+	static void layoutCharacter(const wchar_t c, float& x, float& y, Label* label, std::vector<float>& vertices);
+	static void pruneCache(void);
 	static std::wstring utf8ToUtf16(const std::string& utf8Str);
 public:
 	static Shader* pTextShader;
+
 	static Buffer* vaoBuffer;
-	static Buffer* vertexBuffer;
+	static StreamBuffer* vertexStream;
 private:
 	std::deque<Label*> _renderQueue;
-	int _currentTextureBind;
+	std::vector<labelGlyphs> _labels;
+	std::vector<textBatch> _batches;
+	std::vector<float> _vertices;
+	CommandBuffer _commands;
+
+	// Shared by every text renderer, views render their labels with temporary ones
+	static std::unordered_map<Label*, glyphCache> _glyphCache;
+	static unsigned int _cacheFrame;
 };
 
 }
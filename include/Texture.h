@@ -29,6 +29,8 @@
 #include "Enums.h"
 #include "ITexture.h"
 #include "OGLCall.h"
+#include "TextureUploader.h"
+#include "TextureCache.h"
 
 namespace ExoEngine
 {
@@ -36,12 +38,13 @@ namespace ExoEngine
 	class Texture: public ITexture
 	{
 	public:
-		Texture(unsigned int width, unsigned int height, TextureFormat format, TextureFilter filter);
+		Texture(unsigned int width, unsigned int height, TextureFormat format, TextureFilter filter, const void* pixels = NULL);
 		Texture(const std::string& filePath, TextureFilter filter);
 		virtual ~Texture(void);
 
 		virtual void	bind(int unit = 0) const;
 		virtual void	unbind(void) const;
+		virtual bool	isReady(void) const;
 
 		// Getters
 		virtual int		getEngineId(void) const;
@@ -55,11 +58,13 @@ namespace ExoEngine
 		virtual int getWidth(void) const;
 		virtual int getHeight(void) const;
 	private:
+		void			uploadCooked(const CookedTexture& cooked, TextureFilter filter);
 		static void		applyFilter(const TextureFilter& filter);
 		GLuint			_id;
 		TextureFormat	_format;
 		int				_width;
 		int				_height;
+		mutable UploadFence	_upload;
 	};
 
 }
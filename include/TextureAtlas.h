@@ -0,0 +1,83 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <SDL2/SDL_image.h>
+
+#include "ITextureAtlas.h"
+#include "Texture.h"
+#include "TexturePacker.h"
+
+// Border around each texture, filled with its edge pixels so linear filtering doesn't bleed
+#define ATLAS_PADDING 2
+
+namespace ExoEngine
+{
+
+	// Part of an atlas page, binds the page and exposes its UV rectangle
+	class TextureRegion : public ITexture
+	{
+	public:
+		TextureRegion(const std::shared_ptr<Texture>& page, int x, int y, int width, int height);
+		virtual ~TextureRegion(void);
+
+		virtual void	bind(int unit = 0) const;
+		virtual void	unbind(void) const;
+		virtual bool	isReady(void) const;
+
+		// Getters
+		virtual int		getEngineId(void) const;
+		virtual int		getWidth(void) const;
+		virtual int		getHeight(void) const;
+		virtual glm::vec4	getUVRect(void) const;
+
+		const std::shared_ptr<Texture>& getPage(void) const;
+	private:
+		std::shared_ptr<Texture>	_page;
+		glm::vec4					_uvRect;
+		int							_width;
+		int							_height;
+	};
+
+	class TextureAtlas : public ITextureAtlas
+	{
+	public:
+		TextureAtlas(int width, int height, std::vector<std::string>& textures, TextureFilter filter);
+		virtual ~TextureAtlas(void);
+
+		// Getters
+		virtual const std::shared_ptr<ITexture>& getTexture(size_t index) const;
+		virtual size_t size(void) const;
+		virtual size_t getPageCount(void) const;
+	private:
+		static SDL_Surface*	loadSurface(const std::string& filePath);
+		static void			extrude(SDL_Surface* page, const SDL_Rect& rect);
+	private:
+		std::vector<std::shared_ptr<Texture>>	_pages;
+		std::vector<std::shared_ptr<ITexture>>	_textures;
+	};
+
+}
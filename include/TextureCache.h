@@ -0,0 +1,128 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#include "OGLCall.h"
+#include "Utils/Singleton.h"
+#include "Utils/MappedFile.h"
+
+// First bytes of a cooked texture ("EXOT") and version of the layout
+#define TEXTURE_CACHE_MAGIC		0x544F5845
+#define TEXTURE_CACHE_VERSION	1
+#define TEXTURE_CACHE_MAX_LEVELS	16
+
+namespace ExoEngine
+{
+
+	struct cookedHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		uint32_t width;
+		uint32_t height;
+		uint32_t levelCount;
+		uint32_t internalFormat;
+		uint32_t compressed;
+		uint32_t padding;
+	};
+
+	struct cookedLevel
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	// Cooked texture mapped in memory: every mip level, RGBA8 or block compressed, in the layout the GL
+	// takes, so the levels are given to the upload as they are
+	class CookedTexture
+	{
+	public:
+		CookedTexture(void);
+		~CookedTexture(void);
+
+		bool open(const std::string& path, uint64_t sourceSize, int64_t sourceTime);
+		void close(void);
+
+		// Getters
+		int getWidth(void) const;
+		int getHeight(void) const;
+		int getLevelCount(void) const;
+		const cookedLevel& getLevel(int level) const;
+		const void* getLevelData(int level) const;
+		GLenum getInternalFormat(void) const;
+		bool isCompressed(void) const;
+	private:
+		MappedFile _file;
+		const cookedHeader* _header;
+		const cookedLevel* _levels;
+	};
+
+	// Textures loaded from images go through here (from any loading thread): the first load decodes the image, lets the GL build the
+	// mip chain (and compress it when asked) then saves the result; the next loads map the saved file.
+	// A cooked texture is rebuilt when the size or the modification time of its source changes.
+	class TextureCache : public Singleton<TextureCache>
+	{
+	public:
+		// Folder of the cooked textures, empty disables the cache
+		void setDirectory(const std::string& directory);
+		bool isEnabled(void) const;
+
+		// Block compression (S3TC), used only when the driver supports it
+		void setCompression(bool compression);
+		bool useCompression(void) const;
+
+		// Internal format of the uploads of decoded images
+		GLenum getInternalFormat(bool alpha) const;
+
+		// Maps the cooked version of the image, cooking it when needed. false: the image must be loaded directly.
+		bool load(const std::string& sourcePath, CookedTexture& cooked);
+
+		// Getters
+		unsigned int getHits(void) const;
+		unsigned int getCooked(void) const;
+	private:
+		friend class Singleton<TextureCache>;
+
+		TextureCache(void);
+		~TextureCache(void);
+
+		bool cook(const std::string& sourcePath, const std::string& cookedPath, uint64_t sourceSize, int64_t sourceTime);
+		std::string getPath(const std::string& sourcePath) const;
+	private:
+		std::string _directory;
+		bool _compression;
+		std::atomic<unsigned int> _hits;
+		std::atomic<unsigned int> _cooked;
+	};
+
+}
@@ -0,0 +1,64 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace ExoEngine
+{
+
+	// Skyline bottom-left rectangle packer used to build texture atlases
+	class TexturePacker
+	{
+	public:
+		TexturePacker(int width, int height);
+		~TexturePacker(void);
+
+		// Find a place for a width * height rectangle, return false when the page is full
+		bool pack(int width, int height, glm::ivec2& position);
+		void clear(void);
+
+		// Getters
+		int getWidth(void) const;
+		int getHeight(void) const;
+		float getOccupancy(void) const;
+	private:
+		struct skylineNode
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		bool fits(size_t index, int width, int height, int& y) const;
+	private:
+		std::vector<skylineNode> _skyline;
+		int _width;
+		int _height;
+		long _usedArea;
+	};
+
+}
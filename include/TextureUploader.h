@@ -0,0 +1,78 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "OGLCall.h"
+
+namespace ExoEngine
+{
+
+	// Completion of an asynchronous upload, polled without blocking
+	class UploadFence
+	{
+	public:
+		UploadFence(void);
+		~UploadFence(void);
+
+		void set(GLsync fence);
+
+		// True once the GPU copied the pixels
+		bool isReady(void);
+
+		// Before the first use: the GPU of the using context waits for the copy, the CPU doesn't
+		void waitOnGPU(void);
+	private:
+		GLsync _fence;
+		bool _waited;
+	};
+
+	// Moves decoded pixels to the GL through a pixel buffer object, the driver then copies them to the
+	// texture asynchronously. There is one per thread since every loading thread has its own context.
+	class TextureUploader
+	{
+	public:
+		static TextureUploader& Get(void);
+
+		// Copy the pixels in the pixel buffer and leave it bound, the glTex*Image call which follows reads
+		// them at the returned offset. reserve is the number of bytes the call will read when it is larger.
+		// When the pixel buffer can't be mapped it is unbound and pixels is returned instead.
+		const void* stage(const void* pixels, size_t size, size_t reserve = 0);
+
+		// Unbind the pixel buffer and fence the uploads issued since the last fence
+		GLsync finish(void);
+
+		// Getters
+		unsigned long getUploadedBytes(void) const;
+	private:
+		TextureUploader(void);
+		~TextureUploader(void);
+	private:
+		GLuint _pixelBuffer;
+		unsigned long _uploadedBytes;
+	};
+
+}
@@ -0,0 +1,105 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Buffer.h"
+#include "Frustum.h"
+#include "IArrayTexture.h"
+
+// Tiles per chunk side, a chunk is one vertex buffer and one draw
+#define TILE_CHUNK_SIZE		32
+#define TILE_EMPTY			0xFFFF
+
+// Vertex: position (2), texture coordinates (2), layer (1)
+#define TILE_VERTEX_SIZE	5
+
+namespace ExoEngine
+{
+
+	struct tileChunk
+	{
+		Buffer* pVaoBuffer;
+		Buffer* pVertexBuffer;
+		unsigned int indexCount;
+		bool dirty;
+	};
+
+	// Static grid of tiles, each one a layer of the array texture. The tiles are baked by chunks into
+	// static vertex buffers: changing a tile only rebuilds its chunk, and only the chunks inside the
+	// camera are drawn.
+	class TileMap
+	{
+	public:
+		TileMap(unsigned int width, unsigned int height, float tileSize, const std::shared_ptr<IArrayTexture>& texture);
+		virtual ~TileMap(void);
+
+		void render(const glm::mat4& viewProjection);
+
+		// Tiles, TILE_EMPTY draws nothing
+		void setTile(unsigned int x, unsigned int y, uint16_t layer);
+		uint16_t getTile(unsigned int x, unsigned int y) const;
+		void fill(uint16_t layer);
+
+		// Getters
+		unsigned int getWidth(void) const;
+		unsigned int getHeight(void) const;
+		float getTileSize(void) const;
+		const glm::vec2& getPosition(void) const;
+		unsigned int getDrawCount(void) const;
+
+		// Setters
+		void setPosition(const glm::vec2& position);
+	private:
+		void buildChunk(unsigned int chunkX, unsigned int chunkY);
+	public:
+		static void loadUniforms(void);
+
+		static Shader* pShader;
+		static UniformHandle<glm::mat4> modelUniform;
+
+		// Two triangles per tile, shared by every chunk
+		static Buffer* indexBuffer;
+	private:
+		unsigned int _width, _height;
+		unsigned int _chunksX, _chunksY;
+		float _tileSize;
+		glm::vec2 _position;
+
+		std::shared_ptr<IArrayTexture> _texture;
+		std::vector<uint16_t> _tiles;
+		std::vector<tileChunk> _chunks;
+		std::vector<float> _vertices;
+
+		Frustum _frustum;
+		unsigned int _drawCount;
+	};
+
+}
@@ -0,0 +1,52 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "Buffer.h"
+
+namespace ExoEngine
+{
+
+	// Sub allocations of one uniform buffer for per batch data, the buffer is orphaned when it wraps
+	class UniformRing
+	{
+	public:
+		UniformRing(unsigned long size);
+		~UniformRing(void);
+
+		// Copy size bytes into the ring and bind them to the block binding point, return the offset used
+		unsigned long push(unsigned int binding, const void* data, unsigned long size);
+
+		// Getters
+		unsigned long getSize(void) const;
+		unsigned long getAlignment(void) const;
+	private:
+		Buffer* _pBuffer;
+		unsigned long _size;
+		unsigned long _alignment;
+		unsigned long _offset;
+	};
+
+}
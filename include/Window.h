@@ -34,6 +34,7 @@
 #include "Shader.h"
 #include "Texture.h"
 #include "FrameBuffer.h"
+#include "PostProcessing.h"
 
 #include "Keyboard.h"
 #include "Mouse.h"
@@ -45,19 +46,28 @@ namespace ExoEngine
 	{
 	public:
 		Window(const std::string& title, uint32_t width, uint32_t height, const WindowMode &mode, bool resizable);
-		~Window(void);
+		virtual ~Window(void);
 
-		void handleEvents(Keyboard& keyboard, Mouse& mouse);
-		void clearScreen(void);
-		void swap(void);
+		virtual void handleEvents(Keyboard& keyboard, Mouse& mouse);
+		virtual void clearScreen(void);
+		virtual void swap(void);
 
 		// Setters
 		virtual void setWindowSize(int w, int h);
 		virtual void setWindowMode(const WindowMode &mode);
 		virtual void setVsync(bool vsync);
 
-		void		handleThread(void);
+		// Post processing
+		virtual void addPostProcess(const std::string& name, const std::string& filePath);
+		virtual void removePostProcess(const std::string& name);
+		virtual void setPostProcessEnabled(const std::string& name, bool enabled);
+		virtual void setResolutionScale(float scale);
+		virtual void setFrameTimeTarget(double frameTime);
+		virtual float getResolutionScale(void) const;
+
+		virtual void	handleThread(void);
 		virtual IFrameBuffer	*getFrameBuffer(void) const;
+		virtual void	readPixels(std::vector<uint8_t>& pixels) const;
 
 		// Setters
 		virtual void isCursorVisible(bool visible);
@@ -78,23 +88,21 @@ namespace ExoEngine
 		virtual bool isFullscreen(void) const;
 
 		virtual bool getIsClosing(void) const;
-		Texture		 *_frameTexture;
-	private:
-		void initialize(const std::string& title, uint32_t width, uint32_t height, const WindowMode &mode, bool resizable);
+	protected:
+		// Subclasses bringing their own context
+		Window(void);
+
 		void initPostProcessing(void);
 	private:
+		void initialize(const std::string& title, uint32_t width, uint32_t height, const WindowMode &mode, bool resizable);
+	protected:
 		SDL_Window*	 _window;
 		SDL_Event		_event;
 		SDL_GLContext	_context;
 		SDL_GLContext	_threadContext;
 
 		// Post Processing
-		FrameBuffer	 *_pFrameBuffer;
-
-		Shader			_postProcessing;
-		Buffer			_postVertexArrayObject;
-		Buffer			_postArrayBuffer;
-		Buffer			_postUVMappingBuffer;
+		PostProcessing	_postProcessing;
 	};
 
 }
@@ -0,0 +1,56 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "IResource.h"
+#include "IArrayTexture.h"
+
+namespace ExoEngine
+{
+
+	// Run of layers of an array texture shown one after the other. The frame is chosen in the vertex
+	// shader from the time the sprite started playing, the sprite is not touched while it plays.
+	struct animationClip : public IResource
+	{
+		std::shared_ptr<IArrayTexture> texture;
+		int firstLayer;
+		int frameCount;
+		float frameDuration;	// seconds
+		bool loop;
+
+		animationClip(const std::shared_ptr<IArrayTexture>& texture, int firstLayer, int frameCount, float frameDuration, bool loop = true)
+		: texture(texture), firstLayer(firstLayer), frameCount(frameCount), frameDuration(frameDuration), loop(loop)
+		{	}
+
+		// Length of one play, in seconds
+		float getDuration(void) const
+		{
+			return (frameCount * frameDuration);
+		}
+	};
+
+}
@@ -26,6 +26,7 @@
 
 #include <glm/vec2.hpp>
 #include "IArrayTexture.h"
+#include "animation.h"
 #include <memory>
 
 namespace ExoEngine
@@ -44,30 +45,56 @@ namespace ExoEngine
 		glm::vec2 scale;
 		float angle;
 		int layer;
+		int zOrder;
 		FlipSprite flip;
 
 		std::shared_ptr<IArrayTexture> texture;
 		std::shared_ptr<IArrayTexture> normalMapTexture;
 
+		// Animation, layer is the first frame of the clip and animationStart a renderer time in seconds
+		std::shared_ptr<animationClip> animation;
+		float animationStart;
+
 		// Constructor
 		sprite()
-		: position(glm::vec2(0.0f)), scale(glm::vec2(1.0f)), angle(0.0f), layer(0), texture(nullptr), normalMapTexture(nullptr)
+		: position(glm::vec2(0.0f)), scale(glm::vec2(1.0f)), angle(0.0f), layer(0), zOrder(0), flip(FlipSprite::DEFAULT), texture(nullptr), normalMapTexture(nullptr), animation(nullptr), animationStart(0.0f)
 		{
 		}
 
 		sprite(std::shared_ptr<IArrayTexture> texture, std::shared_ptr<IArrayTexture> normalMapTexture, int layer = 0)
-		: position(glm::vec2(0.0f)), scale(glm::vec2(1.0f)), angle(0.0f), layer(layer), flip(FlipSprite::DEFAULT), texture(texture), normalMapTexture(normalMapTexture)
+		: position(glm::vec2(0.0f)), scale(glm::vec2(1.0f)), angle(0.0f), layer(layer), zOrder(0), flip(FlipSprite::DEFAULT), texture(texture), normalMapTexture(normalMapTexture), animation(nullptr), animationStart(0.0f)
 		{	}
 
+		// Plays the clip from startTime, in seconds on the renderer clock (IRenderer::getTime() / 1000.0f).
+		// An added sprite is updated once, the frames then change without any call.
+		void play(const std::shared_ptr<animationClip>& clip, float startTime)
+		{
+			animation = clip;
+			animationStart = startTime;
+			if (clip)
+			{
+				texture = clip->texture;
+				layer = clip->firstLayer;
+			}
+		}
+
+		void stop(void)
+		{
+			animation = nullptr;
+		}
+
 		sprite	&operator=(const sprite &b)
 		{
 			position = b.position;
 			scale = b.scale;
 			angle = b.angle;
 			layer = b.layer;
+			zOrder = b.zOrder;
 			flip = b.flip;
 			texture = b.texture;
 			normalMapTexture = b.normalMapTexture;
+			animation = b.animation;
+			animationStart = b.animationStart;
 			return (*this);
 		}
 	};
@@ -23,7 +23,10 @@
  */
 
 #include "ArrayTexture.h"
+#include "GLStateCache.h"
 #include "Texture.h"
+#include "TextureUploader.h"
+#include "TextureCache.h"
 #include <stdexcept>
 
 namespace ExoEngine {
@@ -38,7 +41,7 @@ namespace ExoEngine {
 
 	ArrayTexture::~ArrayTexture(void)
 	{
-		glDeleteTextures(1, &_id);
+		GLStateCache::Get().deleteTexture(_id);
 	}
 
 	void ArrayTexture::initialize(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
@@ -46,6 +49,10 @@ namespace ExoEngine {
 		if (textures.size() <= 0)
 			throw (std::invalid_argument("cannot create ArrayTexture, number of images insufficient."));
 
+		// Every layer cooked at the size of the array: the levels are uploaded from the mapped files
+		if (initializeCooked(width, height, textures, filter))
+			return;
+
 		// Generate array texture (based on the fist image in the vector)
 		SDL_Surface* image = IMG_Load(textures[0].c_str());
 		if (!image)
@@ -54,14 +61,19 @@ namespace ExoEngine {
 			SDL_FillRect(image, NULL, SDL_MapRGB(image->format, 255, 0, 255));
 		}
 
-		GL_CALL(glGenTextures(1, &_id));
+		_id = GLStateCache::Get().genTexture();
 
 		GLenum textureFormat = Texture::getFormat(image->format->BytesPerPixel);
-		GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, _id));
+		GLint internalFormat = textureFormat;
+		GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D_ARRAY, _id);
+
+		// Color images are compressed by the driver when asked
+		if (image->format->BytesPerPixel >= 3)
+			internalFormat = TextureCache::Get().getInternalFormat(image->format->BytesPerPixel == 4);
 
 		GL_CALL(glTexImage3D(GL_TEXTURE_2D_ARRAY,
 			0,
-			textureFormat,
+			internalFormat,
 			width, height, (GLsizei)textures.size(),
 			0,
 			textureFormat,
@@ -81,12 +93,14 @@ namespace ExoEngine {
 				SDL_FillRect(image, NULL, SDL_MapRGB(image->format, 255, 0, 255));
 			}
 
+			// Each layer orphans the pixel buffer, the copies of the previous ones go on meanwhile
 			GL_CALL(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0,
 				0, 0, i,
 				width, height, 1,
 				Texture::getFormat(image->format->BytesPerPixel),
 				GL_UNSIGNED_BYTE,
-				image->pixels));
+				TextureUploader::Get().stage(image->pixels, image->pitch * image->h,
+					((width * image->format->BytesPerPixel + 3) & ~3) * height)));
 
 			if (image)
 				SDL_FreeSurface(image);
@@ -94,18 +108,28 @@ namespace ExoEngine {
 
 		// Filter
 		applyFilter(filter);
+		if (filter == TextureFilter::MIPMAP)
+			GL_CALL(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+		_upload.set(TextureUploader::Get().finish());
 	}
 
 	void ArrayTexture::bind(int unit) const
 	{
-		GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
-		GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, _id));
+		_upload.waitOnGPU();
+		GLStateCache::Get().bindTexture(unit, GL_TEXTURE_2D_ARRAY, _id);
 	}
 
 	void ArrayTexture::unbind(void) const
 	{
-		GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
-		GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+		unsigned int unit = GLStateCache::Get().getActiveTexture();
+
+		GLStateCache::Get().bindTexture(unit, GL_TEXTURE_2D, 0);
+		GLStateCache::Get().bindTexture(unit, GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	bool ArrayTexture::isReady(void) const
+	{
+		return (_upload.isReady());
 	}
 
 	// Getters
@@ -115,10 +139,66 @@ namespace ExoEngine {
 	}
 
 	// Private
+	bool ArrayTexture::initializeCooked(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+	{
+		TextureUploader& uploader = TextureUploader::Get();
+		std::vector<CookedTexture> layers(textures.size());
+		int levels;
+
+		// Cooked first: cooking binds a texture of its own
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			if (!TextureCache::Get().load(textures[i], layers[i]) ||
+				layers[i].getWidth() != width || layers[i].getHeight() != height ||
+				layers[i].getInternalFormat() != layers[0].getInternalFormat())
+				return (false);
+		}
+
+		// Without mipmapping only the first level is used
+		levels = filter == TextureFilter::MIPMAP ? layers[0].getLevelCount() : 1;
+
+		_id = GLStateCache::Get().genTexture();
+		GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D_ARRAY, _id);
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1));
+
+		for (int level = 0; level < levels; level++)
+		{
+			const cookedLevel& info = layers[0].getLevel(level);
+
+			GL_CALL(glTexImage3D(GL_TEXTURE_2D_ARRAY, level, layers[0].getInternalFormat(),
+				info.width, info.height, (GLsizei)textures.size(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+			for (int i = 0; i < (int)layers.size(); i++)
+			{
+				const cookedLevel& layer = layers[i].getLevel(level);
+				const void* pixels = uploader.stage(layers[i].getLevelData(level), (size_t)layer.size);
+
+				if (layers[i].isCompressed())
+				{
+					GL_CALL(glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, i, info.width, info.height, 1,
+						layers[i].getInternalFormat(), (GLsizei)layer.size, pixels));
+				}
+				else
+				{
+					GL_CALL(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, i, info.width, info.height, 1,
+						GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+				}
+			}
+		}
+
+		applyFilter(filter);
+		_upload.set(uploader.finish());
+		return (true);
+	}
+
 	void ArrayTexture::applyFilter(const TextureFilter& filter)
 	{
 		switch (filter)
 		{
+		case TextureFilter::MIPMAP:
+			GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+			GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			break;
 		case TextureFilter::NEAREST:
 			GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
 			GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
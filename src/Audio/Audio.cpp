@@ -36,8 +36,10 @@ namespace ExoEngine {
 	Audio::~Audio(void)
 	{
 		alcMakeContextCurrent(nullptr);
-		alcDestroyContext(_pContext);
-		alcCloseDevice(_pDevice);
+		if (_pContext)
+			alcDestroyContext(_pContext);
+		if (_pDevice)
+			alcCloseDevice(_pDevice);
 	}
 
 	void Audio::initialize(void)
@@ -41,16 +41,25 @@ namespace ExoEngine {
 		alBufferData(_id[1], _pOggLoader->getFormat(), &_pOggLoader->readSample(samples, 44100)[0], _pOggLoader->getTotalRead(), _pOggLoader->getSampleRate());
 	}
 
+	Music::Music(void)
+		: _pOggLoader(nullptr)
+	{	}
+
 	Music::~Music(void)
 	{
 		if (_pOggLoader)
 			delete _pOggLoader;
 
-		alDeleteBuffers(2, _id);
+		if (_id[0])
+			alDeleteBuffers(2, _id);
 	}
 
 	void Music::streamingUpdate(ALuint source)
 	{
+		// Nothing streamed
+		if (!_pOggLoader)
+			return;
+
 		ALint status;
 		alGetSourcei(source, AL_SOURCE_STATE, &status);
 
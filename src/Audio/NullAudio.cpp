@@ -0,0 +1,67 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include "Audio/NullAudio.h"
+
+namespace ExoEngine {
+
+	NullAudio::NullAudio(void)
+		: Audio()
+	{	}
+
+	NullAudio::~NullAudio(void)
+	{	}
+
+	void NullAudio::initialize(void)
+	{
+		// No device to open
+	}
+
+	void NullAudio::getDevices(std::vector<std::string>& devices)
+	{
+		devices.clear();
+	}
+
+	void NullAudio::updateListener(const glm::vec3&, const glm::vec3&, float)
+	{	}
+
+	void NullAudio::updateVolume(float)
+	{	}
+
+	Source* NullAudio::createSource(void)
+	{
+		// No OpenAL source, nothing relies on the calls being ignored without a context
+		return new Source(false);
+	}
+
+	Sound* NullAudio::createSound(const std::string&)
+	{
+		return new Sound();
+	}
+
+	Music* NullAudio::createMusic(const std::string&)
+	{
+		return new Music();
+	}
+
+}
\ No newline at end of file
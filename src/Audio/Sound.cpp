@@ -49,9 +49,14 @@ namespace ExoEngine {
 			throw (std::invalid_argument("OpenAL error when loading " + filePath));
 	}
 
+	Sound::Sound(void)
+		: _id(0)
+	{	}
+
 	Sound::~Sound(void)
 	{
-		alDeleteBuffers(1, &_id);
+		if (_id)
+			alDeleteBuffers(1, &_id);
 	}
 
 	// Getters
@@ -26,15 +26,21 @@
 
 namespace ExoEngine {
 
-	Source::Source()
+	Source::Source(bool generate)
 		: _id(0), _pMusic(nullptr)
 	{
+		if (!generate)
+			return;
+
 		alGenSources(1, &_id);
 		alSource3f(_id, AL_POSITION, 0.0f, 0.0f, 0.0f);
 	}
 
 	Source::~Source()
 	{
+		if (!_id)
+			return;
+
 		alSourceStop(_id);
 
 		// Clean source buffers
@@ -56,30 +62,35 @@ namespace ExoEngine {
 
 	void Source::play(void) const
 	{
-		alSourcePlay(_id);
+		if (_id)
+			alSourcePlay(_id);
 	}
 
 	void Source::stop(void) const
 	{
-		alSourceStop(_id);
+		if (_id)
+			alSourceStop(_id);
 	}
 
 	void Source::rewind(void) const
 	{
-		alSourceRewind(_id);
+		if (_id)
+			alSourceRewind(_id);
 	}
 
 	void Source::streamingUpdate(void) const
 	{
-		if (_pMusic)
+		if (_id && _pMusic)
 			_pMusic->streamingUpdate(_id);
 	}
 
 	// Getters
 	Source::SourceState Source::getState(void)
 	{
-		ALint status;
-		alGetSourcei(_id, AL_SOURCE_STATE, &status);
+		ALint status = AL_INITIAL;
+
+		if (_id)
+			alGetSourcei(_id, AL_SOURCE_STATE, &status);
 
 		switch (status)
 		{
@@ -102,7 +113,8 @@ namespace ExoEngine {
 	// Setters
 	void Source::setAudio(const Sound* sound)
 	{
-		alSourcei(_id, AL_BUFFER, ((Sound*)sound)->getBuffer());
+		if (_id)
+			alSourcei(_id, AL_BUFFER, ((Sound*)sound)->getBuffer());
 	}
 
 	void Source::setAudio(const Music* music)
@@ -114,22 +126,26 @@ namespace ExoEngine {
 		}
 
 		_pMusic = (Music*)music;
-		alSourceQueueBuffers(_id, 2, _pMusic->getBuffers());
+		if (_id)
+			alSourceQueueBuffers(_id, 2, _pMusic->getBuffers());
 	}
 
 	void Source::setPosition(const glm::vec3& position)
 	{
-		alSource3f(_id, AL_POSITION, position.x, position.y, position.z);
+		if (_id)
+			alSource3f(_id, AL_POSITION, position.x, position.y, position.z);
 	}
 
 	void Source::setVolume(float volume)
 	{
-		alSourcef(_id, AL_GAIN, volume);
+		if (_id)
+			alSourcef(_id, AL_GAIN, volume);
 	}
 
 	void Source::setPitch(float pitch)
 	{
-		alSourcef(_id, AL_PITCH, pitch);
+		if (_id)
+			alSourcef(_id, AL_PITCH, pitch);
 	}
 
 }
\ No newline at end of file
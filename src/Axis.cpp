@@ -23,7 +23,7 @@
  */
 
 #include "Axis.h"
-#include "ObjectRenderer.h"
+#include "GLStateCache.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 
@@ -32,6 +32,8 @@
 namespace ExoEngine {
 
 	Shader* Axis::pShader = nullptr;
+	UniformHandle<glm::mat4> Axis::modelUniform;
+	UniformHandle<glm::vec4> Axis::colorUniform;
 	Buffer* Axis::vaoBuffer = nullptr;
 	Buffer* Axis::vertexBuffer = nullptr;
 
@@ -44,61 +46,32 @@ namespace ExoEngine {
 	{
 	}
 
-	void Axis::render(const glm::mat4& lookAt, const glm::mat4& perspective)
+	void Axis::loadUniforms(void)
 	{
-		// X - Red
-		drawAxis(1, 0, 0, glm::vec3(1, 0, 0), lookAt, perspective);
-
-		// Y - Green
-		drawAxis(0, 1, 1.5708, glm::vec3(0, 1, 0), lookAt, perspective);
+		modelUniform = pShader->getUniform<glm::mat4>("model");
+		colorUniform = pShader->getUniform<glm::vec4>("color");
 	}
 
-	// Private
-	void Axis::drawAxis(int x, int y, float angle, const glm::vec3& color, const glm::mat4& lookAt, const glm::mat4& perspective)
+	void Axis::render(void)
 	{
-		// Line
-		Grid::vaoBuffer->bind();
-		Grid::vertexBuffer->bind();
-
-		Grid::pShader->bind();
-		Grid::pShader->setMat4("projection", perspective);
-		Grid::pShader->setMat4("view", lookAt);
-		Grid::pShader->setVec4("color", glm::vec4(color, 1));
-
-		static glm::mat4 model;
-		model = glm::translate(glm::mat4(1.0f), glm::vec3(_pos.x, _pos.y, 0.0f));
-		model = glm::rotate(model, angle, glm::vec3(0, 0, 1));
-		Grid::pShader->setMat4("model", model);
+		vaoBuffer->bind();
 
-		GL_CALL(glDrawArrays(GL_LINES, 0, 2));
-
-		// Geometry
 		pShader->bind();
-		pShader->setMat4("projection", perspective);
-		pShader->setMat4("view", lookAt);
-		pShader->setVec4("color", glm::vec4(color, 1));
-
-		switch (_type) {
-		case AxisType::SCALE: {
-			ObjectRenderer::vaoBuffer->bind();
-			ObjectRenderer::vertexBuffer->bind();
+		pShader->set(colorUniform, glm::vec4(1, 1, 1, 1));
+		pShader->set(modelUniform, glm::translate(glm::mat4(1.0f), glm::vec3(_pos.x, _pos.y, 0.0f)));
 
-			model = glm::translate(glm::mat4(1.0f), glm::vec3(_pos.x + x, _pos.y + y, 0.0f));
-			model = glm::scale(model, glm::vec3(0.08f, 0.08f, 0.0f));
-			pShader->setMat4("model", model);
+		// X (red) and Y (green) lines, then the heads matching the type
+		GL_CALL(glDrawArrays(GL_LINES, 0, AXIS_LINE_VERTICES));
+		GLStateCache::Get().countDrawCall();
 
-			GL_CALL(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0));
+		switch (_type) {
+		case AxisType::SCALE:
+			GL_CALL(glDrawArrays(GL_TRIANGLES, AXIS_LINE_VERTICES + AXIS_TRANSLATION_VERTICES, AXIS_SCALE_VERTICES));
+			GLStateCache::Get().countDrawCall();
 			break;
-		}
 		default: // Translation
-			vaoBuffer->bind();
-			vertexBuffer->bind();
-
-			model = glm::translate(glm::mat4(1.0f), glm::vec3(_pos.x + x, _pos.y + y, 0.0f));
-			model = glm::rotate(model, (angle - 1.5708f), glm::vec3(0, 0, 1));
-			pShader->setMat4("model", model);
-
-			GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+			GL_CALL(glDrawArrays(GL_TRIANGLES, AXIS_LINE_VERTICES, AXIS_TRANSLATION_VERTICES));
+			GLStateCache::Get().countDrawCall();
 			break;
 		}
 	}
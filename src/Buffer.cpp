@@ -23,6 +23,7 @@
  */
 
 #include "Buffer.h"
+#include "GLStateCache.h"
 #include "Texture.h"
 
 namespace ExoEngine {
@@ -42,13 +43,13 @@ namespace ExoEngine {
 		switch (_type)
 		{
 		case BufferType::VERTEXARRAY:
-			glDeleteVertexArrays(1, &_id);
+			GLStateCache::Get().deleteVertexArray(_id);
 			break;
 		case BufferType::RENDERBUFFER:
 			glDeleteRenderbuffers(1, &_id);
 			break;
 		default:
-			glDeleteBuffers(1, &_id);
+			GLStateCache::Get().deleteBuffer(_id);
 			break;
 		}
 	}
@@ -57,16 +58,17 @@ namespace ExoEngine {
 	{
 		_count = count;
 		_type = type;
+		_usage = usage;
 
 		switch (_type)
 		{
 		case BufferType::VERTEXARRAY:
 			GL_CALL(glGenVertexArrays(1, &_id));
-			GL_CALL(glBindVertexArray(_id));
+			GLStateCache::Get().bindVertexArray(_id);
 			break;
 		case BufferType::ARRAYBUFFER:
 			GL_CALL(glGenBuffers(1, &_id));
-			GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, _id));
+			GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
 			GL_CALL(glBufferData(GL_ARRAY_BUFFER, count * sizeof(GL_FLOAT), data, (usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
 
 			GL_CALL(glEnableVertexAttribArray(attribArray));
@@ -74,42 +76,104 @@ namespace ExoEngine {
 			break;
 		case BufferType::INDEXBUFFER:
 			GL_CALL(glGenBuffers(1, &_id));
-			GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id));
+			GLStateCache::Get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id);
 			GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GL_UNSIGNED_INT), data, (usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
 			break;
 		case BufferType::RENDERBUFFER:
 			GL_CALL(glGenRenderbuffers(1, &_id));
 			GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, _id));
 			break;
+		case BufferType::UNIFORMBUFFER:
+			GL_CALL(glGenBuffers(1, &_id));
+			GLStateCache::Get().bindBuffer(GL_UNIFORM_BUFFER, _id);
+			GL_CALL(glBufferData(GL_UNIFORM_BUFFER, count * sizeof(GL_FLOAT), data, (usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
+			break;
+		case BufferType::INSTANCEBUFFER:
+			// Attributes are described later with setAttribute, one buffer can feed several of them
+			GL_CALL(glGenBuffers(1, &_id));
+			GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+			GL_CALL(glBufferData(GL_ARRAY_BUFFER, count * sizeof(GL_FLOAT), data, (usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
+			break;
+		case BufferType::TEXTUREBUFFER:
+			// Read by the shaders through a buffer texture, elements of 32 bits
+			GL_CALL(glGenBuffers(1, &_id));
+			GLStateCache::Get().bindBuffer(GL_TEXTURE_BUFFER, _id);
+			GL_CALL(glBufferData(GL_TEXTURE_BUFFER, count * sizeof(GL_FLOAT), data, (usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
+			break;
 		}
 	}
 
 	void Buffer::updateSubData(unsigned long count, const void* data)
 	{
-		if (_type == BufferType::ARRAYBUFFER || _type == BufferType::INDEXBUFFER)
+		if (_type != BufferType::VERTEXARRAY && _type != BufferType::RENDERBUFFER)
+		{
+			GLenum target = getTarget();
+			GLStateCache::Get().bindBuffer(target, _id);
+			GL_CALL(glBufferSubData(target, 0, count * (_type == BufferType::INDEXBUFFER ? sizeof(GL_UNSIGNED_INT) : sizeof(GL_FLOAT)), data));
+		}
+	}
+
+	void Buffer::resize(unsigned long count, const void* data)
+	{
+		if (_type == BufferType::ARRAYBUFFER || _type == BufferType::INSTANCEBUFFER || _type == BufferType::UNIFORMBUFFER || _type == BufferType::TEXTUREBUFFER)
 		{
-			bind();
-			GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(GL_FLOAT), data));
-			unbind();
+			GLenum target = getTarget();
+			_count = count;
+
+			// Respecify the whole store, the driver can orphan the previous one
+			GLStateCache::Get().bindBuffer(target, _id);
+			GL_CALL(glBufferData(target, count * sizeof(GL_FLOAT), data, (_usage == BufferDraw::STATIC ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW)));
 		}
 	}
 
+	void Buffer::setAttribute(unsigned char attribArray, unsigned int size, unsigned int stride, unsigned long offset, unsigned int divisor) const
+	{
+		GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+		GL_CALL(glEnableVertexAttribArray(attribArray));
+		GL_CALL(glVertexAttribPointer(attribArray, size, GL_FLOAT, GL_FALSE, stride * sizeof(GL_FLOAT), (void*)(offset * sizeof(GL_FLOAT))));
+		GL_CALL(glVertexAttribDivisor(attribArray, divisor));
+	}
+
+	void Buffer::updateSubData(unsigned long offset, unsigned long size, const void* data)
+	{
+		GLenum target = getTarget();
+		GLStateCache::Get().bindBuffer(target, _id);
+		GL_CALL(glBufferSubData(target, offset, size, data));
+	}
+
+	void Buffer::bindBase(unsigned int binding) const
+	{
+		GLStateCache::Get().bindBufferBase(GL_UNIFORM_BUFFER, binding, _id);
+	}
+
+	void Buffer::bindRange(unsigned int binding, unsigned long offset, unsigned long size) const
+	{
+		GLStateCache::Get().bindBufferRange(GL_UNIFORM_BUFFER, binding, _id, offset, size);
+	}
+
 	void Buffer::bind(void) const
 	{
 		switch (_type)
 		{
 		case BufferType::VERTEXARRAY:
-			GL_CALL(glBindVertexArray(_id));
+			GLStateCache::Get().bindVertexArray(_id);
 			break;
 		case BufferType::ARRAYBUFFER:
-			GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, _id));
+		case BufferType::INSTANCEBUFFER:
+			GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
 			break;
 		case BufferType::INDEXBUFFER:
-			GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id));
+			GLStateCache::Get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id);
 			break;
 		case BufferType::RENDERBUFFER:
 			GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, _id));
 			break;
+		case BufferType::UNIFORMBUFFER:
+			GLStateCache::Get().bindBuffer(GL_UNIFORM_BUFFER, _id);
+			break;
+		case BufferType::TEXTUREBUFFER:
+			GLStateCache::Get().bindBuffer(GL_TEXTURE_BUFFER, _id);
+			break;
 		}
 	}
 
@@ -118,17 +182,24 @@ namespace ExoEngine {
 		switch (_type)
 		{
 		case BufferType::VERTEXARRAY:
-			GL_CALL(glBindVertexArray(0));
+			GLStateCache::Get().bindVertexArray(0);
 			break;
 		case BufferType::ARRAYBUFFER:
-			GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+		case BufferType::INSTANCEBUFFER:
+			GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, 0);
 			break;
 		case BufferType::INDEXBUFFER:
-			GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+			GLStateCache::Get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 			break;
 		case BufferType::RENDERBUFFER:
 			GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
 			break;
+		case BufferType::UNIFORMBUFFER:
+			GLStateCache::Get().bindBuffer(GL_UNIFORM_BUFFER, 0);
+			break;
+		case BufferType::TEXTUREBUFFER:
+			GLStateCache::Get().bindBuffer(GL_TEXTURE_BUFFER, 0);
+			break;
 		}
 	}
 
@@ -138,4 +209,25 @@ namespace ExoEngine {
 		return _id;
 	}
 
+	unsigned long Buffer::getCount(void) const
+	{
+		return _count;
+	}
+
+	// Private
+	GLenum Buffer::getTarget(void) const
+	{
+		switch (_type)
+		{
+		case BufferType::INDEXBUFFER:
+			return GL_ELEMENT_ARRAY_BUFFER;
+		case BufferType::UNIFORMBUFFER:
+			return GL_UNIFORM_BUFFER;
+		case BufferType::TEXTUREBUFFER:
+			return GL_TEXTURE_BUFFER;
+		default:
+			return GL_ARRAY_BUFFER;
+		}
+	}
+
 }
\ No newline at end of file
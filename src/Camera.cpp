@@ -23,12 +23,11 @@
  */
 
 #include "Camera.h"
-#include "RendererSDLOpenGL.h"
 
 namespace ExoEngine {
 
-	Camera::Camera(void)
-		: ICamera(), _lookAt(0.0f)
+	Camera::Camera(IWindow* window)
+		: ICamera(), _pWindow(window), _lookAt(0.0f)
 	{
 
 	}
@@ -44,21 +43,21 @@ namespace ExoEngine {
 
 		// Keyboard & Gamepad
 		if (keyboard->isKeyDown(KeyboardKeys::KEY_SPACE))
-			_position.z += _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+			_position.z += _speed * _pWindow->getDelta();
 		else if ((keyboard->isKeyDown(KeyboardKeys::KEY_LSHIFT) && _position.z > 1.0f))
-			_position.z -= _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+			_position.z -= _speed * _pWindow->getDelta();
 
 		if (_pFollowedEntity == nullptr)
 		{
 			if (keyboard->isKeyDown(KeyboardKeys::KEY_W))
-				_position.y += _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+				_position.y += _speed * _pWindow->getDelta();
 			else if (keyboard->isKeyDown(KeyboardKeys::KEY_S))
-				_position.y -= _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+				_position.y -= _speed * _pWindow->getDelta();
 
 			if (keyboard->isKeyDown(KeyboardKeys::KEY_A))
-				_position.x -= _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+				_position.x -= _speed * _pWindow->getDelta();
 			else if (keyboard->isKeyDown(KeyboardKeys::KEY_D))
-				_position.x += _speed * RendererSDLOpenGL::Get().getWindow()->getDelta();
+				_position.x += _speed * _pWindow->getDelta();
 		}
 
 		// Calculate LookAt matrice
@@ -0,0 +1,93 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "CommandBuffer.h"
+
+namespace ExoEngine {
+
+	CommandBuffer::CommandBuffer(void)
+	{	}
+
+	CommandBuffer::~CommandBuffer(void)
+	{	}
+
+	void CommandBuffer::add(uint64_t key, const void* state, uint32_t first, uint32_t count)
+	{
+		if (!_packets.empty())
+		{
+			drawPacket& last = _packets.back();
+
+			if (last.state == state && last.first + last.count == first)
+			{
+				last.count += count;
+				return;
+			}
+		}
+		_packets.push_back({ key, state, first, count });
+	}
+
+	void CommandBuffer::append(const CommandBuffer& other)
+	{
+		for (const drawPacket& packet : other._packets)
+			add(packet.key, packet.state, packet.first, packet.count);
+	}
+
+	void CommandBuffer::clear(void)
+	{
+		_packets.clear();
+	}
+
+	const std::vector<drawPacket>& CommandBuffer::sort(void)
+	{
+		_entries.resize(_packets.size());
+		for (uint32_t i = 0; i < _packets.size(); i++)
+			_entries[i] = { _packets[i].key, i };
+
+		RenderQueue::radixSort(_entries, _swap);
+
+		_sorted.resize(_packets.size());
+		for (size_t i = 0; i < _entries.size(); i++)
+			_sorted[i] = _packets[_entries[i].index];
+		_packets.swap(_sorted);
+
+		return (_packets);
+	}
+
+	// Getters
+	const std::vector<drawPacket>& CommandBuffer::getPackets(void) const
+	{
+		return (_packets);
+	}
+
+	size_t CommandBuffer::size(void) const
+	{
+		return (_packets.size());
+	}
+
+	bool CommandBuffer::empty(void) const
+	{
+		return (_packets.empty());
+	}
+
+}
\ No newline at end of file
@@ -26,11 +26,16 @@
 #include "Utils/Utils.h"
 
 #include "Audio/Audio.h"
+#include "Audio/NullAudio.h"
 #include "RendererSDLOpenGL.h"
+#include "Software/RendererSoftware.h"
+#include "Null/NullRenderer.h"
 
 namespace ExoEngine {
 
 	Engine::Engine(void) :
+		_renderer(nullptr),
+		_audio(nullptr),
 		_resourceManager(nullptr),
 		_settingsManager(nullptr)
 	{
@@ -53,8 +58,8 @@ namespace ExoEngine {
 	void Engine::initialize(const std::string& settingsFile)
 	{
 		std::string	path;
-		Setting* rendererLibSetting;
-		Setting* audioLibSetting;
+		Setting* rendererLibSetting = nullptr;
+		Setting* audioLibSetting = nullptr;
 
 		path = getPath(settingsFile);
 		_settingsManager->load(settingsFile);
@@ -75,6 +80,20 @@ namespace ExoEngine {
 			_log.error << "missing libAudio in settings file '" << settingsFile << "'" << std::endl;
 		}
 
+		// The software or null renderer when the library setting names it, OpenGL otherwise
+		if (rendererLibSetting && rendererLibSetting->getValue().find("Null") != std::string::npos)
+			_renderer = &NullRenderer::Get();
+		else if (rendererLibSetting && rendererLibSetting->getValue().find("Software") != std::string::npos)
+			_renderer = &RendererSoftware::Get();
+		else
+			_renderer = &RendererSDLOpenGL::Get();
+
+		// Dedicated servers: no device, resources keep their metadata only
+		if (audioLibSetting && audioLibSetting->getValue().find("Null") != std::string::npos)
+			_audio = &NullAudio::Get();
+		else
+			_audio = &Audio::Get();
+
 		_resourceManager = new ResourceManager(getRenderer(), getAudio());
 	}
 
@@ -90,11 +109,15 @@ namespace ExoEngine {
 
 	IRenderer* Engine::getRenderer(void) const
 	{
+		if (_renderer)
+			return _renderer;
 		return &RendererSDLOpenGL::Get();
 	}
 
 	Audio* Engine::getAudio(void) const
 	{
+		if (_audio)
+			return _audio;
 		return &Audio::Get();
 	}
 
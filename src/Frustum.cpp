@@ -0,0 +1,165 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define EXO_FRUSTUM_SSE
+#endif
+
+#include "Frustum.h"
+
+namespace ExoEngine {
+
+	Frustum::Frustum(void)
+		: _inverse(1.0f)
+	{
+		for (unsigned int i = 0; i < 6; i++)
+			_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	Frustum::~Frustum(void)
+	{	}
+
+	void Frustum::update(const glm::mat4& viewProjection)
+	{
+		// Rows of the matrix, glm is column major
+		glm::vec4 rows[4];
+		for (unsigned int i = 0; i < 4; i++)
+			rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+		_planes[0] = rows[3] + rows[0];	// left
+		_planes[1] = rows[3] - rows[0];	// right
+		_planes[2] = rows[3] + rows[1];	// bottom
+		_planes[3] = rows[3] - rows[1];	// top
+		_planes[4] = rows[3] + rows[2];	// near
+		_planes[5] = rows[3] - rows[2];	// far
+
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			float length = std::sqrt(_planes[i].x * _planes[i].x + _planes[i].y * _planes[i].y + _planes[i].z * _planes[i].z);
+			if (length > 0.0f)
+				_planes[i] = _planes[i] / length;
+		}
+
+		_inverse = glm::inverse(viewProjection);
+	}
+
+	bool Frustum::intersects(const glm::vec2& center, const glm::vec2& extent) const
+	{
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			const glm::vec4& plane = _planes[i];
+			float distance = plane.x * center.x + plane.y * center.y + plane.w + std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y;
+
+			if (distance < 0.0f)
+				return (false);
+		}
+		return (true);
+	}
+
+	void Frustum::intersects(const float* centerX, const float* centerY, const float* extentX, const float* extentY, size_t count, uint8_t* visible) const
+	{
+		size_t i = 0;
+
+#ifdef EXO_FRUSTUM_SSE
+		__m128 planeX[6], planeY[6], planeW[6], absX[6], absY[6];
+		const __m128 zero = _mm_setzero_ps();
+
+		for (unsigned int p = 0; p < 6; p++)
+		{
+			planeX[p] = _mm_set1_ps(_planes[p].x);
+			planeY[p] = _mm_set1_ps(_planes[p].y);
+			planeW[p] = _mm_set1_ps(_planes[p].w);
+			absX[p] = _mm_set1_ps(std::fabs(_planes[p].x));
+			absY[p] = _mm_set1_ps(std::fabs(_planes[p].y));
+		}
+
+		// Four boxes per iteration, a box is rejected as soon as it is behind one plane
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(centerX + i);
+			__m128 cy = _mm_loadu_ps(centerY + i);
+			__m128 ex = _mm_loadu_ps(extentX + i);
+			__m128 ey = _mm_loadu_ps(extentY + i);
+			__m128 outside = zero;
+
+			for (unsigned int p = 0; p < 6; p++)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)), planeW[p]);
+				distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+			}
+
+			int mask = _mm_movemask_ps(outside);
+			visible[i] = (mask & 1) ? 0 : 1;
+			visible[i + 1] = (mask & 2) ? 0 : 1;
+			visible[i + 2] = (mask & 4) ? 0 : 1;
+			visible[i + 3] = (mask & 8) ? 0 : 1;
+		}
+#endif
+
+		for (; i < count; i++)
+			visible[i] = intersects(glm::vec2(centerX[i], centerY[i]), glm::vec2(extentX[i], extentY[i])) ? 1 : 0;
+	}
+
+	// Getters
+	bool Frustum::getBounds(glm::vec2& min, glm::vec2& max) const
+	{
+		static const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+		bool found = false;
+
+		// Intersect each corner ray (near to far) with the z = 0 plane
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			glm::vec4 near = _inverse * glm::vec4(corners[i][0], corners[i][1], -1.0f, 1.0f);
+			glm::vec4 far = _inverse * glm::vec4(corners[i][0], corners[i][1], 1.0f, 1.0f);
+			if (near.w == 0.0f || far.w == 0.0f)
+				return (false);
+
+			glm::vec3 a = glm::vec3(near) / near.w;
+			glm::vec3 b = glm::vec3(far) / far.w;
+			if ((a.z > 0.0f && b.z > 0.0f) || (a.z < 0.0f && b.z < 0.0f) || a.z == b.z)
+				return (false);
+
+			float t = a.z / (a.z - b.z);
+			glm::vec2 point = glm::vec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+
+			if (!found)
+			{
+				min = point;
+				max = point;
+				found = true;
+			}
+			else
+			{
+				min = glm::min(min, point);
+				max = glm::max(max, point);
+			}
+		}
+		return (found);
+	}
+
+}
\ No newline at end of file
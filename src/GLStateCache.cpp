@@ -0,0 +1,359 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "GLStateCache.h"
+
+// Value no glGen* returns, the next call is always issued
+#define UNKNOWN_BINDING 0xFFFFFFFF
+
+namespace ExoEngine {
+
+	GLStateCache& GLStateCache::Get(void)
+	{
+		static thread_local GLStateCache cache;
+
+		return (cache);
+	}
+
+	GLStateCache::GLStateCache(void)
+	{
+		_counters = { 0, 0, 0, 0 };
+		invalidate();
+	}
+
+	void GLStateCache::useProgram(GLuint program)
+	{
+		if (change(program != _program))
+		{
+			GL_CALL(glUseProgram(program));
+			_program = program;
+		}
+	}
+
+	void GLStateCache::bindVertexArray(GLuint vertexArray)
+	{
+		if (change(vertexArray != _vertexArray))
+		{
+			GL_CALL(glBindVertexArray(vertexArray));
+			_vertexArray = vertexArray;
+
+			// The element array binding is part of the vertex array
+			_elementBuffer = UNKNOWN_BINDING;
+		}
+	}
+
+	void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+	{
+		GLuint* current;
+
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			current = &_arrayBuffer;
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			current = &_elementBuffer;
+			break;
+		case GL_UNIFORM_BUFFER:
+			current = &_uniformBuffer;
+			break;
+		default:
+			change(true);
+			GL_CALL(glBindBuffer(target, buffer));
+			return;
+		}
+
+		if (change(buffer != *current))
+		{
+			GL_CALL(glBindBuffer(target, buffer));
+			*current = buffer;
+		}
+	}
+
+	void GLStateCache::bindBufferBase(GLenum target, unsigned int index, GLuint buffer)
+	{
+		if (target == GL_UNIFORM_BUFFER && index < MAX_UNIFORM_BINDINGS)
+		{
+			indexedBinding& binding = _uniformBindings[index];
+
+			if (!change(binding.buffer != buffer || binding.offset != -1))
+				return;
+			binding = { buffer, -1, -1 };
+		}
+		else
+			change(true);
+
+		// Also binds the generic binding point
+		GL_CALL(glBindBufferBase(target, index, buffer));
+		if (target == GL_UNIFORM_BUFFER)
+			_uniformBuffer = buffer;
+	}
+
+	void GLStateCache::bindBufferRange(GLenum target, unsigned int index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		if (target == GL_UNIFORM_BUFFER && index < MAX_UNIFORM_BINDINGS)
+		{
+			indexedBinding& binding = _uniformBindings[index];
+
+			if (!change(binding.buffer != buffer || binding.offset != offset || binding.size != size))
+				return;
+			binding = { buffer, offset, size };
+		}
+		else
+			change(true);
+
+		GL_CALL(glBindBufferRange(target, index, buffer, offset, size));
+		if (target == GL_UNIFORM_BUFFER)
+			_uniformBuffer = buffer;
+	}
+
+	void GLStateCache::activeTexture(unsigned int unit)
+	{
+		if (change(unit != _activeTexture))
+		{
+			GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+			_activeTexture = unit;
+		}
+	}
+
+	void GLStateCache::bindTexture(unsigned int unit, GLenum target, GLuint texture)
+	{
+		int index = getTargetIndex(target);
+
+		if (unit >= MAX_TEXTURE_UNITS || index < 0)
+		{
+			activeTexture(unit);
+			change(true);
+			GL_CALL(glBindTexture(target, texture));
+			return;
+		}
+
+		if (change(_textures[unit][index] != texture))
+		{
+			activeTexture(unit);
+			GL_CALL(glBindTexture(target, texture));
+			_textures[unit][index] = texture;
+		}
+	}
+
+	GLuint GLStateCache::genTexture(void)
+	{
+		GLuint texture;
+
+		GL_CALL(glGenTextures(1, &texture));
+		forgetTexture(texture);
+		return (texture);
+	}
+
+	void GLStateCache::setBlend(bool enabled)
+	{
+		if (change(_blend != (int)enabled))
+		{
+			if (enabled)
+			{
+				GL_CALL(glEnable(GL_BLEND));
+			}
+			else
+			{
+				GL_CALL(glDisable(GL_BLEND));
+			}
+			_blend = enabled;
+		}
+	}
+
+	void GLStateCache::setBlendFunc(GLenum source, GLenum destination)
+	{
+		if (change(source != _blendSource || destination != _blendDestination))
+		{
+			GL_CALL(glBlendFunc(source, destination));
+			_blendSource = source;
+			_blendDestination = destination;
+		}
+	}
+
+	void GLStateCache::setScissorTest(bool enabled)
+	{
+		if (change(_scissorTest != (int)enabled))
+		{
+			if (enabled)
+			{
+				GL_CALL(glEnable(GL_SCISSOR_TEST));
+			}
+			else
+			{
+				GL_CALL(glDisable(GL_SCISSOR_TEST));
+			}
+			_scissorTest = enabled;
+		}
+	}
+
+	void GLStateCache::setScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (change(!_scissorKnown || x != _scissor[0] || y != _scissor[1] || width != _scissor[2] || height != _scissor[3]))
+		{
+			GL_CALL(glScissor(x, y, width, height));
+			_scissor[0] = x;
+			_scissor[1] = y;
+			_scissor[2] = width;
+			_scissor[3] = height;
+			_scissorKnown = true;
+		}
+	}
+
+	void GLStateCache::deleteProgram(GLuint program)
+	{
+		if (_program == program)
+			_program = UNKNOWN_BINDING;
+		glDeleteProgram(program);
+	}
+
+	void GLStateCache::deleteVertexArray(GLuint vertexArray)
+	{
+		if (_vertexArray == vertexArray)
+		{
+			_vertexArray = UNKNOWN_BINDING;
+			_elementBuffer = UNKNOWN_BINDING;
+		}
+		glDeleteVertexArrays(1, &vertexArray);
+	}
+
+	void GLStateCache::deleteBuffer(GLuint buffer)
+	{
+		if (_arrayBuffer == buffer)
+			_arrayBuffer = UNKNOWN_BINDING;
+		if (_elementBuffer == buffer)
+			_elementBuffer = UNKNOWN_BINDING;
+		if (_uniformBuffer == buffer)
+			_uniformBuffer = UNKNOWN_BINDING;
+		for (unsigned int i = 0; i < MAX_UNIFORM_BINDINGS; i++)
+		{
+			if (_uniformBindings[i].buffer == buffer)
+				_uniformBindings[i].buffer = UNKNOWN_BINDING;
+		}
+		glDeleteBuffers(1, &buffer);
+	}
+
+	void GLStateCache::deleteTexture(GLuint texture)
+	{
+		forgetTexture(texture);
+		glDeleteTextures(1, &texture);
+	}
+
+	void GLStateCache::invalidate(void)
+	{
+		_program = UNKNOWN_BINDING;
+		_vertexArray = UNKNOWN_BINDING;
+		_arrayBuffer = UNKNOWN_BINDING;
+		_elementBuffer = UNKNOWN_BINDING;
+		_uniformBuffer = UNKNOWN_BINDING;
+		for (unsigned int i = 0; i < MAX_UNIFORM_BINDINGS; i++)
+			_uniformBindings[i] = { UNKNOWN_BINDING, 0, 0 };
+		_activeTexture = UNKNOWN_BINDING;
+		for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; unit++)
+		{
+			_textures[unit][0] = UNKNOWN_BINDING;
+			_textures[unit][1] = UNKNOWN_BINDING;
+		}
+
+		_blend = -1;
+		_blendSource = GL_NONE;
+		_blendDestination = GL_NONE;
+		_scissorTest = -1;
+		_scissorKnown = false;
+	}
+
+	void GLStateCache::resetCounters(void)
+	{
+		_counters = { 0, 0, 0, 0 };
+	}
+
+	void GLStateCache::countDrawCall(void)
+	{
+		_counters.drawCalls++;
+	}
+
+	void GLStateCache::countUniformUpload(void)
+	{
+		_counters.uniformUploads++;
+	}
+
+	// Getters
+	unsigned int GLStateCache::getActiveTexture(void) const
+	{
+		return (_activeTexture == UNKNOWN_BINDING ? 0 : _activeTexture);
+	}
+
+	void GLStateCache::getScissor(GLint box[4])
+	{
+		// Only asked to the driver when it was never set
+		if (!_scissorKnown)
+		{
+			glGetIntegerv(GL_SCISSOR_BOX, _scissor);
+			_scissorKnown = true;
+		}
+
+		for (unsigned int i = 0; i < 4; i++)
+			box[i] = _scissor[i];
+	}
+
+	const glStateCounters& GLStateCache::getCounters(void) const
+	{
+		return (_counters);
+	}
+
+	// Private
+	bool GLStateCache::change(bool changed)
+	{
+		if (changed)
+			_counters.issued++;
+		else
+			_counters.elided++;
+		return (changed);
+	}
+
+	void GLStateCache::forgetTexture(GLuint texture)
+	{
+		for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; unit++)
+		{
+			if (_textures[unit][0] == texture)
+				_textures[unit][0] = UNKNOWN_BINDING;
+			if (_textures[unit][1] == texture)
+				_textures[unit][1] = UNKNOWN_BINDING;
+		}
+	}
+
+	int GLStateCache::getTargetIndex(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_TEXTURE_2D:
+			return (0);
+		case GL_TEXTURE_2D_ARRAY:
+			return (1);
+		default:
+			return (-1);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cmath>
+
+#include "GUIBatch.h"
+
+namespace ExoEngine {
+
+	GUIBatch::GUIBatch(void)
+		: _frame(0), _rebuildCount(0), _split(true)
+	{	}
+
+	GUIBatch::~GUIBatch(void)
+	{	}
+
+	void GUIBatch::begin(void)
+	{
+		_frame++;
+		_vertices.clear();
+		_runs.clear();
+		_sequence.clear();
+		_rebuildCount = 0;
+		_split = true;
+	}
+
+	void GUIBatch::add(const void* key, const guiQuadSource& source)
+	{
+		widgetGeometry& geometry = _geometry[key];
+
+		if (geometry.vertices.empty() || !(geometry.source == source))
+		{
+			geometry.source = source;
+			geometry.vertices.clear();
+
+			if (source.sliced)
+				buildSliced(geometry.vertices, source);
+			else
+				buildQuad(geometry.vertices, source.position, source.size, source.rotation, source.offset, source.numberOfRows, source.numberOfColumns, source.opacity, source.texture->getUVRect());
+			_rebuildCount++;
+		}
+		geometry.lastUse = _frame;
+
+		size_t count = geometry.vertices.size() / 5;
+		// Textures packed in the same atlas page share a run
+		if (_split || _runs.back().texture->getEngineId() != source.texture->getEngineId())
+		{
+			_runs.push_back({ source.texture, _vertices.size() / 5, 0 });
+			_split = false;
+		}
+		_runs.back().count += count;
+
+		_vertices.insert(_vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+		_sequence.push_back(key);
+	}
+
+	void GUIBatch::split(void)
+	{
+		_split = true;
+	}
+
+	bool GUIBatch::end(void)
+	{
+		bool changed = _rebuildCount != 0 || _sequence != _lastSequence;
+		_lastSequence.swap(_sequence);
+
+		// Forget the widgets which were not drawn for a while
+		if ((_frame % 256) == 0)
+		{
+			for (std::unordered_map<const void*, widgetGeometry>::iterator iterator = _geometry.begin(); iterator != _geometry.end();)
+			{
+				if (_frame - iterator->second.lastUse > 256)
+					iterator = _geometry.erase(iterator);
+				else
+					iterator++;
+			}
+		}
+		return (changed);
+	}
+
+	// Getters
+	const std::vector<float>& GUIBatch::getVertices(void) const
+	{
+		return (_vertices);
+	}
+
+	const std::vector<guiRun>& GUIBatch::getRuns(void) const
+	{
+		return (_runs);
+	}
+
+	size_t GUIBatch::getRebuildCount(void) const
+	{
+		return (_rebuildCount);
+	}
+
+	// Private
+	void GUIBatch::buildQuad(std::vector<float>& vertices, const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec2& offset, float numberOfRows, float numberOfColumns, float opacity, const glm::vec4& uvRect)
+	{
+		// Same unit quad as the previous strip, rotated then scaled then translated
+		static const float corners[6][2] = {
+			{ -1.0f,  1.0f }, {  1.0f,  1.0f }, { -1.0f, -1.0f },
+			{  1.0f,  1.0f }, {  1.0f, -1.0f }, { -1.0f, -1.0f }
+		};
+
+		float c = std::cos(rotation);
+		float s = std::sin(rotation);
+
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			float x = corners[i][0];
+			float y = corners[i][1];
+
+			vertices.push_back(position.x + (x * c - y * s) * size.x);
+			vertices.push_back(position.y + (x * s + y * c) * size.y);
+			vertices.push_back(uvRect.x + ((x + 1.0f) / 2.0f / numberOfRows + offset.x) * uvRect.z);
+			vertices.push_back(uvRect.y + ((y + 1.0f) / 2.0f / numberOfColumns + offset.y) * uvRect.w);
+			vertices.push_back(opacity);
+		}
+	}
+
+	void GUIBatch::buildSliced(std::vector<float>& vertices, const guiQuadSource& source)
+	{
+		// Nine parts of a 3x6 atlas, the hover state uses the lower half
+		static const unsigned int parts[9][2] = {
+			{ 0, 0 }, { 0, 2 }, { 1, 0 }, { 2, 0 }, { 2, 1 }, { 1, 2 }, { 2, 2 }, { 0, 1 }, { 1, 1 }
+		};
+
+		const glm::vec2& position = source.position;
+		const glm::vec2& size = source.size;
+		const glm::vec4 uvRect = source.texture->getUVRect();
+
+		float cornerSize = size.y / 3.0f;
+		if (size.y > size.x)
+			cornerSize = size.x / 3.0f;
+
+		const float columnsX[3] = { position.x - size.x + cornerSize, position.x, position.x + size.x - cornerSize };
+		const float rowsY[3] = { position.y - size.y + cornerSize, position.y, position.y + size.y - cornerSize };
+		const float sizesX[3] = { cornerSize, size.x - cornerSize * 2, cornerSize };
+		const float sizesY[3] = { cornerSize, size.y - cornerSize * 2, cornerSize };
+
+		for (unsigned int i = 0; i < 9; i++)
+		{
+			unsigned int x = parts[i][0];
+			unsigned int y = parts[i][1];
+			glm::vec2 offset = glm::vec2((float)x / 3.0f, ((y + (source.hover ? 3 : 0)) % 6) / 6.0f);
+
+			buildQuad(vertices, glm::vec2(columnsX[x], rowsY[y]), glm::vec2(sizesX[x], sizesY[y]), 0.0f, offset, 3.0f, 6.0f, source.opacity, uvRect);
+		}
+	}
+
+}
\ No newline at end of file
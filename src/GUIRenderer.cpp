@@ -25,6 +25,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "GUIRenderer.h"
+#include "GLStateCache.h"
 #include "RendererSDLOpenGL.h"
 #include "UI/IWidget.cpp"
 
@@ -34,20 +35,14 @@ namespace ExoEngine {
 
 	Shader* GUIRenderer::pGuiShader = nullptr;
 
-	GUIRenderer::GUIRenderer(void): 
+	GUIRenderer::GUIRenderer(IRenderer* renderer): 
+		_pRenderer(renderer),
+		_labelListCount(0),
+		_lastRun(0),
+		_uploadPending(false),
 		_vaoBuffer(nullptr), 
 		_vertexBuffer(nullptr)
-	{
-		const float tmp[] = {
-			-1.0f,	1.0f,
-			 1.0f,	1.0f,
-			-1.0f, -1.0f,
-			 1.0f, -1.0f
-		};
-
-		_vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
-		_vertexBuffer = new Buffer(8, 2, &tmp, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
-	}
+	{	}
 
 	GUIRenderer::~GUIRenderer(void)
 	{
@@ -75,327 +70,315 @@ namespace ExoEngine {
 		}
 	}
 
-	void GUIRenderer::render(const glm::mat4& orthographic)
+	void GUIRenderer::render(void)
+	{
+		record();
+		submit();
+	}
+
+	void GUIRenderer::record(void)
 	{
-		_orthographic = orthographic;
-		prepare(orthographic);
+		_renderFrontQueue.clear();
+		_commands.clear();
+		_labelListCount = 0;
+		_lastRun = 0;
 
+		// Record the frame, only the widgets which changed rebuild their quads
+		_batch.begin();
 		for (IWidget* widget : _renderQueue)
-		{
-			if (render(widget, pGuiShader) == 1)
-				prepare(orthographic);
-		}
+			record(widget);
 
 		// Front
-		for (IWidget* widget : _renderFrontQueue)
+		for (size_t i = 0; i < _renderFrontQueue.size(); i++)
 		{
-			switch (widget->getType())
+			switch (_renderFrontQueue[i]->getType())
 			{
 			case IWidget::SELECT: {
-				auto select = (Select*)widget;
-				render(select->getView(), pGuiShader);
+				auto select = (Select*)_renderFrontQueue[i];
+				record(select->getView());
 				break;
 			}
 			default: break;
 			}
+		}
+		flushQuads();
 
-			prepare(_orthographic);
+		if (_batch.end())
+			_uploadPending = true;
+	}
+
+	void GUIRenderer::submit(void)
+	{
+		// Created on the first submit, record() alone never needs a GL context
+		if (!_vaoBuffer)
+		{
+			_vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+			_vertexBuffer = new Buffer(1024 * 5, 2, NULL, BufferType::ARRAYBUFFER, BufferDraw::DYNAMIC, 0, false);
+			_vertexBuffer->setAttribute(0, 2, 5, 0, 0);	// position
+			_vertexBuffer->setAttribute(1, 2, 5, 2, 0);	// uv
+			_vertexBuffer->setAttribute(2, 1, 5, 4, 0);	// opacity
+			_uploadPending = true;
+		}
+
+		if (_uploadPending)
+		{
+			const std::vector<float>& vertices = _batch.getVertices();
+			unsigned long capacity = _vertexBuffer->getCount();
+			while (capacity < vertices.size())
+				capacity *= 2;
+
+			// The geometry is retained and rarely changes, a fresh store avoids waiting for the frames still using the old one
+			_vertexBuffer->resize(capacity, NULL);
+			_vertexBuffer->updateSubData(vertices.size(), vertices.data());
+			_uploadPending = false;
 		}
+
+		prepare();
+		execute();
+	}
+
+	// Getters
+	const GUIBatch& GUIRenderer::getBatch(void) const
+	{
+		return (_batch);
+	}
+
+	const std::vector<GUIRenderer::guiCommand>& GUIRenderer::getCommands(void) const
+	{
+		return (_commands);
+	}
+
+	const std::vector<Label*>& GUIRenderer::getLabels(size_t list) const
+	{
+		return (_labelLists[list]);
 	}
 
 	// private
-	void GUIRenderer::prepare(const glm::mat4& orthographic)
+	void GUIRenderer::prepare(void)
 	{
 		pGuiShader->bind();
-		pGuiShader->setMat4("projection", orthographic);
 
 		// Render
 		_vaoBuffer->bind();
-		_vertexBuffer->bind();
 	}
 
-	unsigned char GUIRenderer::render(IWidget* widget, Shader* shader)
+	void GUIRenderer::execute(void)
 	{
-		switch (widget->getType())
+		const std::vector<guiRun>& runs = _batch.getRuns();
+
+		for (const guiCommand& command : _commands)
 		{
-		case IWidget::BUTTON: {
-			auto button = (Button*)widget;
-			return render(button, shader);
-		}
-		case IWidget::CHECKBOX: {
-			auto checkbox = (Checkbox*)widget;
-			return render(checkbox, shader);
-		}
-		case IWidget::SELECT: {
-			auto select = (Select*)widget;
-			return render(select, shader);
-		}
-		case IWidget::INPUT: {
-			auto input = (Input*)widget;
-			return render(input, shader);
-		}
-		case IWidget::SLIDER: {
-			auto slider = (Slider*)widget;
-			return render(slider, shader);
-		}
-		case IWidget::IMAGE: {
-			auto image = (Image*)widget;
-			return render(image, shader);
-		}
-		case IWidget::SPINNER: {
-			auto spinner = (Spinner*)widget;
-			return render(spinner, shader);
-		}
-		case IWidget::VIEW: {
-			auto view = (View*)widget;
-			return render(view, shader);
-		}
-		default: return 0;
+			switch (command.type)
+			{
+			case guiCommand::QUADS:
+				for (size_t i = command.first; i < command.last; i++)
+				{
+					runs[i].texture->bind();
+					GL_CALL(glDrawArrays(GL_TRIANGLES, (GLint)runs[i].first, (GLsizei)runs[i].count));
+					GLStateCache::Get().countDrawCall();
+				}
+				break;
+			case guiCommand::BEGIN_SCISSOR:
+				RendererSDLOpenGL::Get().beginScissor(command.position, command.size, command.parentPosition, command.parentSize);
+				break;
+			case guiCommand::END_SCISSOR:
+				RendererSDLOpenGL::Get().endScissor();
+				break;
+			case guiCommand::LABELS:
+				_viewTextRenderer.clear();
+				for (Label* label : _labelLists[command.first])
+					_viewTextRenderer.add(label);
+				_viewTextRenderer.render();
+				prepare();
+				break;
+			}
 		}
 	}
 
-	unsigned char GUIRenderer::render(Button* button, Shader* shader)
+	void GUIRenderer::flushQuads(void)
 	{
-		shader->setFloat("opacity", button->getOpacity());
-		button->getTexture()->bind();
-
-		if (button->getSliced())
-		{
-			shader->setFloat("numberOfRows", 3.0f);
-			shader->setFloat("numberOfColumns", 6.0f);
-
-			glm::vec2 tempPosition = button->getRealPosition() + button->getVirtualOffset() + button->getRelativeParentPosition();
-			bool isHoverOffset = button->getTextureIndex() == 1 ? true : false;
-
-			float cornerSize = button->getScaleSize().y / 3.0f;
-			if (button->getScaleSize().y > button->getScaleSize().x)
-				cornerSize = button->getScaleSize().x / 3.0f;
-
-			drawSliced(shader, 0, 0, tempPosition.x - button->getScaleSize().x + cornerSize, tempPosition.y - button->getScaleSize().y + cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Top left
-			drawSliced(shader, 0, 2, tempPosition.x - button->getScaleSize().x + cornerSize, tempPosition.y + button->getScaleSize().y - cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Bottom left
-			drawSliced(shader, 1, 0, tempPosition.x, tempPosition.y - button->getScaleSize().y + cornerSize, button->getScaleSize().x - cornerSize * 2, cornerSize, isHoverOffset, 3, 6);			 // Top center
-			drawSliced(shader, 2, 0, tempPosition.x + button->getScaleSize().x - cornerSize, tempPosition.y - button->getScaleSize().y + cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Top right
-			drawSliced(shader, 2, 1, tempPosition.x + button->getScaleSize().x - cornerSize, tempPosition.y, cornerSize, button->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);			 // Center right
-			drawSliced(shader, 1, 2, tempPosition.x, tempPosition.y + button->getScaleSize().y - cornerSize, button->getScaleSize().x - cornerSize * 2, cornerSize, isHoverOffset, 3, 6);			 // Bottom center
-			drawSliced(shader, 2, 2, tempPosition.x + button->getScaleSize().x - cornerSize, tempPosition.y + button->getScaleSize().y - cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Bottom left
-			drawSliced(shader, 0, 1, tempPosition.x - button->getScaleSize().x + cornerSize, tempPosition.y, cornerSize, button->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);			 // Center left
-			drawSliced(shader, 1, 1, tempPosition.x, tempPosition.y, button->getScaleSize().x - cornerSize * 2, button->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);						// Center
-		}
-		else
-		{
-			shader->setFloat("numberOfRows", button->getNumberOfRows());
-			shader->setFloat("numberOfColumns", button->getNumberOfColumns());
+		size_t count = _batch.getRuns().size();
+		if (count > _lastRun)
+			_commands.push_back(guiCommand::make(guiCommand::QUADS, _lastRun, count));
 
-			static glm::mat4 transformationMatrix;
-			transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(button->getRealPosition() + button->getVirtualOffset() + button->getRelativeParentPosition(), 0.0f)); // Translate
-			transformationMatrix = glm::scale(transformationMatrix, glm::vec3(button->getScaleSize(), 0.0f)); // Scale
-			shader->setMat4("transformation", transformationMatrix);
+		_batch.split();
+		_lastRun = count;
+	}
 
-			shader->setVec2("offset", button->getOffset());
-			GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
-		}
+	void GUIRenderer::pushQuad(const void* key, const std::shared_ptr<ITexture>& texture, const glm::vec2& position, const glm::vec2& size, float opacity, const glm::vec2& offset, float numberOfRows, float numberOfColumns, float rotation)
+	{
+		guiQuadSource source;
+		source.texture = texture.get();
+		source.position = position;
+		source.size = size;
+		source.offset = offset;
+		source.rotation = rotation;
+		source.opacity = opacity;
+		source.numberOfRows = numberOfRows;
+		source.numberOfColumns = numberOfColumns;
+		source.sliced = false;
+		source.hover = false;
+
+		_batch.add(key, source);
+	}
 
-		return 0;
+	void GUIRenderer::pushSliced(const void* key, const std::shared_ptr<ITexture>& texture, const glm::vec2& position, const glm::vec2& size, float opacity, bool hover)
+	{
+		guiQuadSource source;
+		source.texture = texture.get();
+		source.position = position;
+		source.size = size;
+		source.offset = glm::vec2(0.0f);
+		source.rotation = 0.0f;
+		source.opacity = opacity;
+		source.numberOfRows = 3.0f;
+		source.numberOfColumns = 6.0f;
+		source.sliced = true;
+		source.hover = hover;
+
+		_batch.add(key, source);
 	}
 
-	unsigned char GUIRenderer::render(Checkbox* checkbox, Shader* shader)
+	void GUIRenderer::record(IWidget* widget)
 	{
-		static glm::mat4 transformationMatrix;
-		transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(checkbox->getRealPosition() + checkbox->getVirtualOffset() + checkbox->getRelativeParentPosition(), 0.0f)); // Translate
-		transformationMatrix = glm::scale(transformationMatrix, glm::vec3(checkbox->getScaleSize(), 0.0f)); // Scale
-		shader->setMat4("transformation", transformationMatrix);
+		switch (widget->getType())
+		{
+		case IWidget::BUTTON:
+			record((Button*)widget);
+			break;
+		case IWidget::CHECKBOX:
+			record((Checkbox*)widget);
+			break;
+		case IWidget::SELECT:
+			record((Select*)widget);
+			break;
+		case IWidget::INPUT:
+			record((Input*)widget);
+			break;
+		case IWidget::SLIDER:
+			record((Slider*)widget);
+			break;
+		case IWidget::IMAGE:
+			record((Image*)widget);
+			break;
+		case IWidget::SPINNER:
+			record((Spinner*)widget);
+			break;
+		case IWidget::VIEW:
+			record((View*)widget);
+			break;
+		default: break;
+		}
+	}
 
-		shader->setFloat("opacity", checkbox->getOpacity());
-		shader->setFloat("numberOfRows", 1.0f);
-		shader->setFloat("numberOfColumns", 4.0f);
-		shader->setVec2("offset", checkbox->getOffset());
+	void GUIRenderer::record(Button* button)
+	{
+		glm::vec2 position = button->getRealPosition() + button->getVirtualOffset() + button->getRelativeParentPosition();
 
-		checkbox->getTexture()->bind();
-		GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+		if (button->getSliced())
+			pushSliced(button, button->getTexture(), position, button->getScaleSize(), button->getOpacity(), button->getTextureIndex() == 1);
+		else
+			pushQuad(button, button->getTexture(), position, button->getScaleSize(), button->getOpacity(), button->getOffset(), (float)button->getNumberOfRows(), (float)button->getNumberOfColumns());
+	}
 
-		return 0;
+	void GUIRenderer::record(Checkbox* checkbox)
+	{
+		glm::vec2 position = checkbox->getRealPosition() + checkbox->getVirtualOffset() + checkbox->getRelativeParentPosition();
+		pushQuad(checkbox, checkbox->getTexture(), position, checkbox->getScaleSize(), checkbox->getOpacity(), checkbox->getOffset(), 1.0f, 4.0f);
 	}
 
-	unsigned char GUIRenderer::render(Select* select, Shader* shader)
+	void GUIRenderer::record(Select* select)
 	{
 		if (select->isOpen())
 			_renderFrontQueue.push_back(select);
 
-		return render(select->getButton(), shader);
+		record(select->getButton());
 	}
 
-	unsigned char GUIRenderer::render(Input* input, Shader* shader)
+	void GUIRenderer::record(Input* input)
 	{
-		shader->setFloat("opacity", input->getOpacity());
-		input->getTexture()->bind();
+		glm::vec2 position = input->getRealPosition() + input->getVirtualOffset() + input->getRelativeParentPosition();
 
 		if (input->getSliced())
-		{
-			shader->setFloat("numberOfRows", 3.0f);
-			shader->setFloat("numberOfColumns", 6.0f);
-
-			glm::vec2 tempPosition = input->getRealPosition() + input->getVirtualOffset() + input->getRelativeParentPosition();
-			bool isHoverOffset = input->getSelected() == 1 ? true : false;
-
-			float cornerSize = input->getScaleSize().y / 3.0f;
-			if (input->getScaleSize().y > input->getScaleSize().x)
-				cornerSize = input->getScaleSize().x / 3.0f;
-
-			drawSliced(shader, 0, 0, tempPosition.x - input->getScaleSize().x + cornerSize, tempPosition.y - input->getScaleSize().y + cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Top left
-			drawSliced(shader, 0, 2, tempPosition.x - input->getScaleSize().x + cornerSize, tempPosition.y + input->getScaleSize().y - cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Bottom left
-			drawSliced(shader, 1, 0, tempPosition.x, tempPosition.y - input->getScaleSize().y + cornerSize, input->getScaleSize().x - cornerSize * 2, cornerSize, isHoverOffset, 3, 6);			 // Top center
-			drawSliced(shader, 2, 0, tempPosition.x + input->getScaleSize().x - cornerSize, tempPosition.y - input->getScaleSize().y + cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Top right
-			drawSliced(shader, 2, 1, tempPosition.x + input->getScaleSize().x - cornerSize, tempPosition.y, cornerSize, input->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);			 // Center right
-			drawSliced(shader, 1, 2, tempPosition.x, tempPosition.y + input->getScaleSize().y - cornerSize, input->getScaleSize().x - cornerSize * 2, cornerSize, isHoverOffset, 3, 6);			 // Bottom center
-			drawSliced(shader, 2, 2, tempPosition.x + input->getScaleSize().x - cornerSize, tempPosition.y + input->getScaleSize().y - cornerSize, cornerSize, cornerSize, isHoverOffset, 3, 6);	// Bottom left
-			drawSliced(shader, 0, 1, tempPosition.x - input->getScaleSize().x + cornerSize, tempPosition.y, cornerSize, input->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);			 // Center left
-			drawSliced(shader, 1, 1, tempPosition.x, tempPosition.y, input->getScaleSize().x - cornerSize * 2, input->getScaleSize().y - cornerSize * 2, isHoverOffset, 3, 6);						// Center
-		}
+			pushSliced(input, input->getTexture(), position, input->getScaleSize(), input->getOpacity(), input->getSelected() == 1);
 		else
-		{
-			shader->setFloat("numberOfRows", (float)input->getNumberOfRows());
-			shader->setFloat("numberOfColumns", (float)input->getNumberOfColumns());
-
-			static glm::mat4 transformationMatrix;
-			transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(input->getRealPosition() + input->getVirtualOffset() + input->getRelativeParentPosition(), 0.0f)); // Translate
-			transformationMatrix = glm::scale(transformationMatrix, glm::vec3(input->getScaleSize(), 0.0f)); // Scale
-			shader->setMat4("transformation", transformationMatrix);
-
-			shader->setVec2("offset", 0, 0);
-			GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
-		}
-		return 0;
+			pushQuad(input, input->getTexture(), position, input->getScaleSize(), input->getOpacity(), glm::vec2(0.0f), (float)input->getNumberOfRows(), (float)input->getNumberOfColumns());
 	}
 
-	unsigned char GUIRenderer::render(Image* image, Shader* shader)
+	void GUIRenderer::record(Image* image)
 	{
-		static glm::mat4 transformationMatrix;
-		transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(image->getRealPosition() + image->getVirtualOffset() + image->getRelativeParentPosition(), 0.0f)); // Translate
-		transformationMatrix = glm::scale(transformationMatrix, glm::vec3(image->getScaleSize(), 0.0f)); // Scale
-		transformationMatrix = glm::rotate(transformationMatrix, image->getRotation(), glm::vec3(0, 0, 1)); // Rotation
-		shader->setMat4("transformation", transformationMatrix);
-
-		shader->setFloat("opacity", image->getOpacity());
-		shader->setFloat("numberOfRows", image->getNumberOfRows());
-		shader->setFloat("numberOfColumns", image->getNumberOfColumns());
-		shader->setVec2("offset", image->getOffset());
-
-		image->getTexture()->bind();
-		GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
-
-		return 0;
+		glm::vec2 position = image->getRealPosition() + image->getVirtualOffset() + image->getRelativeParentPosition();
+		pushQuad(image, image->getTexture(), position, image->getScaleSize(), image->getOpacity(), image->getOffset(), (float)image->getNumberOfRows(), (float)image->getNumberOfColumns(), image->getRotation());
 	}
 
-	unsigned char GUIRenderer::render(Spinner* spinner, Shader* shader)
+	void GUIRenderer::record(Spinner* spinner)
 	{
-		static glm::mat4 transformationMatrix;
-		transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(spinner->getRealPosition() + spinner->getVirtualOffset() + spinner->getRelativeParentPosition(), 0.0f)); // Translate
-		transformationMatrix = glm::scale(transformationMatrix, glm::vec3(spinner->getScaleSize(), 0.0f)); // Scale
-		transformationMatrix = glm::rotate(transformationMatrix, spinner->getRotation(), glm::vec3(0, 0, 1)); // Rotation
-		shader->setMat4("transformation", transformationMatrix);
-
-		shader->setFloat("opacity", spinner->getOpacity());
-		shader->setFloat("numberOfRows", 1);
-		shader->setFloat("numberOfColumns", 1);
-		shader->setVec2("offset", 0, 0);
-
-		spinner->getTexture()->bind();
-		GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
-
-		return 0;
+		glm::vec2 position = spinner->getRealPosition() + spinner->getVirtualOffset() + spinner->getRelativeParentPosition();
+		pushQuad(spinner, spinner->getTexture(), position, spinner->getScaleSize(), spinner->getOpacity(), glm::vec2(0.0f), 1.0f, 1.0f, spinner->getRotation());
 	}
 
-	unsigned char GUIRenderer::render(View* view, Shader* shader)
+	void GUIRenderer::record(View* view)
 	{
-		// Render background
+		// Background
 		if (view->getBackgroundTexture().get() != nullptr)
-		{
-			static glm::mat4 transformationMatrix;
-			transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(view->getRealPosition() + view->getVirtualOffset() + view->getRelativeParentPosition(), 0.0f)); // Translate
-			transformationMatrix = glm::scale(transformationMatrix, glm::vec3(view->getScaleSize(), 0.0f)); // Scale
-			shader->setMat4("transformation", transformationMatrix);
-			shader->setFloat("opacity", 0.0f);
-
-			view->getBackgroundTexture()->bind();
-			GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
-		}
+			pushQuad(view, view->getBackgroundTexture(), view->getRealPosition() + view->getVirtualOffset() + view->getRelativeParentPosition(), view->getScaleSize(), 0.0f);
 
-		// Render scroll
+		// Scroll
 		if (view->getLastScrollHeight() > view->getRealPosition().y + view->getRelativeParentPosition().y + view->getScaleSize().y)
-		{
-			auto scrollbarButton = view->getScrollbarButton();
-			render(scrollbarButton, shader);
-		}
+			record(view->getScrollbarButton());
+
+		// Childs are drawn inside the scissor of the view
+		flushQuads();
 
-		// Render childs
-		RendererSDLOpenGL::Get().beginScissor(glm::vec2(view->getRealPosition().x + view->getVirtualOffset().x + view->getRelativeParentPosition().x - view->getScaleSize().x,
-			RendererSDLOpenGL::Get().getWindow()->getHeight() - (view->getRealPosition().y + view->getVirtualOffset().y + view->getRelativeParentPosition().y + view->getScaleSize().y)),
-			glm::vec2(view->getScaleSize().x * 2, view->getScaleSize().y * 2),
-			glm::vec2(view->getParentScissor().x, view->getParentScissor().y),
-			glm::vec2(view->getParentScissor().z, view->getParentScissor().w));
+		guiCommand scissor;
+		scissor.type = guiCommand::BEGIN_SCISSOR;
+		scissor.position = glm::vec2(view->getRealPosition().x + view->getVirtualOffset().x + view->getRelativeParentPosition().x - view->getScaleSize().x,
+			_pRenderer->getWindow()->getHeight() - (view->getRealPosition().y + view->getVirtualOffset().y + view->getRelativeParentPosition().y + view->getScaleSize().y));
+		scissor.size = glm::vec2(view->getScaleSize().x * 2, view->getScaleSize().y * 2);
+		scissor.parentPosition = glm::vec2(view->getParentScissor().x, view->getParentScissor().y);
+		scissor.parentSize = glm::vec2(view->getParentScissor().z, view->getParentScissor().w);
+		_commands.push_back(scissor);
 
-		TextRenderer tempTextRenderer;
+		if (_labelListCount == _labelLists.size())
+			_labelLists.emplace_back();
+		size_t labels = _labelListCount++;
+		_labelLists[labels].clear();
 
 		// Back
 		for (IWidget* widget : view->getRenderQueue())
 		{
-			//widget->contextInfo(RendererSDLOpenGL::Get().getUIScaleFactor(), RendererSDLOpenGL::Get().getWindow()->getWidth(), RendererSDLOpenGL::Get().getWindow()->getHeight());
-
-			// Temporary
 			switch (widget->getType())
 			{
-			case IWidget::SELECT: {
-				auto select = (Select*)widget;
-				tempTextRenderer.add(select->getLabel());
+			case IWidget::SELECT:
+				_labelLists[labels].push_back(((Select*)widget)->getLabel());
 				break;
-			}
-			case IWidget::BUTTON: {
-				auto button = (Button*)widget;
-				tempTextRenderer.add(button->getLabel());
+			case IWidget::BUTTON:
+				_labelLists[labels].push_back(((Button*)widget)->getLabel());
 				break;
-			}
-			case IWidget::INPUT: {
-				auto input = (Input*)widget;
-				tempTextRenderer.add(input->getLabel());
+			case IWidget::INPUT:
+				_labelLists[labels].push_back(((Input*)widget)->getLabel());
 				break;
-			}
 			default: break;
 			}
 
-			if (render(widget, shader) == 1)
-				prepare(_orthographic);
+			record(widget);
 		}
 
 		for (Label* label : view->getLabelRenderQueue())
 		{
-			label->contextInfo(RendererSDLOpenGL::Get().getUIScaleFactor(), RendererSDLOpenGL::Get().getWindow()->getWidth(), RendererSDLOpenGL::Get().getWindow()->getHeight());
-			tempTextRenderer.add(label);
+			label->contextInfo(_pRenderer->getUIScaleFactor(), _pRenderer->getWindow()->getWidth(), _pRenderer->getWindow()->getHeight());
+			_labelLists[labels].push_back(label);
 		}
-		tempTextRenderer.render(_orthographic);
-		prepare(_orthographic);
-
-		RendererSDLOpenGL::Get().endScissor();
 
-		return 1;
+		flushQuads();
+		_commands.push_back(guiCommand::make(guiCommand::LABELS, labels, labels + 1));
+		_commands.push_back(guiCommand::make(guiCommand::END_SCISSOR, 0, 0));
 	}
 
-	unsigned char GUIRenderer::render(Slider* slider, Shader* shader)
+	void GUIRenderer::record(Slider* slider)
 	{
-		render(slider->getBarImage(), shader);
-		render(slider->getSliderButton(), shader);
-		return 0;
-	}
-
-	void GUIRenderer::drawSliced(Shader* shader, unsigned int offsetX, unsigned int offsetY, float positionX, float positionY, float sizeX, float sizeY, bool isHoverOffset, unsigned int numberOfRows, unsigned int numberOfColumns)
-	{
-		static glm::mat4 transformationMatrix;
-
-		transformationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(positionX, positionY, 0.0f)); // Translate
-		transformationMatrix = glm::scale(transformationMatrix, glm::vec3(sizeX, sizeY, 0.0f)); // Scale
-		shader->setMat4("transformation", transformationMatrix);
-
-		shader->setVec2("offset", (float)offsetX / numberOfRows, ((offsetY + (isHoverOffset == true ? 3 : 0)) % numberOfColumns) / (float)numberOfColumns);
-		GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+		record(slider->getBarImage());
+		record(slider->getSliderButton());
 	}
 
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
  */
 
 #include "Grid.h"
+#include "GLStateCache.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 
@@ -31,49 +32,90 @@
 namespace ExoEngine {
 
 	Shader* Grid::pShader = nullptr;
-	Buffer* Grid::vaoBuffer = nullptr;
-	Buffer* Grid::vertexBuffer = nullptr;
+	UniformHandle<glm::mat4> Grid::modelUniform;
+	UniformHandle<glm::vec4> Grid::colorUniform;
 
 	Grid::Grid(int width, int height, glm::vec2 pos)
-		: _width(width), _height(height), _pos(pos)
+		: _width(width), _height(height), _pos(pos), _pVaoBuffer(nullptr), _pVertexBuffer(nullptr), _dirty(true)
 	{
 	}
 
 	Grid::~Grid(void)
 	{
+		if (_pVertexBuffer)
+			delete _pVertexBuffer;
+
+		if (_pVaoBuffer)
+			delete _pVaoBuffer;
+	}
+
+	void Grid::loadUniforms(void)
+	{
+		modelUniform = pShader->getUniform<glm::mat4>("model");
+		colorUniform = pShader->getUniform<glm::vec4>("color");
 	}
 
-	void Grid::render(const glm::mat4& lookAt, const glm::mat4& perspective)
+	void Grid::render(void)
 	{
-		vaoBuffer->bind();
-		vertexBuffer->bind();
+		// The buffers are created on the first render, on the thread owning the context
+		if (_dirty)
+			build();
+
+		_pVaoBuffer->bind();
 
 		pShader->bind();
-		pShader->setMat4("projection", perspective);
-		pShader->setMat4("view", lookAt);
-		pShader->setVec4("color", 1, 1, 1, 1);
+		pShader->set(colorUniform, glm::vec4(1, 1, 1, 1));
+		pShader->set(modelUniform, glm::translate(glm::mat4(1.0f), glm::vec3(_pos, 0.0f)));
+
+		GL_CALL(glDrawArrays(GL_LINES, 0, (GLsizei)(_vertices.size() / 2)));
+		GLStateCache::Get().countDrawCall();
+	}
+
+	// Setters
+	void Grid::setSize(unsigned int width, unsigned int height)
+	{
+		if (width != _width || height != _height)
+		{
+			_width = width;
+			_height = height;
+			_dirty = true;
+		}
+	}
+
+	void Grid::setPosition(const glm::vec2& pos)
+	{
+		_pos = pos;
+	}
+
+	// Private
+	void Grid::build(void)
+	{
+		// Origin at center
+		float left = -(float)(_width / 2);
+		float bottom = -(float)(_height / 2);
+
+		_vertices.clear();
+		_vertices.reserve((_width + _height + 2) * 4);
 
-		// Loop - origin at center
 		for (unsigned int x = 0; x < _width + 1; x++)
 		{
-			drawLine(x - (_width / 2), _pos.y - (_height / 2), 1.5708);
+			_vertices.insert(_vertices.end(), { left + x, bottom, left + x, bottom + _height });
 		}
 
 		for (unsigned int y = 0; y < _height + 1; y++)
 		{
-			drawLine(_pos.x - (_width / 2), y - (_height / 2), 0.0f);
+			_vertices.insert(_vertices.end(), { left, bottom + y, left + _width, bottom + y });
 		}
-	}
 
-	void Grid::drawLine(int x, int y, float angle)
-	{
-		static glm::mat4 model;
-		model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, 0.0f));
-		model = glm::rotate(model, angle, glm::vec3(0, 0, 1));
-		model = glm::scale(model, glm::vec3(_width, _height, 0.0f));
-		pShader->setMat4("model", model);
+		if (!_pVaoBuffer)
+		{
+			_pVaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+			_pVertexBuffer = new Buffer(_vertices.size(), 2, _vertices.data(), BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
+		}
+		else
+			_pVertexBuffer->resize(_vertices.size(), _vertices.data());
 
-		GL_CALL(glDrawArrays(GL_LINES, 0, 2));
+		_dirty = false;
 	}
 
 }
\ No newline at end of file
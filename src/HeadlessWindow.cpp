@@ -0,0 +1,245 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#ifdef EXO_HEADLESS
+
+#include <SDL2/SDL_image.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "SDLException.h"
+#include "HeadlessWindow.h"
+#include "OGLCall.h"
+
+// GLEW built for GLX reports the missing X display, the GL entry points are loaded anyway
+#ifndef GLEW_ERROR_NO_GLX_DISPLAY
+# define GLEW_ERROR_NO_GLX_DISPLAY 4
+#endif
+
+namespace ExoEngine {
+
+	HeadlessWindow::HeadlessWindow(uint32_t width, uint32_t height)
+		: Window(), _display(EGL_NO_DISPLAY), _eglContext(EGL_NO_CONTEXT), _eglThreadContext(EGL_NO_CONTEXT)
+	{
+		initialize(width, height);
+	}
+
+	HeadlessWindow::~HeadlessWindow(void)
+	{
+		// Targets and passes go before the contexts
+		_postProcessing.release();
+		releaseEGL();
+	}
+
+	void HeadlessWindow::initialize(uint32_t width, uint32_t height)
+	{
+		_width = width;
+		_height = height;
+
+		_contextWidth = width;
+		_contextHeight = height;
+		_highDPIFactor = 1;
+		_windowMode = WindowMode::HEADLESS;
+
+		// Timers, signals and images, no video subsystem
+		if (!(SDL_WasInit(SDL_INIT_EVENTS) & SDL_INIT_EVENTS))
+			if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS))
+				throw (SDLException());
+
+		IMG_Init(IMG_INIT_PNG);
+		IMG_Init(IMG_INIT_JPG);
+
+		initializeEGL();
+
+#ifndef __APPLE__
+		GLenum error;
+
+		if ((error = glewInit()) != GLEW_OK && error != GLEW_ERROR_NO_GLX_DISPLAY)
+		{
+			releaseEGL();
+			throw (error);
+		}
+#endif
+
+		// OpenGL setup, there is no surface to size the viewport
+		GL_CALL(glEnable(GL_CULL_FACE));
+		GL_CALL(glCullFace(GL_BACK));
+		GL_CALL(glViewport(0, 0, _contextWidth, _contextHeight));
+
+		// Post Processing, into the output target
+		_postProcessing.setOffscreen(true);
+		initPostProcessing();
+	}
+
+	void HeadlessWindow::initializeEGL(void)
+	{
+		const EGLint configAttributes[] = {
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_NONE
+		};
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 3,
+			EGL_CONTEXT_MINOR_VERSION, 2,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		EGLConfig config;
+		EGLint configCount = 0;
+
+		// Surfaceless platform when Mesa has it (no X, no GPU device needed), the default display otherwise
+		const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+		if (clientExtensions && std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless") && getPlatformDisplay)
+			_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (_display == EGL_NO_DISPLAY)
+			_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		if (_display == EGL_NO_DISPLAY || !eglInitialize(_display, nullptr, nullptr))
+		{
+			_display = EGL_NO_DISPLAY;
+			throw (std::runtime_error("EGL error when opening the display"));
+		}
+
+		// The destructor doesn't run when the constructor throws, every failure below releases the display
+		const char* extensions = eglQueryString(_display, EGL_EXTENSIONS);
+		if (!extensions || !std::strstr(extensions, "EGL_KHR_surfaceless_context"))
+		{
+			releaseEGL();
+			throw (std::runtime_error("EGL display without surfaceless contexts"));
+		}
+
+		if (!eglBindAPI(EGL_OPENGL_API)
+			|| !eglChooseConfig(_display, configAttributes, &config, 1, &configCount) || configCount < 1)
+		{
+			releaseEGL();
+			throw (std::runtime_error("EGL error when choosing the config"));
+		}
+
+		// Same pair as the window: the main context and a shared one for the loading thread
+		if ((_eglContext = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes)) == EGL_NO_CONTEXT
+			|| (_eglThreadContext = eglCreateContext(_display, config, _eglContext, contextAttributes)) == EGL_NO_CONTEXT)
+		{
+			releaseEGL();
+			throw (std::runtime_error("EGL error when creating the context"));
+		}
+
+		// Contexts are made current without any surface
+		if (!eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _eglContext))
+		{
+			releaseEGL();
+			throw (std::runtime_error("EGL error when activating the context"));
+		}
+	}
+
+	void HeadlessWindow::releaseEGL(void)
+	{
+		if (_display == EGL_NO_DISPLAY)
+			return;
+
+		eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (_eglThreadContext != EGL_NO_CONTEXT)
+			eglDestroyContext(_display, _eglThreadContext);
+		if (_eglContext != EGL_NO_CONTEXT)
+			eglDestroyContext(_display, _eglContext);
+		eglTerminate(_display);
+
+		_eglThreadContext = EGL_NO_CONTEXT;
+		_eglContext = EGL_NO_CONTEXT;
+		_display = EGL_NO_DISPLAY;
+	}
+
+	void HeadlessWindow::handleEvents(Keyboard&, Mouse&)
+	{
+		SDL_Event event;
+
+		// No input, only the quit request (SIGINT / SIGTERM)
+		while (SDL_PollEvent(&event))
+			if (event.type == SDL_QUIT)
+				_close = true;
+	}
+
+	void HeadlessWindow::swap(void)
+	{
+		// Nothing to present, the frame stays in the output target
+		_postProcessing.apply();
+		GL_CALL(glFlush());
+	}
+
+	void HeadlessWindow::handleThread(void)
+	{
+		static std::thread::id	prev = std::thread::id();
+
+		if (std::this_thread::get_id() != prev)
+			if (eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _eglThreadContext))
+				prev = std::this_thread::get_id();
+	}
+
+	// Setters
+	void HeadlessWindow::setWindowSize(int w, int h)
+	{
+		_width = w;
+		_height = h;
+		_contextWidth = w;
+		_contextHeight = h;
+		GL_CALL(glViewport(0, 0, w, h));
+
+		//> Post Processing
+		initPostProcessing();
+	}
+
+	void HeadlessWindow::setWindowMode(const WindowMode&)
+	{
+		// Always headless
+	}
+
+	void HeadlessWindow::setVsync(bool)
+	{
+		// Nothing is presented
+	}
+
+	void HeadlessWindow::isCursorVisible(bool)
+	{
+	}
+
+	// Getters
+	void* HeadlessWindow::getWindowID()
+	{
+		return (nullptr);
+	}
+
+	void* HeadlessWindow::getGLContext()
+	{
+		return (_eglContext);
+	}
+
+}
+
+#endif
\ No newline at end of file
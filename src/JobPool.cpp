@@ -0,0 +1,153 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "JobPool.h"
+
+namespace ExoEngine {
+
+	JobPool::JobPool(unsigned int workers)
+		: _joining(false)
+	{
+		if (workers == 0)
+		{
+			unsigned int hardware = std::thread::hardware_concurrency();
+			workers = hardware > 1 ? hardware - 1 : 0;
+		}
+
+		for (unsigned int i = 0; i < workers; i++)
+			_threads.push_back(std::thread(&JobPool::loop, this));
+	}
+
+	JobPool::~JobPool(void)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_joining = true;
+		}
+		_condition.notify_all();
+
+		for (std::thread& thread : _threads)
+			thread.join();
+	}
+
+	void JobPool::run(const std::vector<std::function<void(void)>>& jobs)
+	{
+		std::atomic<size_t> remaining(jobs.size());
+
+		if (jobs.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (const std::function<void(void)>& job : jobs)
+				_jobs.push_back({ job, &remaining });
+		}
+		_condition.notify_all();
+
+		wait(remaining);
+	}
+
+	void JobPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t chunk, size_t begin, size_t end)>& function)
+	{
+		size_t chunks;
+
+		if (count == 0)
+			return;
+		if (grain == 0)
+			grain = 1;
+		chunks = (count + grain - 1) / grain;
+
+		// Not worth a hand over
+		if (chunks == 1 || _threads.empty())
+		{
+			for (size_t chunk = 0; chunk < chunks; chunk++)
+				function(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+			return;
+		}
+
+		std::atomic<size_t> remaining(chunks);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (size_t chunk = 0; chunk < chunks; chunk++)
+			{
+				size_t begin = chunk * grain;
+				size_t end = std::min(count, begin + grain);
+				_jobs.push_back({ [&function, chunk, begin, end]() { function(chunk, begin, end); }, &remaining });
+			}
+		}
+		_condition.notify_all();
+
+		wait(remaining);
+	}
+
+	// Getters
+	unsigned int JobPool::getWorkerCount(void) const
+	{
+		return ((unsigned int)_threads.size());
+	}
+
+	// Private
+	bool JobPool::execute(void)
+	{
+		pendingJob job;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_jobs.empty())
+				return (false);
+			job = _jobs.front();
+			_jobs.pop_front();
+		}
+
+		job.function();
+		(*job.remaining)--;
+		return (true);
+	}
+
+	void JobPool::wait(std::atomic<size_t>& remaining)
+	{
+		while (remaining > 0)
+		{
+			if (!execute())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobPool::loop(void)
+	{
+		while (1)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_condition.wait(lock, [this]() { return (_joining || !_jobs.empty()); });
+				if (_joining)
+					return;
+			}
+			execute();
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,510 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EXO_LIGHTING_SSE
+#endif
+
+#include "Lighting.h"
+#include "GLStateCache.h"
+
+// Corners closer than this to the camera plane make the light cover the whole screen
+#define LIGHT_MIN_W	0.0001f
+
+namespace ExoEngine {
+
+	Lighting::Lighting(void)
+		: _tilesX(0), _tilesY(0), _viewport(0.0f), _shadowCasters(false), _ambient(1.0f), _shadows(false),
+		_pShadowFrameBuffer(nullptr), _pShadowMask(nullptr), _previousFrameBuffer(0)
+	{
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			_pBuffers[i] = nullptr;
+			_textures[i] = 0;
+		}
+		for (unsigned int i = 0; i < 4; i++)
+			_previousViewport[i] = 0;
+	}
+
+	Lighting::~Lighting(void)
+	{
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			if (_pBuffers[i])
+				delete _pBuffers[i];
+			if (_textures[i])
+				GLStateCache::Get().deleteTexture(_textures[i]);
+		}
+		destroyShadowMask();
+	}
+
+	LightHandle Lighting::add(const pointLight& light)
+	{
+		LightHandle handle;
+		uint32_t index = (uint32_t)_lights.size();
+
+		if (!_freeHandles.empty())
+		{
+			handle = _freeHandles.back();
+			_freeHandles.pop_back();
+			_handleToIndex[handle] = index;
+		}
+		else
+		{
+			handle = (LightHandle)_handleToIndex.size();
+			_handleToIndex.push_back(index);
+		}
+
+		_lights.push_back(light);
+		_positionX.push_back(light.position.x);
+		_positionY.push_back(light.position.y);
+		_radius.push_back(light.radius);
+		_indexToHandle.push_back(handle);
+
+		return (handle);
+	}
+
+	void Lighting::update(LightHandle handle, const pointLight& light)
+	{
+		if (!contains(handle))
+			throw (std::out_of_range("Invalid light handle"));
+
+		uint32_t index = _handleToIndex[handle];
+		_lights[index] = light;
+		_positionX[index] = light.position.x;
+		_positionY[index] = light.position.y;
+		_radius[index] = light.radius;
+	}
+
+	void Lighting::remove(LightHandle handle)
+	{
+		if (!contains(handle))
+			return;
+
+		// Move the last light in the hole to keep the arrays packed
+		uint32_t index = _handleToIndex[handle];
+		uint32_t last = (uint32_t)_lights.size() - 1;
+
+		if (index != last)
+		{
+			_lights[index] = _lights[last];
+			_positionX[index] = _positionX[last];
+			_positionY[index] = _positionY[last];
+			_radius[index] = _radius[last];
+			_indexToHandle[index] = _indexToHandle[last];
+			_handleToIndex[_indexToHandle[index]] = index;
+		}
+
+		_lights.pop_back();
+		_positionX.pop_back();
+		_positionY.pop_back();
+		_radius.pop_back();
+		_indexToHandle.pop_back();
+
+		_handleToIndex[handle] = INVALID_LIGHT_HANDLE;
+		_freeHandles.push_back(handle);
+	}
+
+	void Lighting::clear(void)
+	{
+		_lights.clear();
+		_positionX.clear();
+		_positionY.clear();
+		_radius.clear();
+		_indexToHandle.clear();
+		_handleToIndex.clear();
+		_freeHandles.clear();
+	}
+
+	void Lighting::cull(const glm::mat4& viewProjection, int width, int height)
+	{
+		_tilesX = (unsigned int)std::max((width + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE, 1);
+		_tilesY = (unsigned int)std::max((height + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE, 1);
+		_viewport = glm::vec2((float)width, (float)height);
+
+		_rects.resize(_lights.size() * 4);
+		project(viewProjection, 0, _lights.size());
+		bin();
+	}
+
+	void Lighting::upload(void)
+	{
+		static const size_t minimums[3] = { LIGHT_TEXELS * 4, 2, 1 };
+		const void* data[3] = { _visibleLights.data(), _tiles.data(), _indices.data() };
+		size_t counts[3] = { _visibleLights.size(), _tiles.size(), _indices.size() };
+
+		if (!_pBuffers[0])
+			createBuffers();
+
+		// Each list is respecified once per frame, an empty buffer texture is not portable so keep one element
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			if (counts[i] < minimums[i])
+				_pBuffers[i]->resize(minimums[i], NULL);
+			else
+				_pBuffers[i]->resize(counts[i], data[i]);
+		}
+	}
+
+	void Lighting::bind(unsigned int unit) const
+	{
+		for (unsigned int i = 0; i < 3; i++)
+			GLStateCache::Get().bindTexture(unit + i, GL_TEXTURE_BUFFER, _textures[i]);
+
+		if (_shadows && _pShadowMask)
+			_pShadowMask->bind(unit + 3);
+	}
+
+	void Lighting::beginShadows(void)
+	{
+		GL_CALL(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_previousFrameBuffer));
+		GL_CALL(glGetIntegerv(GL_VIEWPORT, _previousViewport));
+
+		int width = std::max(_previousViewport[2] / LIGHT_SHADOW_DOWNSAMPLE, 1);
+		int height = std::max(_previousViewport[3] / LIGHT_SHADOW_DOWNSAMPLE, 1);
+
+		if (!_pShadowMask || (int)_pShadowMask->getWidth() != width || (int)_pShadowMask->getHeight() != height)
+			createShadowMask(width, height);
+
+		// Binds, sets the viewport and clears to black: red is the occupancy of the occluders
+		_pShadowFrameBuffer->clear();
+	}
+
+	void Lighting::endShadows(void)
+	{
+		GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, _previousFrameBuffer));
+		GL_CALL(glViewport(_previousViewport[0], _previousViewport[1], _previousViewport[2], _previousViewport[3]));
+	}
+
+	// Setters
+	void Lighting::setAmbient(const glm::vec3& ambient)
+	{
+		_ambient = ambient;
+	}
+
+	void Lighting::setShadows(bool enabled)
+	{
+		_shadows = enabled;
+	}
+
+	// Getters
+	const pointLight& Lighting::get(LightHandle handle) const
+	{
+		if (!contains(handle))
+			throw (std::out_of_range("Invalid light handle"));
+		return (_lights[_handleToIndex[handle]]);
+	}
+
+	bool Lighting::contains(LightHandle handle) const
+	{
+		return (handle < _handleToIndex.size() && _handleToIndex[handle] != INVALID_LIGHT_HANDLE);
+	}
+
+	size_t Lighting::size(void) const
+	{
+		return (_lights.size());
+	}
+
+	const glm::vec3& Lighting::getAmbient(void) const
+	{
+		return (_ambient);
+	}
+
+	bool Lighting::isShadowEnabled(void) const
+	{
+		return (_shadows);
+	}
+
+	bool Lighting::hasShadowCasters(void) const
+	{
+		return (_shadowCasters);
+	}
+
+	unsigned int Lighting::getVisibleCount(void) const
+	{
+		return ((unsigned int)(_visibleLights.size() / (LIGHT_TEXELS * 4)));
+	}
+
+	unsigned int Lighting::getTilesX(void) const
+	{
+		return (_tilesX);
+	}
+
+	unsigned int Lighting::getTilesY(void) const
+	{
+		return (_tilesY);
+	}
+
+	const glm::vec2& Lighting::getViewport(void) const
+	{
+		return (_viewport);
+	}
+
+	Texture* Lighting::getShadowMask(void) const
+	{
+		return (_pShadowMask);
+	}
+
+	// Private
+	void Lighting::project(const glm::mat4& viewProjection, size_t begin, size_t end)
+	{
+		// Tile coordinates from NDC: t = ndc * scale + scale
+		const float scaleX = _viewport.x / (2.0f * LIGHT_TILE_SIZE);
+		const float scaleY = _viewport.y / (2.0f * LIGHT_TILE_SIZE);
+		const float lastX = (float)(_tilesX - 1);
+		const float lastY = (float)(_tilesY - 1);
+		size_t i = begin;
+
+#ifdef EXO_LIGHTING_SSE
+		const __m128 m00 = _mm_set1_ps(viewProjection[0][0]), m10 = _mm_set1_ps(viewProjection[1][0]), m30 = _mm_set1_ps(viewProjection[3][0]);
+		const __m128 m01 = _mm_set1_ps(viewProjection[0][1]), m11 = _mm_set1_ps(viewProjection[1][1]), m31 = _mm_set1_ps(viewProjection[3][1]);
+		const __m128 m03 = _mm_set1_ps(viewProjection[0][3]), m13 = _mm_set1_ps(viewProjection[1][3]), m33 = _mm_set1_ps(viewProjection[3][3]);
+		const __m128 sx = _mm_set1_ps(scaleX), sy = _mm_set1_ps(scaleY);
+		const __m128 tilesX = _mm_set1_ps((float)_tilesX), tilesY = _mm_set1_ps((float)_tilesY);
+		const __m128 maxX = _mm_set1_ps(lastX), maxY = _mm_set1_ps(lastY);
+		const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), minW = _mm_set1_ps(LIGHT_MIN_W);
+		const __m128 infinity = _mm_set1_ps(INFINITY);
+
+		// Four lights per iteration: the corners of their boxes are projected, the screen rectangle is turned into tiles
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(_positionX.data() + i);
+			__m128 cy = _mm_loadu_ps(_positionY.data() + i);
+			__m128 r = _mm_loadu_ps(_radius.data() + i);
+			__m128 left = _mm_sub_ps(cx, r), right = _mm_add_ps(cx, r);
+			__m128 bottom = _mm_sub_ps(cy, r), top = _mm_add_ps(cy, r);
+			__m128 minNX = infinity, minNY = infinity;
+			__m128 maxNX = _mm_sub_ps(zero, infinity), maxNY = maxNX;
+			__m128 behind = zero;
+
+			for (unsigned int corner = 0; corner < 4; corner++)
+			{
+				__m128 x = (corner & 1) ? right : left;
+				__m128 y = (corner & 2) ? top : bottom;
+				__m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m03, x), _mm_mul_ps(m13, y)), m33);
+
+				behind = _mm_or_ps(behind, _mm_cmple_ps(w, minW));
+				w = _mm_div_ps(one, w);
+
+				__m128 nx = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), m30), w);
+				__m128 ny = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), m31), w);
+				minNX = _mm_min_ps(minNX, nx);
+				maxNX = _mm_max_ps(maxNX, nx);
+				minNY = _mm_min_ps(minNY, ny);
+				maxNY = _mm_max_ps(maxNY, ny);
+			}
+
+			__m128 minTX = _mm_add_ps(_mm_mul_ps(minNX, sx), sx);
+			__m128 maxTX = _mm_add_ps(_mm_mul_ps(maxNX, sx), sx);
+			__m128 minTY = _mm_add_ps(_mm_mul_ps(minNY, sy), sy);
+			__m128 maxTY = _mm_add_ps(_mm_mul_ps(maxNY, sy), sy);
+
+			__m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(maxTX, zero), _mm_cmpge_ps(minTX, tilesX)),
+				_mm_or_ps(_mm_cmplt_ps(maxTY, zero), _mm_cmpge_ps(minTY, tilesY)));
+			outside = _mm_andnot_ps(behind, outside);
+
+			// A light crossing the camera plane covers every tile
+			minTX = _mm_andnot_ps(behind, minTX);
+			minTY = _mm_andnot_ps(behind, minTY);
+			maxTX = _mm_or_ps(_mm_and_ps(behind, maxX), _mm_andnot_ps(behind, maxTX));
+			maxTY = _mm_or_ps(_mm_and_ps(behind, maxY), _mm_andnot_ps(behind, maxTY));
+
+			// Clamped to the grid, the coordinates are positive so truncating floors them
+			alignas(16) int32_t rect[4][4];
+			_mm_store_si128((__m128i*)rect[0], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(minTX, zero), maxX)));
+			_mm_store_si128((__m128i*)rect[1], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(minTY, zero), maxY)));
+			_mm_store_si128((__m128i*)rect[2], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(maxTX, zero), maxX)));
+			_mm_store_si128((__m128i*)rect[3], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(maxTY, zero), maxY)));
+
+			int mask = _mm_movemask_ps(outside);
+			for (unsigned int lane = 0; lane < 4; lane++)
+			{
+				int32_t* out = &_rects[(i + lane) * 4];
+				out[0] = (mask & (1 << lane)) ? 1 : rect[0][lane];
+				out[1] = rect[1][lane];
+				out[2] = (mask & (1 << lane)) ? 0 : rect[2][lane];
+				out[3] = rect[3][lane];
+			}
+		}
+#endif
+
+		for (; i < end; i++)
+		{
+			float minNX = INFINITY, minNY = INFINITY, maxNX = -INFINITY, maxNY = -INFINITY;
+			bool behind = false;
+			int32_t* out = &_rects[i * 4];
+
+			for (unsigned int corner = 0; corner < 4; corner++)
+			{
+				float x = _positionX[i] + ((corner & 1) ? _radius[i] : -_radius[i]);
+				float y = _positionY[i] + ((corner & 2) ? _radius[i] : -_radius[i]);
+				float w = viewProjection[0][3] * x + viewProjection[1][3] * y + viewProjection[3][3];
+
+				if (w <= LIGHT_MIN_W)
+				{
+					behind = true;
+					break;
+				}
+
+				float nx = (viewProjection[0][0] * x + viewProjection[1][0] * y + viewProjection[3][0]) / w;
+				float ny = (viewProjection[0][1] * x + viewProjection[1][1] * y + viewProjection[3][1]) / w;
+				minNX = std::min(minNX, nx);
+				maxNX = std::max(maxNX, nx);
+				minNY = std::min(minNY, ny);
+				maxNY = std::max(maxNY, ny);
+			}
+
+			if (behind)
+			{
+				out[0] = 0;
+				out[1] = 0;
+				out[2] = (int32_t)lastX;
+				out[3] = (int32_t)lastY;
+				continue;
+			}
+
+			float minTX = minNX * scaleX + scaleX, maxTX = maxNX * scaleX + scaleX;
+			float minTY = minNY * scaleY + scaleY, maxTY = maxNY * scaleY + scaleY;
+
+			if (maxTX < 0.0f || minTX >= (float)_tilesX || maxTY < 0.0f || minTY >= (float)_tilesY)
+			{
+				out[0] = 1;
+				out[2] = 0;
+				continue;
+			}
+
+			out[0] = (int32_t)std::min(std::max(minTX, 0.0f), lastX);
+			out[1] = (int32_t)std::min(std::max(minTY, 0.0f), lastY);
+			out[2] = (int32_t)std::min(std::max(maxTX, 0.0f), lastX);
+			out[3] = (int32_t)std::min(std::max(maxTY, 0.0f), lastY);
+		}
+	}
+
+	void Lighting::bin(void)
+	{
+		size_t tiles = (size_t)_tilesX * _tilesY;
+		uint32_t visible = 0;
+
+		_tiles.assign(tiles * 2, 0);
+		_cursors.resize(tiles);
+		_visibleLights.clear();
+		_shadowCasters = false;
+
+		// Count the lights of every tile and pack the visible ones
+		for (size_t i = 0; i < _lights.size(); i++)
+		{
+			const int32_t* rect = &_rects[i * 4];
+			const pointLight& light = _lights[i];
+
+			if (rect[0] > rect[2])
+				continue;
+
+			_visibleLights.insert(_visibleLights.end(), {
+				light.position.x, light.position.y, light.radius, light.intensity,
+				light.color.r, light.color.g, light.color.b, light.castShadows ? 1.0f : 0.0f
+			});
+			_shadowCasters |= light.castShadows;
+
+			for (int32_t y = rect[1]; y <= rect[3]; y++)
+			{
+				for (int32_t x = rect[0]; x <= rect[2]; x++)
+					_tiles[((size_t)y * _tilesX + x) * 2 + 1]++;
+			}
+		}
+
+		// Offsets of the lists
+		uint32_t offset = 0;
+		for (size_t tile = 0; tile < tiles; tile++)
+		{
+			_tiles[tile * 2] = offset;
+			_cursors[tile] = offset;
+			offset += _tiles[tile * 2 + 1];
+		}
+
+		// Fill the lists with the indices of the packed lights
+		_indices.resize(offset);
+		for (size_t i = 0; i < _lights.size(); i++)
+		{
+			const int32_t* rect = &_rects[i * 4];
+
+			if (rect[0] > rect[2])
+				continue;
+
+			for (int32_t y = rect[1]; y <= rect[3]; y++)
+			{
+				for (int32_t x = rect[0]; x <= rect[2]; x++)
+					_indices[_cursors[(size_t)y * _tilesX + x]++] = visible;
+			}
+			visible++;
+		}
+	}
+
+	void Lighting::createBuffers(void)
+	{
+		static const GLenum formats[3] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+		GLStateCache& stateCache = GLStateCache::Get();
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			_pBuffers[i] = new Buffer(4, 0, NULL, BufferType::TEXTUREBUFFER, BufferDraw::DYNAMIC, 0, false);
+
+			// The texture keeps pointing at the buffer when its store is respecified
+			_textures[i] = stateCache.genTexture();
+			stateCache.bindTexture(stateCache.getActiveTexture(), GL_TEXTURE_BUFFER, _textures[i]);
+			GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, formats[i], _pBuffers[i]->getBuffer()));
+		}
+	}
+
+	void Lighting::createShadowMask(int width, int height)
+	{
+		destroyShadowMask();
+
+		_pShadowMask = new Texture(width, height, RGBA, LINEAR);
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		_pShadowFrameBuffer = new FrameBuffer();
+		_pShadowFrameBuffer->attach(_pShadowMask);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			throw ("Error::FRAMEBUFFER:: Framebuffer is not complete!");
+	}
+
+	void Lighting::destroyShadowMask(void)
+	{
+		if (_pShadowFrameBuffer)
+			delete _pShadowFrameBuffer;
+		_pShadowFrameBuffer = nullptr;
+
+		if (_pShadowMask)
+			delete _pShadowMask;
+		_pShadowMask = nullptr;
+	}
+
+}
\ No newline at end of file
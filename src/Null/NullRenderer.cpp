@@ -0,0 +1,234 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include "Null/NullRenderer.h"
+#include "UI/Image.h"
+#include <stdexcept>
+
+namespace ExoEngine {
+
+	void NullRenderer::initialize(const std::string&, const int width, const int height, const WindowMode&, bool)
+	{
+		// Destroy if window already exist
+		if (_pWindow)
+			delete _pWindow;
+
+		// Whatever the mode, the size is kept for the UI scale and the cameras
+		_pWindow = new NullWindow(width, height);
+		resize();
+
+		// CPU times of the frames, the stages stay empty
+		if (!_pProfiler)
+			_pProfiler = new Profiler();
+	}
+
+	void NullRenderer::resize()
+	{
+		_UIScaleFactor = _pWindow->getWidth() / REFRENCE_RESOLUTION_WIDTH;
+	}
+
+	// Create
+	ICamera* NullRenderer::createCamera(void)
+	{
+		return new Camera(_pWindow);
+	}
+
+	ITexture* NullRenderer::createTexture(const std::string& filePath, TextureFilter)
+	{
+		return (new NullTexture(filePath));
+	}
+
+	ITexture* NullRenderer::createTexture(unsigned int width, unsigned int height, TextureFormat, TextureFilter)
+	{
+		return (new NullTexture(width, height));
+	}
+
+	IArrayTexture* NullRenderer::createArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+	{
+		return (new NullArrayTexture(width, height, textures, filter));
+	}
+
+	ITextureAtlas* NullRenderer::createTextureAtlas(int, int, std::vector<std::string>& textures, TextureFilter)
+	{
+		return (new NullTextureAtlas(textures));
+	}
+
+	IImage* NullRenderer::createImage(const std::shared_ptr<ITexture>& texture)
+	{
+		return new Image(texture, _UIScaleFactor, _pWindow->getWidth(), _pWindow->getHeight());
+	}
+
+	IFrameBuffer* NullRenderer::createFrameBuffer(void)
+	{
+		throw (std::runtime_error("frame buffers need the GPU, the null renderer has no context"));
+	}
+
+	// Push
+	RenderHandle NullRenderer::add(sprite&)
+	{
+		// Never INVALID_RENDER_HANDLE
+		if (_nextHandle == INVALID_RENDER_HANDLE)
+			_nextHandle = 0;
+		return (_nextHandle++);
+	}
+
+	void NullRenderer::add(IWidget*)
+	{	}
+
+	void NullRenderer::add(Label*)
+	{	}
+
+	void NullRenderer::add(TileMap*)
+	{	}
+
+	void NullRenderer::add(ParticleEmitter*)
+	{	}
+
+	void NullRenderer::update(RenderHandle, const sprite&)
+	{	}
+
+	void NullRenderer::remove(RenderHandle)
+	{	}
+
+	void NullRenderer::remove(sprite&)
+	{	}
+
+	void NullRenderer::remove(IWidget*)
+	{	}
+
+	void NullRenderer::remove(Label*)
+	{	}
+
+	void NullRenderer::remove(TileMap*)
+	{	}
+
+	void NullRenderer::remove(ParticleEmitter*)
+	{	}
+
+	// Draw
+	void NullRenderer::draw(void)
+	{
+		_pProfiler->beginFrame();
+	}
+
+	void NullRenderer::swap(void)
+	{
+		_mouse.updateLastBuffer();
+		_keyboard.updateLastBuffer();
+
+		_pWindow->handleEvents();
+		_pWindow->tick();
+		_pProfiler->endFrame();
+	}
+
+	// Getters
+	IWindow* NullRenderer::getWindow(void)
+	{
+		return _pWindow;
+	}
+
+	Keyboard* NullRenderer::getKeyboard(void)
+	{
+		return &_keyboard;
+	}
+
+	Mouse* NullRenderer::getMouse(void)
+	{
+		return &_mouse;
+	}
+
+	unsigned int NullRenderer::getTime(void) const
+	{
+		return SDL_GetTicks();
+	}
+
+	Lighting* NullRenderer::getLighting(void)
+	{
+		return (nullptr);
+	}
+
+	const particleStats& NullRenderer::getParticleStats(void) const
+	{
+		return (_particleStats);
+	}
+
+	const frameStats& NullRenderer::getFrameStats(void) const
+	{
+		return (_frameStats);
+	}
+
+	Profiler* NullRenderer::getProfiler(void)
+	{
+		return (_pProfiler);
+	}
+
+	// Setters
+	void NullRenderer::setCursor(ICursor*)
+	{	}
+
+	void NullRenderer::setMousePicker(MousePicker* picker)
+	{
+		_pMousePicker = picker;
+	}
+
+	void NullRenderer::setAxis(Axis* axis)
+	{
+		_pAxis = axis;
+	}
+
+	void NullRenderer::setGridEnable(bool)
+	{	}
+
+	void NullRenderer::setCulling(bool, float)
+	{	}
+
+	void NullRenderer::setLighting(bool)
+	{	}
+
+	void NullRenderer::setParticleBudget(unsigned int)
+	{	}
+
+	void NullRenderer::setTextureCompression(bool)
+	{	}
+
+	void NullRenderer::setProfilerOverlay(const std::shared_ptr<Font>&)
+	{	}
+
+	// Private
+	NullRenderer::NullRenderer(void)
+		: IRenderer(), _pWindow(nullptr), _nextHandle(0), _pProfiler(nullptr)
+	{
+		_particleStats = particleStats();
+		_frameStats = frameStats();
+	}
+
+	NullRenderer::~NullRenderer(void)
+	{
+		if (_pProfiler)
+			delete _pProfiler;
+
+		if (_pWindow)
+			delete _pWindow;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <SDL2/SDL_image.h>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Null/NullTexture.h"
+
+namespace ExoEngine {
+
+	// GUIBatch merges the runs of a same engine id
+	static std::atomic<int> nextTextureId(1);
+
+	static int readBigEndian(const unsigned char* bytes, int count)
+	{
+		int value = 0;
+		for (int i = 0; i < count; ++i)
+			value = (value << 8) | bytes[i];
+		return (value);
+	}
+
+	// Width and height of the IHDR chunk, always the first one
+	static bool readPNGSize(std::ifstream& file, int& width, int& height)
+	{
+		static const unsigned char signature[8] = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
+		unsigned char header[24];
+
+		if (!file.read((char*)header, sizeof(header)) || std::memcmp(header, signature, 8) || std::memcmp(header + 12, "IHDR", 4))
+			return (false);
+
+		width = readBigEndian(header + 16, 4);
+		height = readBigEndian(header + 20, 4);
+		return (true);
+	}
+
+	// Segments are skipped up to the first start of frame marker, which holds the size
+	static bool readJPEGSize(std::ifstream& file, int& width, int& height)
+	{
+		unsigned char bytes[9];
+
+		if (!file.read((char*)bytes, 2) || bytes[0] != 0xFF || bytes[1] != 0xD8)
+			return (false);
+
+		while (file.read((char*)bytes, 4))
+		{
+			if (bytes[0] != 0xFF)
+				return (false);
+
+			unsigned char marker = bytes[1];
+			int length = readBigEndian(bytes + 2, 2);
+
+			// SOF0 to SOF15, without DHT (C4), JPG (C8) and DAC (CC)
+			if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+			{
+				if (!file.read((char*)bytes, 5))
+					return (false);
+				height = readBigEndian(bytes + 1, 2);
+				width = readBigEndian(bytes + 3, 2);
+				return (true);
+			}
+
+			if (length < 2)
+				return (false);
+			file.seekg(length - 2, std::ios::cur);
+		}
+		return (false);
+	}
+
+	NullTexture::NullTexture(const std::string& filePath)
+		: _id(nextTextureId++), _width(0), _height(0)
+	{
+		readSize(filePath, _width, _height);
+	}
+
+	NullTexture::NullTexture(unsigned int width, unsigned int height)
+		: _id(nextTextureId++), _width((int)width), _height((int)height)
+	{	}
+
+	NullTexture::~NullTexture(void)
+	{	}
+
+	void NullTexture::bind(int) const
+	{	}
+
+	void NullTexture::unbind(void) const
+	{	}
+
+	// Getters
+	int NullTexture::getEngineId(void) const
+	{
+		return (_id);
+	}
+
+	int NullTexture::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int NullTexture::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	void NullTexture::readSize(const std::string& filePath, int& width, int& height)
+	{
+		width = 1;
+		height = 1;
+
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file)
+			return;
+
+		if (readPNGSize(file, width, height))
+			return;
+
+		file.clear();
+		file.seekg(0);
+		if (readJPEGSize(file, width, height))
+			return;
+
+		width = 1;
+		height = 1;
+
+		// Other formats: the pixels are dropped as soon as the size is known
+		SDL_Surface* image = IMG_Load(filePath.c_str());
+		if (!image)
+			return;
+
+		width = image->w;
+		height = image->h;
+		SDL_FreeSurface(image);
+	}
+
+	// NullArrayTexture
+	NullArrayTexture::NullArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+		: _width(0), _height(0), _layers(0)
+	{
+		initialize(width, height, textures, filter);
+	}
+
+	NullArrayTexture::~NullArrayTexture(void)
+	{	}
+
+	void NullArrayTexture::initialize(int width, int height, std::vector<std::string>& textures, TextureFilter)
+	{
+		// Every layer has the size of the array, the images do not need to be opened
+		_width = width;
+		_height = height;
+		_layers = (int)textures.size();
+	}
+
+	void NullArrayTexture::bind(int) const
+	{	}
+
+	void NullArrayTexture::unbind(void) const
+	{	}
+
+	// Getters
+	int NullArrayTexture::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int NullArrayTexture::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	int NullArrayTexture::getLayerCount(void) const
+	{
+		return (_layers);
+	}
+
+	// NullTextureAtlas
+	NullTextureAtlas::NullTextureAtlas(std::vector<std::string>& textures)
+	{
+		for (const std::string& path : textures)
+			_textures.push_back(std::shared_ptr<ITexture>(new NullTexture(path)));
+	}
+
+	NullTextureAtlas::~NullTextureAtlas(void)
+	{	}
+
+	// Getters
+	const std::shared_ptr<ITexture>& NullTextureAtlas::getTexture(size_t index) const
+	{
+		if (index >= _textures.size())
+			throw (std::out_of_range("atlas texture index out of range"));
+		return (_textures[index]);
+	}
+
+	size_t NullTextureAtlas::size(void) const
+	{
+		return (_textures.size());
+	}
+
+	size_t NullTextureAtlas::getPageCount(void) const
+	{
+		return (_textures.size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <SDL2/SDL_image.h>
+
+#include "Null/NullWindow.h"
+#include "SDLException.h"
+
+namespace ExoEngine {
+
+	NullWindow::NullWindow(uint32_t width, uint32_t height)
+		: IWindow()
+	{
+		_width = width;
+		_height = height;
+
+		_contextWidth = width;
+		_contextHeight = height;
+		_highDPIFactor = 1;
+		_windowMode = WindowMode::HEADLESS;
+
+		// Timers and signals, no video subsystem
+		if (!(SDL_WasInit(SDL_INIT_EVENTS) & SDL_INIT_EVENTS))
+			if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS))
+				throw (SDLException());
+
+		_now = SDL_GetPerformanceCounter();
+		_last = _now;
+	}
+
+	NullWindow::~NullWindow(void)
+	{
+		IMG_Quit();
+		SDL_Quit();
+	}
+
+	void NullWindow::handleEvents(void)
+	{
+		while (SDL_PollEvent(&_event))
+		{
+			if (_event.type == SDL_QUIT)
+				_close = true;
+		}
+	}
+
+	void NullWindow::tick(void)
+	{
+		_last = _now;
+		_now = SDL_GetPerformanceCounter();
+	}
+
+	// Setters
+	void NullWindow::isCursorVisible(bool)
+	{	}
+
+	void NullWindow::setWindowSize(int w, int h)
+	{
+		_width = w;
+		_height = h;
+		_contextWidth = w;
+		_contextHeight = h;
+	}
+
+	void NullWindow::setWindowMode(const WindowMode&)
+	{
+		// Always headless
+	}
+
+	void NullWindow::setVsync(bool)
+	{	}
+
+	// Post processing
+	void NullWindow::addPostProcess(const std::string&, const std::string&)
+	{	}
+
+	void NullWindow::removePostProcess(const std::string&)
+	{	}
+
+	void NullWindow::setPostProcessEnabled(const std::string&, bool)
+	{	}
+
+	void NullWindow::setResolutionScale(float)
+	{	}
+
+	void NullWindow::setFrameTimeTarget(double)
+	{	}
+
+	float NullWindow::getResolutionScale(void) const
+	{
+		return (1.0f);
+	}
+
+	// Getters
+	void* NullWindow::getWindowID()
+	{
+		return (nullptr);
+	}
+
+	void* NullWindow::getGLContext()
+	{
+		return (nullptr);
+	}
+
+	double NullWindow::getDelta(void) const
+	{
+		return (double)((_now - _last) * 1000 / (double)SDL_GetPerformanceFrequency());
+	}
+
+	float NullWindow::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	float NullWindow::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	int NullWindow::getContextWidth(void) const
+	{
+		return (_contextWidth);
+	}
+
+	int NullWindow::getContextHeight(void) const
+	{
+		return (_contextHeight);
+	}
+
+	int NullWindow::getHighDPIFactor(void) const
+	{
+		return (_highDPIFactor);
+	}
+
+	bool NullWindow::isFullscreen(void) const
+	{
+		return (false);
+	}
+
+	bool NullWindow::getIsClosing(void) const
+	{
+		return (_close);
+	}
+
+	IFrameBuffer* NullWindow::getFrameBuffer(void) const
+	{
+		return (nullptr);
+	}
+
+	void NullWindow::readPixels(std::vector<uint8_t>& pixels) const
+	{
+		pixels.clear();
+	}
+
+}
\ No newline at end of file
@@ -22,18 +22,33 @@
  *	SOFTWARE.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 #include "ObjectRenderer.h"
+#include "GLStateCache.h"
 
 namespace ExoEngine {
 
 	Shader* ObjectRenderer::pShader = nullptr;
+	UniformHandle<float> ObjectRenderer::sizeUniform;
+	UniformHandle<int> ObjectRenderer::lightingUniform;
+	UniformHandle<int> ObjectRenderer::normalMappedUniform;
+	UniformHandle<int> ObjectRenderer::occluderUniform;
+	UniformHandle<int> ObjectRenderer::shadowsUniform;
+	UniformHandle<glm::vec3> ObjectRenderer::ambientUniform;
+	UniformHandle<float> ObjectRenderer::lightTileSizeUniform;
+	UniformHandle<int> ObjectRenderer::lightTilesXUniform;
+	UniformHandle<glm::vec2> ObjectRenderer::lightViewportUniform;
 	Buffer* ObjectRenderer::vaoBuffer = nullptr;
 	Buffer* ObjectRenderer::vertexBuffer = nullptr;
 	Buffer* ObjectRenderer::indexBuffer = nullptr;
 	Buffer* ObjectRenderer::uvBuffer = nullptr;
+	StreamBuffer* ObjectRenderer::instanceStream = nullptr;
 
 	ObjectRenderer::ObjectRenderer(void)
-		: _pGrid(nullptr), _gridEnabled(false)
+		: _pGrid(nullptr), _gridEnabled(false), _cullingEnabled(true), _depth(0), _instanceOffset(0), _pSpatialGrid(nullptr), _pLighting(nullptr)
 	{
 		_pGrid = new Grid(100, 100, { 0.0f, 0.0f });
 	}
@@ -42,78 +57,426 @@ namespace ExoEngine {
 	{
 		if (_pGrid)
 			delete _pGrid;
+
+		if (_pSpatialGrid)
+			delete _pSpatialGrid;
 	}
 
-	void ObjectRenderer::add(const sprite& s)
+	RenderHandle ObjectRenderer::add(const sprite& s)
 	{
-		_renderQueue.push_back(s);
+		uint32_t depth = _depth++ & 0xFFFFFF;
+		uint16_t material = acquireMaterial(s);
+		RenderHandle handle = _renderQueue.add(s, makeKey(s, material, depth));
+
+		if (handle >= _depths.size())
+		{
+			_depths.resize(handle + 1);
+			_owners.resize(handle + 1);
+			_handleMaterials.resize(handle + 1);
+		}
+		_depths[handle] = depth;
+		_owners[handle] = &s;
+		_handleMaterials[handle] = material;
+
+		_spriteHandles[&s] = handle;
+
+		if (_pSpatialGrid)
+		{
+			glm::vec2 center, extent;
+			spriteBounds(s, center, extent);
+			_pSpatialGrid->insert(handle, center - extent, center + extent);
+		}
+		return (handle);
 	}
 
-	void ObjectRenderer::remove(const sprite& s)
+	void ObjectRenderer::update(RenderHandle handle, const sprite& s)
 	{
-		for (std::deque<sprite>::iterator iterator = _renderQueue.begin(); iterator != _renderQueue.end(); iterator++)
+		// Checked before the materials, a stale handle would release one a second time
+		if (!_renderQueue.contains(handle))
+			throw (std::out_of_range("Invalid render handle"));
+
+		// Acquired first, a sprite keeping its textures does not free and take back its material
+		uint16_t material = acquireMaterial(s);
+		releaseMaterial(_handleMaterials[handle]);
+		_handleMaterials[handle] = material;
+
+		_renderQueue.update(handle, s, makeKey(s, material, _depths[handle]));
+
+		if (_pSpatialGrid)
 		{
-			if (&*iterator == &s)
-			{
-				_renderQueue.erase(iterator);
-				return;
-			}
+			glm::vec2 center, extent;
+			spriteBounds(s, center, extent);
+			_pSpatialGrid->update(handle, center - extent, center + extent);
 		}
 	}
 
+	void ObjectRenderer::remove(RenderHandle handle)
+	{
+		if (!_renderQueue.contains(handle))
+			return;
+
+		std::unordered_map<const sprite*, RenderHandle>::iterator iterator = _spriteHandles.find(_owners[handle]);
+		if (iterator != _spriteHandles.end() && iterator->second == handle)
+			_spriteHandles.erase(iterator);
+
+		if (_pSpatialGrid)
+			_pSpatialGrid->remove(handle);
+
+		releaseMaterial(_handleMaterials[handle]);
+		_renderQueue.remove(handle);
+	}
+
+	void ObjectRenderer::remove(const sprite& s)
+	{
+		// The queue stores copies, find the handle from the address given to add
+		std::unordered_map<const sprite*, RenderHandle>::iterator iterator = _spriteHandles.find(&s);
+		if (iterator != _spriteHandles.end())
+			remove(iterator->second);
+	}
+
 	void ObjectRenderer::render(Camera* camera, const glm::mat4& perspective)
+	{
+		record(perspective * camera->getLookAt());
+		submit();
+	}
+
+	void ObjectRenderer::record(const glm::mat4& viewProjection, JobPool* pool)
+	{
+		_commands.clear();
+
+		if (_renderQueue.empty())
+			return;
+
+		const std::vector<renderEntry>& entries = cull(viewProjection, pool);
+		if (entries.empty())
+			return;
+
+		// Every chunk packs its sprites in place, the chunks only depend on the grain so the result is
+		// the same whatever the number of workers
+		size_t chunks = (entries.size() + SPRITE_RECORD_GRAIN - 1) / SPRITE_RECORD_GRAIN;
+		if (_chunkCommands.size() < chunks)
+			_chunkCommands.resize(chunks);
+		_instances.resize(entries.size());
+
+		forEachChunk(pool, entries.size(), SPRITE_RECORD_GRAIN, [this, &entries](size_t chunk, size_t begin, size_t end) {
+			recordChunk(entries, chunk, begin, end);
+		});
+
+		// Runs crossing a chunk boundary are joined again
+		for (size_t chunk = 0; chunk < chunks; chunk++)
+			_commands.append(_chunkCommands[chunk]);
+	}
+
+	void ObjectRenderer::submit(void)
 	{
 		if (_gridEnabled)
-			_pGrid->render(camera->getLookAt(), perspective);
+			_pGrid->render();
 
-		prepare(camera, perspective);
+		if (_commands.empty())
+			return;
 
-		for (sprite& object : _renderQueue)
+		prepare();
+		uploadInstances();
+
+		const std::vector<drawPacket>& packets = _commands.sort();
+		if (_pLighting)
+			prepareLighting(packets);
+
+		for (const drawPacket& packet : packets)
 		{
-			renderObject(object, pShader);
+			renderBatch((const spriteMaterial*)packet.state, _pLighting != nullptr, _instanceOffset, packet.first, packet.count);
 		}
 	}
 
+	void ObjectRenderer::loadUniforms(void)
+	{
+		sizeUniform = pShader->getUniform<float>("size");
+		lightingUniform = pShader->getUniform<int>("lighting");
+		normalMappedUniform = pShader->getUniform<int>("normalMapped");
+		occluderUniform = pShader->getUniform<int>("occluder");
+		shadowsUniform = pShader->getUniform<int>("shadows");
+		ambientUniform = pShader->getUniform<glm::vec3>("ambient");
+		lightTileSizeUniform = pShader->getUniform<float>("lightTileSize");
+		lightTilesXUniform = pShader->getUniform<int>("lightTilesX");
+		lightViewportUniform = pShader->getUniform<glm::vec2>("lightViewport");
+
+		// Texture units, fixed for the life of the program
+		pShader->bind();
+		pShader->set(pShader->getUniform<int>("normalMap"), 1);
+		pShader->set(pShader->getUniform<int>("lights"), 2);
+		pShader->set(pShader->getUniform<int>("lightTiles"), 3);
+		pShader->set(pShader->getUniform<int>("lightIndices"), 4);
+		pShader->set(pShader->getUniform<int>("shadowMask"), 5);
+		pShader->set(lightingUniform, 0);
+		pShader->set(occluderUniform, 0);
+	}
+
 	void ObjectRenderer::setGrid(bool val)
 	{
 		_gridEnabled = val;
 	}
 
+	void ObjectRenderer::setCulling(bool enabled, float cellSize)
+	{
+		_cullingEnabled = enabled;
+
+		if (_pSpatialGrid)
+		{
+			delete _pSpatialGrid;
+			_pSpatialGrid = nullptr;
+		}
+
+		// Optional spatial index, the culling cost then follows the visible area instead of the queue size
+		if (enabled && cellSize > 0.0f)
+		{
+			_pSpatialGrid = new SpatialGrid(cellSize);
+			for (uint32_t i = 0; i < _renderQueue.size(); i++)
+			{
+				glm::vec2 center, extent;
+				spriteBounds(_renderQueue[i], center, extent);
+				_pSpatialGrid->insert(_renderQueue.handleAt(i), center - extent, center + extent);
+			}
+		}
+	}
+
+	void ObjectRenderer::setLighting(Lighting* lighting)
+	{
+		_pLighting = lighting;
+	}
+
 	// Private
-	void ObjectRenderer::prepare(Camera* camera, const glm::mat4& perspective)
+	void ObjectRenderer::prepare(void)
 	{
 		pShader->bind();
-		pShader->setMat4("projection", perspective);
-		pShader->setMat4("view", camera->getLookAt());
+		pShader->set(sizeUniform, 1.0f);
+		pShader->set(lightingUniform, 0);
 
 		// Render
 		vaoBuffer->bind();
 		vertexBuffer->bind();
 		uvBuffer->bind();
 
-		GL_CALL(glEnable(GL_BLEND));
-		GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLStateCache::Get().setBlend(true);
+		GLStateCache::Get().setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
-	void ObjectRenderer::renderObject(sprite& s, Shader* shader)
+	const std::vector<renderEntry>& ObjectRenderer::cull(const glm::mat4& viewProjection, JobPool* pool)
 	{
-		static glm::mat4 model;
+		if (!_cullingEnabled)
+			return (_renderQueue.sort());
 
-		s.texture->bind();
+		_frustum.update(viewProjection);
 
-		model = glm::translate(glm::mat4(1.0f), glm::vec3(s.position, 0.0f));
-		model = glm::rotate(model, s.angle, glm::vec3(0, 0, 1));
-		model = glm::scale(model, glm::vec3(s.scale, 0.0f));
-		shader->setMat4("model", model);
+		// Without the spatial grid the sorted queue is tested in place, nothing is copied
+		const std::vector<renderEntry>* candidates = &_candidates;
+		glm::vec2 min, max;
+		if (_pSpatialGrid && _frustum.getBounds(min, max))
+		{
+			// Only the sprites around the visible area are sorted and tested
+			_queryHandles.clear();
+			_pSpatialGrid->query(min, max, _queryHandles);
 
-		shader->setInt("layer", (int)s.layer);
-		shader->setInt("flipHorizontal", s.flip == HORIZONTAL ? -1 : 1);
-		shader->setInt("flipVertical", s.flip == VERTICAL ? -1 : 1);
+			_candidates.clear();
+			for (RenderHandle handle : _queryHandles)
+			{
+				uint32_t index = _renderQueue.indexOf(handle);
+				_candidates.push_back({ _renderQueue.keyAt(index), index });
+			}
+			RenderQueue::radixSort(_candidates, _swap);
+		}
+		else
+			candidates = &_renderQueue.sort();
+
+		// Bounds stored as four arrays for the batch test
+		const std::vector<renderEntry>& entries = *candidates;
+		size_t count = entries.size();
+		_bounds.resize(count * 4);
+		_visibility.resize(count);
 
-		shader->setFloat("size", 1);
+		float* centerX = _bounds.data();
+		float* centerY = centerX + count;
+		float* extentX = centerY + count;
+		float* extentY = extentX + count;
 
-		GL_CALL(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0));
+		forEachChunk(pool, count, SPRITE_RECORD_GRAIN, [&](size_t, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				glm::vec2 center, extent;
+				spriteBounds(_renderQueue[entries[i].index], center, extent);
+				centerX[i] = center.x;
+				centerY[i] = center.y;
+				extentX[i] = extent.x;
+				extentY[i] = extent.y;
+			}
+
+			_frustum.intersects(centerX + begin, centerY + begin, extentX + begin, extentY + begin, end - begin, _visibility.data() + begin);
+		});
+
+		_visible.clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			if (_visibility[i])
+				_visible.push_back(entries[i]);
+		}
+		return (_visible);
+	}
+
+	void ObjectRenderer::recordChunk(const std::vector<renderEntry>& entries, size_t chunk, size_t begin, size_t end)
+	{
+		CommandBuffer& commands = _chunkCommands[chunk];
+
+		commands.clear();
+
+		// Sprites are sorted by zOrder then texture, consecutive sprites sharing the same array texture are merged in one packet
+		for (size_t i = begin; i < end; i++)
+		{
+			const sprite& s = _renderQueue[entries[i].index];
+			const animationClip* clip = s.animation.get();
+
+			_instances[i] = {
+				s.position,
+				s.scale,
+				s.angle,
+				(float)s.layer,
+				s.flip == HORIZONTAL ? -1.0f : 1.0f,
+				s.flip == VERTICAL ? -1.0f : 1.0f,
+				s.animationStart,
+				clip ? (float)clip->frameCount : 0.0f,
+				clip ? clip->frameDuration : 0.0f,
+				clip && clip->loop ? 1.0f : 0.0f
+			};
+			// The material id is the texture field of the key
+			commands.add(entries[i].key, &_materials[(entries[i].key >> 24) & 0xFFFF], (uint32_t)i, 1);
+		}
+	}
+
+	void ObjectRenderer::uploadInstances(void)
+	{
+		// Offset of the frame in the stream, in floats
+		_instanceOffset = instanceStream->push(_instances.data(), _instances.size() * sizeof(spriteInstance)) / sizeof(float);
+	}
+
+	void ObjectRenderer::forEachChunk(JobPool* pool, size_t count, size_t grain, const std::function<void(size_t chunk, size_t begin, size_t end)>& function)
+	{
+		if (pool)
+			pool->parallelFor(count, grain, function);
+		else
+		{
+			for (size_t begin = 0, chunk = 0; begin < count; begin += grain, chunk++)
+				function(chunk, begin, std::min(count, begin + grain));
+		}
+	}
+
+	void ObjectRenderer::spriteBounds(const sprite& s, glm::vec2& center, glm::vec2& extent)
+	{
+		// Bounding box of the unit quad once scaled and rotated
+		float c = std::fabs(std::cos(s.angle));
+		float n = std::fabs(std::sin(s.angle));
+		float width = std::fabs(s.scale.x) * 0.5f;
+		float height = std::fabs(s.scale.y) * 0.5f;
+
+		center = s.position;
+		extent = glm::vec2(c * width + n * height, n * width + c * height);
+	}
+
+	uint16_t ObjectRenderer::acquireMaterial(const sprite& s)
+	{
+		// Sprites batch on the pair of textures, the deque keeps the materials in place for the packets
+		std::pair<const IArrayTexture*, const IArrayTexture*> pair(s.texture.get(), s.normalMapTexture.get());
+		std::map<std::pair<const IArrayTexture*, const IArrayTexture*>, uint16_t>::iterator iterator = _materialIds.find(pair);
+		uint16_t material;
+
+		if (iterator != _materialIds.end())
+		{
+			_materialUsers[iterator->second]++;
+			return (iterator->second);
+		}
+
+		// Ids of released materials are reused, the key has no room for more
+		if (!_freeMaterials.empty())
+		{
+			material = _freeMaterials.back();
+			_freeMaterials.pop_back();
+			_materials[material] = { pair.first, pair.second };
+		}
+		else
+		{
+			if (_materials.size() >= SPRITE_MATERIAL_LIMIT)
+				throw (std::overflow_error("too many texture pairs used by sprites at once"));
+
+			material = (uint16_t)_materials.size();
+			_materials.push_back({ pair.first, pair.second });
+			_materialUsers.push_back(0);
+		}
+
+		_materialIds[pair] = material;
+		_materialUsers[material] = 1;
+		return (material);
+	}
+
+	void ObjectRenderer::releaseMaterial(uint16_t material)
+	{
+		if (--_materialUsers[material])
+			return;
+
+		// The sprites own their textures, once the last one is gone the pointers may be reused by new textures
+		_materialIds.erase(std::make_pair(_materials[material].texture, _materials[material].normalMap));
+		_freeMaterials.push_back(material);
+	}
+
+	uint64_t ObjectRenderer::makeKey(const sprite& s, uint16_t material, uint32_t depth)
+	{
+		// A single sprite program, the shader field stays 0
+		return (renderKey::make(s.zOrder, 0, material, depth));
 	}
 
+	void ObjectRenderer::prepareLighting(const std::vector<drawPacket>& packets)
+	{
+		_pLighting->upload();
+
+		// Occluders first, in the shadow mask, with the same batches
+		bool shadows = _pLighting->isShadowEnabled() && _pLighting->hasShadowCasters();
+		if (shadows)
+		{
+			_pLighting->beginShadows();
+			pShader->set(occluderUniform, 1);
+
+			for (const drawPacket& packet : packets)
+				renderBatch((const spriteMaterial*)packet.state, false, _instanceOffset, packet.first, packet.count);
+
+			pShader->set(occluderUniform, 0);
+			_pLighting->endShadows();
+		}
+
+		_pLighting->bind(2);
+		pShader->set(lightingUniform, 1);
+		pShader->set(shadowsUniform, shadows ? 1 : 0);
+		pShader->set(ambientUniform, _pLighting->getAmbient());
+		pShader->set(lightTileSizeUniform, (float)LIGHT_TILE_SIZE);
+		pShader->set(lightTilesXUniform, (int)_pLighting->getTilesX());
+		pShader->set(lightViewportUniform, _pLighting->getViewport());
+	}
+
+	void ObjectRenderer::renderBatch(const spriteMaterial* material, bool lit, unsigned long instanceOffset, size_t first, size_t count)
+	{
+		static const unsigned int instanceFloats = sizeof(spriteInstance) / sizeof(float);
+
+		material->texture->bind();
+
+		if (lit)
+		{
+			if (material->normalMap)
+				material->normalMap->bind(1);
+			pShader->set(normalMappedUniform, material->normalMap ? 1 : 0);
+		}
+
+		// No base instance in OpenGL 3.3, point the instanced attributes at the first sprite of the batch
+		instanceStream->setAttribute(2, 4, instanceFloats, instanceOffset + first * instanceFloats, 1);
+		instanceStream->setAttribute(3, 4, instanceFloats, instanceOffset + first * instanceFloats + 4, 1);
+		instanceStream->setAttribute(4, 4, instanceFloats, instanceOffset + first * instanceFloats + 8, 1);
+
+		GL_CALL(glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0, (GLsizei)count));
+		GLStateCache::Get().countDrawCall();
+	}
 
 }
\ No newline at end of file
@@ -0,0 +1,245 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define EXO_PARTICLE_SSE
+#endif
+
+#include "ParticleEmitter.h"
+
+namespace ExoEngine {
+
+	ParticleEmitter::ParticleEmitter(const std::shared_ptr<IArrayTexture>& texture, const emitterSettings& settings)
+		: _texture(texture), _settings(settings), _position(0.0f), _emitting(true), _count(0), _accumulator(0.0f),
+		_pending(0), _spawned(0), _dropped(0), _random(std::random_device()())
+	{
+		// Allocated once, a live particle never moves to another allocation
+		for (std::vector<float>* array : { &_x, &_y, &_velocityX, &_velocityY, &_age, &_inverseLife, &_angle, &_spin })
+			array->resize(_settings.capacity);
+	}
+
+	ParticleEmitter::~ParticleEmitter(void)
+	{	}
+
+	void ParticleEmitter::update(float delta, unsigned int& budget)
+	{
+		simulate(delta);
+		kill();
+
+		// The live particles use their part of the budget first
+		budget -= std::min(budget, _count);
+
+		if (_emitting)
+			_accumulator += _settings.rate * delta;
+
+		unsigned int wanted = (unsigned int)_accumulator + _pending;
+		unsigned int count = std::min(std::min(wanted, _settings.capacity - _count), budget);
+
+		_accumulator -= std::floor(_accumulator);
+		_pending = 0;
+
+		spawn(count);
+		budget -= count;
+		_spawned = count;
+		_dropped = wanted - count;
+	}
+
+	void ParticleEmitter::burst(unsigned int count)
+	{
+		_pending += count;
+	}
+
+	void ParticleEmitter::pack(float* out) const
+	{
+		unsigned int i = 0;
+
+#ifdef EXO_PARTICLE_SSE
+		// Four particles per iteration, the arrays are transposed into one vec4 per particle
+		for (; i + 4 <= _count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&_x[i]);
+			__m128 y = _mm_loadu_ps(&_y[i]);
+			__m128 life = _mm_mul_ps(_mm_loadu_ps(&_age[i]), _mm_loadu_ps(&_inverseLife[i]));
+			__m128 angle = _mm_loadu_ps(&_angle[i]);
+
+			_MM_TRANSPOSE4_PS(x, y, life, angle);
+			_mm_storeu_ps(out + i * PARTICLE_INSTANCE_SIZE, x);
+			_mm_storeu_ps(out + i * PARTICLE_INSTANCE_SIZE + 4, y);
+			_mm_storeu_ps(out + i * PARTICLE_INSTANCE_SIZE + 8, life);
+			_mm_storeu_ps(out + i * PARTICLE_INSTANCE_SIZE + 12, angle);
+		}
+#endif
+
+		for (; i < _count; i++)
+		{
+			float* instance = out + i * PARTICLE_INSTANCE_SIZE;
+			instance[0] = _x[i];
+			instance[1] = _y[i];
+			instance[2] = _age[i] * _inverseLife[i];
+			instance[3] = _angle[i];
+		}
+	}
+
+	// Getters
+	unsigned int ParticleEmitter::getCount(void) const
+	{
+		return (_count);
+	}
+
+	unsigned int ParticleEmitter::getDropped(void) const
+	{
+		return (_dropped);
+	}
+
+	unsigned int ParticleEmitter::getSpawned(void) const
+	{
+		return (_spawned);
+	}
+
+	const glm::vec2& ParticleEmitter::getPosition(void) const
+	{
+		return (_position);
+	}
+
+	const emitterSettings& ParticleEmitter::getSettings(void) const
+	{
+		return (_settings);
+	}
+
+	const std::shared_ptr<IArrayTexture>& ParticleEmitter::getTexture(void) const
+	{
+		return (_texture);
+	}
+
+	bool ParticleEmitter::isEmitting(void) const
+	{
+		return (_emitting);
+	}
+
+	// Setters
+	void ParticleEmitter::setPosition(const glm::vec2& position)
+	{
+		_position = position;
+	}
+
+	void ParticleEmitter::setEmitting(bool emitting)
+	{
+		_emitting = emitting;
+	}
+
+	void ParticleEmitter::setRate(float rate)
+	{
+		_settings.rate = rate;
+	}
+
+	// Private
+	void ParticleEmitter::simulate(float delta)
+	{
+		unsigned int i = 0;
+		float gravityX = _settings.gravity.x * delta;
+		float gravityY = _settings.gravity.y * delta;
+
+#ifdef EXO_PARTICLE_SSE
+		const __m128 dt = _mm_set1_ps(delta);
+		const __m128 gx = _mm_set1_ps(gravityX);
+		const __m128 gy = _mm_set1_ps(gravityY);
+
+		for (; i + 4 <= _count; i += 4)
+		{
+			__m128 vx = _mm_add_ps(_mm_loadu_ps(&_velocityX[i]), gx);
+			__m128 vy = _mm_add_ps(_mm_loadu_ps(&_velocityY[i]), gy);
+
+			_mm_storeu_ps(&_velocityX[i], vx);
+			_mm_storeu_ps(&_velocityY[i], vy);
+			_mm_storeu_ps(&_x[i], _mm_add_ps(_mm_loadu_ps(&_x[i]), _mm_mul_ps(vx, dt)));
+			_mm_storeu_ps(&_y[i], _mm_add_ps(_mm_loadu_ps(&_y[i]), _mm_mul_ps(vy, dt)));
+			_mm_storeu_ps(&_age[i], _mm_add_ps(_mm_loadu_ps(&_age[i]), dt));
+			_mm_storeu_ps(&_angle[i], _mm_add_ps(_mm_loadu_ps(&_angle[i]), _mm_mul_ps(_mm_loadu_ps(&_spin[i]), dt)));
+		}
+#endif
+
+		for (; i < _count; i++)
+		{
+			_velocityX[i] += gravityX;
+			_velocityY[i] += gravityY;
+			_x[i] += _velocityX[i] * delta;
+			_y[i] += _velocityY[i] * delta;
+			_age[i] += delta;
+			_angle[i] += _spin[i] * delta;
+		}
+	}
+
+	void ParticleEmitter::kill(void)
+	{
+		// The last particle moves in the hole, the order of the particles does not matter
+		for (unsigned int i = 0; i < _count;)
+		{
+			if (_age[i] * _inverseLife[i] < 1.0f)
+			{
+				i++;
+				continue;
+			}
+
+			unsigned int last = --_count;
+			_x[i] = _x[last];
+			_y[i] = _y[last];
+			_velocityX[i] = _velocityX[last];
+			_velocityY[i] = _velocityY[last];
+			_age[i] = _age[last];
+			_inverseLife[i] = _inverseLife[last];
+			_angle[i] = _angle[last];
+			_spin[i] = _spin[last];
+		}
+	}
+
+	void ParticleEmitter::spawn(unsigned int count)
+	{
+		for (unsigned int k = 0; k < count; k++)
+		{
+			unsigned int i = _count++;
+			float direction = random(_settings.direction);
+			float speed = random(_settings.speed);
+
+			_x[i] = _position.x;
+			_y[i] = _position.y;
+			_velocityX[i] = std::cos(direction) * speed;
+			_velocityY[i] = std::sin(direction) * speed;
+			_age[i] = 0.0f;
+			_inverseLife[i] = 1.0f / std::max(random(_settings.lifetime), 0.001f);
+			_angle[i] = 0.0f;
+			_spin[i] = random(_settings.spin);
+		}
+	}
+
+	float ParticleEmitter::random(const glm::vec2& range)
+	{
+		float t = (float)(_random() - _random.min()) / (float)(_random.max() - _random.min());
+		return (range.x + (range.y - range.x) * t);
+	}
+
+}
\ No newline at end of file
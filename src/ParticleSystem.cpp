@@ -0,0 +1,145 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "ParticleSystem.h"
+#include "GLStateCache.h"
+
+namespace ExoEngine {
+
+	Shader* ParticleSystem::pShader = nullptr;
+	Buffer* ParticleSystem::vaoBuffer = nullptr;
+	Buffer* ParticleSystem::vertexBuffer = nullptr;
+	StreamBuffer* ParticleSystem::instanceStream = nullptr;
+
+	ParticleSystem::ParticleSystem(void)
+		: _budget(PARTICLE_DEFAULT_BUDGET), _stats({ 0, 0, 0, 0, 0, 0.0 })
+	{	}
+
+	ParticleSystem::~ParticleSystem(void)
+	{	}
+
+	void ParticleSystem::add(ParticleEmitter* emitter)
+	{
+		if (std::find(_emitters.begin(), _emitters.end(), emitter) == _emitters.end())
+			_emitters.push_back(emitter);
+	}
+
+	void ParticleSystem::remove(ParticleEmitter* emitter)
+	{
+		_emitters.erase(std::remove(_emitters.begin(), _emitters.end(), emitter), _emitters.end());
+	}
+
+	void ParticleSystem::update(double delta)
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		unsigned int budget = _budget;
+		unsigned int total = 0;
+
+		_stats = { (unsigned int)_emitters.size(), 0, 0, 0, 0, 0.0 };
+
+		// The emitters are served in the order they were added, the last ones starve when the budget is spent
+		_offsets.resize(_emitters.size());
+		for (size_t i = 0; i < _emitters.size(); i++)
+		{
+			ParticleEmitter* emitter = _emitters[i];
+
+			emitter->update((float)(delta / 1000.0), budget);
+			_offsets[i] = total;
+			total += emitter->getCount();
+
+			_stats.spawned += emitter->getSpawned();
+			_stats.dropped += emitter->getDropped();
+		}
+		_stats.alive = total;
+
+		// Packed back to back, one upload for the frame
+		_instances.resize((size_t)total * PARTICLE_INSTANCE_SIZE);
+		for (size_t i = 0; i < _emitters.size(); i++)
+			_emitters[i]->pack(_instances.data() + (size_t)_offsets[i] * PARTICLE_INSTANCE_SIZE);
+
+		_stats.updateTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void ParticleSystem::render(UniformRing* ring)
+	{
+		GLStateCache& stateCache = GLStateCache::Get();
+
+		if (_instances.empty())
+			return;
+
+		unsigned long offset = instanceStream->push(_instances.data(), _instances.size() * sizeof(float)) / sizeof(float);
+
+		pShader->bind();
+		vaoBuffer->bind();
+		stateCache.setBlend(true);
+
+		for (size_t i = 0; i < _emitters.size(); i++)
+		{
+			const ParticleEmitter* emitter = _emitters[i];
+			const emitterSettings& settings = emitter->getSettings();
+
+			if (emitter->getCount() == 0)
+				continue;
+
+			stateCache.setBlendFunc(GL_SRC_ALPHA, settings.additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+			emitter->getTexture()->bind();
+
+			emitterUniforms uniforms;
+			uniforms.startColor = settings.startColor;
+			uniforms.endColor = settings.endColor;
+			uniforms.scale = settings.scale;
+			uniforms.frames = glm::vec2((float)settings.firstFrame, (float)settings.frameCount);
+			ring->push(EMITTER_UNIFORM_BINDING, &uniforms, sizeof(uniforms));
+
+			// No base instance in OpenGL 3.3, the attribute points at the first particle of the emitter
+			instanceStream->setAttribute(2, 4, PARTICLE_INSTANCE_SIZE, offset + (unsigned long)_offsets[i] * PARTICLE_INSTANCE_SIZE, 1);
+			GL_CALL(glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0, (GLsizei)emitter->getCount()));
+			GLStateCache::Get().countDrawCall();
+			_stats.drawCalls++;
+		}
+
+		stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	// Setters
+	void ParticleSystem::setBudget(unsigned int budget)
+	{
+		_budget = budget;
+	}
+
+	// Getters
+	unsigned int ParticleSystem::getBudget(void) const
+	{
+		return (_budget);
+	}
+
+	const particleStats& ParticleSystem::getStats(void) const
+	{
+		return (_stats);
+	}
+
+}
\ No newline at end of file
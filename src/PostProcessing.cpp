@@ -0,0 +1,440 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "PostProcessing.h"
+#include "GLStateCache.h"
+
+namespace ExoEngine {
+
+#ifndef USE_TEST_SHADERS
+
+	static const std::vector<std::string>	g_defaultShader = {
+		"#version 330 core",
+		"layout(location = 0) in vec3 position;",
+		"layout(location = 1) in vec2 texCoord;",
+		"",
+		"uniform vec2 uvScale;",
+		"",
+		"out vec2 TexCoords;",
+		"",
+		"void main(void) ",
+		"{",
+		"	gl_Position = vec4(position.x, position.y, 0.0, 1.0);",
+		"	TexCoords = texCoord * uvScale;",
+		"}",
+		"",
+		"#FRAGMENT",
+		"#version 330 core",
+		"",
+		"uniform sampler2D screenTexture;",
+		"",
+		"in vec2 TexCoords;",
+		"out vec4 color;",
+		"",
+		"void main(void) ",
+		"{",
+		"	color = texture(screenTexture, TexCoords);",
+		"}"
+	};
+
+#endif
+
+	PostProcessing::PostProcessing(void)
+		: _width(0), _height(0), _scale(1.0f), _frameTimeTarget(0.0), _averageFrameTime(0.0), _framesSinceChange(0),
+		_pSceneFrameBuffer(nullptr), _pSceneTexture(nullptr), _pPingPongFrameBuffers{ nullptr, nullptr }, _pPingPongTextures{ nullptr, nullptr },
+		_offscreen(false), _pOutputFrameBuffer(nullptr), _pOutputTexture(nullptr)
+	{
+		_copyPass.pShader = nullptr;
+		_copyPass.enabled = true;
+	}
+
+	PostProcessing::~PostProcessing(void)
+	{
+		release();
+	}
+
+	void PostProcessing::release(void)
+	{
+		destroyTargets();
+
+		for (postProcessPass& pass : _passes)
+			delete pass.pShader;
+		_passes.clear();
+
+		if (_copyPass.pShader)
+			delete _copyPass.pShader;
+		_copyPass.pShader = nullptr;
+	}
+
+	void PostProcessing::initialize(int width, int height)
+	{
+		// Full screen quad and copy pass, once
+		if (!_copyPass.pShader)
+		{
+			const static float vertices[] = {
+				-1.0f,	1.0f, 0.0f,
+				-1.0f, -1.0f, 0.0f,
+				1.0f, -1.0f, 0.0f,
+
+				-1.0f,	1.0f, 0.0f,
+				1.0f, -1.0f, 0.0f,
+				1.0f,	1.0f, 0.0f
+			};
+			const static float uvs[] = {
+				0.0f, 1.0f,
+				0.0f, 0.0f,
+				1.0f, 0.0f,
+
+				0.0f, 1.0f,
+				1.0f, 0.0f,
+				1.0f, 1.0f
+			};
+
+			_vertexArrayObject.initialize(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+			_arrayBuffer.initialize(18, 3, &vertices, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
+			_uvMappingBuffer.initialize(12, 2, &uvs, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 1, true);
+
+#ifdef USE_TEST_SHADERS
+			_copyPass.pShader = new Shader("resources/shaders/OpenGL3/post-processing/default.glsl");
+#else
+			_copyPass.pShader = new Shader(g_defaultShader);
+#endif
+			_copyPass.name = "default";
+			_copyPass.uvScaleUniform = _copyPass.pShader->getUniform<glm::vec2>("uvScale");
+			_copyPass.texelSizeUniform = _copyPass.pShader->getUniform<glm::vec2>("texelSize");
+		}
+
+		destroyTargets();
+
+		_width = width;
+		_height = height;
+
+		createTarget(_pSceneFrameBuffer, _pSceneTexture);
+		if (_offscreen)
+			createTarget(_pOutputFrameBuffer, _pOutputTexture);
+
+		// The targets of the passes only exist if there is a chain
+		if (!_passes.empty())
+		{
+			createTarget(_pPingPongFrameBuffers[0], _pPingPongTextures[0]);
+			createTarget(_pPingPongFrameBuffers[1], _pPingPongTextures[1]);
+		}
+	}
+
+	void PostProcessing::begin(void)
+	{
+		_pSceneFrameBuffer->clear();
+		GL_CALL(glViewport(0, 0, getRenderWidth(), getRenderHeight()));
+	}
+
+	void PostProcessing::apply(void)
+	{
+		Texture* input = _pSceneTexture;
+		const postProcessPass* last = &_copyPass;
+		unsigned int target = 0;
+
+		GLStateCache::Get().setBlend(false);
+		_vertexArrayObject.bind();
+
+		// The last enabled pass writes the screen, the others ping-pong at the render resolution
+		for (const postProcessPass& pass : _passes)
+		{
+			if (!pass.enabled)
+				continue;
+
+			if (last != &_copyPass)
+			{
+				_pPingPongFrameBuffers[target]->bind();
+				GL_CALL(glViewport(0, 0, getRenderWidth(), getRenderHeight()));
+				drawPass(*last, input);
+
+				input = _pPingPongTextures[target];
+				target ^= 1;
+			}
+			last = &pass;
+		}
+
+		// Covers the whole screen, no need to clear it
+		if (_pOutputFrameBuffer)
+		{
+			_pOutputFrameBuffer->bind();
+		}
+		else
+		{
+			_pSceneFrameBuffer->unbind();
+		}
+		GL_CALL(glViewport(0, 0, _width, _height));
+		drawPass(*last, input);
+	}
+
+	void PostProcessing::readPixels(std::vector<uint8_t>& pixels) const
+	{
+		const size_t pitch = (size_t)_width * 4;
+
+		pixels.resize(pitch * _height);
+		if (pixels.empty())
+			return;
+
+		// Onscreen, the back buffer is undefined once swapped: read what is displayed
+		if (_pOutputFrameBuffer)
+		{
+			_pOutputFrameBuffer->bind();
+		}
+		else
+		{
+			_pSceneFrameBuffer->unbind();
+			GL_CALL(glReadBuffer(GL_FRONT));
+		}
+
+		GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+		GL_CALL(glReadPixels(0, 0, _width, _height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+
+		if (_pOutputFrameBuffer)
+		{
+			_pOutputFrameBuffer->unbind();
+		}
+		else
+		{
+			GL_CALL(glReadBuffer(GL_BACK));
+		}
+
+		// GL rows go from the bottom up
+		std::vector<uint8_t> row(pitch);
+		for (int y = 0; y < _height / 2; y++)
+		{
+			uint8_t* top = pixels.data() + pitch * y;
+			uint8_t* bottom = pixels.data() + pitch * (_height - 1 - y);
+
+			std::copy(top, top + pitch, row.begin());
+			std::copy(bottom, bottom + pitch, top);
+			std::copy(row.begin(), row.end(), bottom);
+		}
+	}
+
+	// Passes
+	void PostProcessing::addPass(const std::string& name, Shader* shader)
+	{
+		postProcessPass pass;
+
+		pass.name = name;
+		pass.pShader = shader;
+		pass.uvScaleUniform = shader->getUniform<glm::vec2>("uvScale");
+		pass.texelSizeUniform = shader->getUniform<glm::vec2>("texelSize");
+		pass.enabled = true;
+		_passes.push_back(pass);
+
+		// First pass: the chain now needs its targets
+		if (_passes.size() == 1 && _width > 0)
+		{
+			createTarget(_pPingPongFrameBuffers[0], _pPingPongTextures[0]);
+			createTarget(_pPingPongFrameBuffers[1], _pPingPongTextures[1]);
+		}
+	}
+
+	void PostProcessing::removePass(const std::string& name)
+	{
+		auto it = std::find_if(_passes.begin(), _passes.end(), [&name](const postProcessPass& pass) {
+			return (pass.name == name);
+		});
+
+		if (it != _passes.end())
+		{
+			delete it->pShader;
+			_passes.erase(it);
+		}
+	}
+
+	void PostProcessing::setPassEnabled(const std::string& name, bool enabled)
+	{
+		postProcessPass* pass = findPass(name);
+
+		if (pass)
+			pass->enabled = enabled;
+	}
+
+	bool PostProcessing::isPassEnabled(const std::string& name) const
+	{
+		for (const postProcessPass& pass : _passes)
+			if (pass.name == name)
+				return (pass.enabled);
+		return (false);
+	}
+
+	void PostProcessing::update(double frameTime)
+	{
+		float scale = _scale;
+
+		// Stalls (first frame, loading) say nothing about the rendering cost
+		if (_frameTimeTarget <= 0.0 || frameTime <= 0.0 || frameTime > 1000.0)
+			return;
+
+		// Smoothed, a single slow frame doesn't change the resolution
+		_averageFrameTime += (frameTime - _averageFrameTime) * 0.1;
+
+		if (++_framesSinceChange < DYNAMIC_RESOLUTION_DELAY)
+			return;
+
+		if (_averageFrameTime > _frameTimeTarget * 1.05)
+			scale -= DYNAMIC_RESOLUTION_STEP;
+		else if (_averageFrameTime < _frameTimeTarget * 0.85)
+			scale += DYNAMIC_RESOLUTION_STEP;
+
+		setResolutionScale(scale);
+	}
+
+	// Setters
+	void PostProcessing::setResolutionScale(float scale)
+	{
+		scale = std::min(std::max(scale, DYNAMIC_RESOLUTION_MIN), 1.0f);
+
+		// The targets keep their size, only the viewport changes
+		if (scale != _scale)
+		{
+			_scale = scale;
+			_framesSinceChange = 0;
+		}
+	}
+
+	void PostProcessing::setFrameTimeTarget(double frameTime)
+	{
+		_frameTimeTarget = frameTime;
+		_averageFrameTime = frameTime;
+		_framesSinceChange = 0;
+	}
+
+	void PostProcessing::setOffscreen(bool offscreen)
+	{
+		_offscreen = offscreen;
+
+		// Already initialized: the output target follows right away
+		if (_offscreen && !_pOutputFrameBuffer && _width > 0)
+			createTarget(_pOutputFrameBuffer, _pOutputTexture);
+		else if (!_offscreen && _pOutputFrameBuffer)
+		{
+			delete _pOutputFrameBuffer;
+			delete _pOutputTexture;
+			_pOutputFrameBuffer = nullptr;
+			_pOutputTexture = nullptr;
+		}
+	}
+
+	// Getters
+	float PostProcessing::getResolutionScale(void) const
+	{
+		return (_scale);
+	}
+
+	double PostProcessing::getFrameTimeTarget(void) const
+	{
+		return (_frameTimeTarget);
+	}
+
+	int PostProcessing::getRenderWidth(void) const
+	{
+		return ((int)std::lround(_width * _scale));
+	}
+
+	int PostProcessing::getRenderHeight(void) const
+	{
+		return ((int)std::lround(_height * _scale));
+	}
+
+	FrameBuffer* PostProcessing::getSceneFrameBuffer(void) const
+	{
+		return (_pSceneFrameBuffer);
+	}
+
+	Texture* PostProcessing::getSceneTexture(void) const
+	{
+		return (_pSceneTexture);
+	}
+
+	FrameBuffer* PostProcessing::getOutputFrameBuffer(void) const
+	{
+		return (_pOutputFrameBuffer);
+	}
+
+	bool PostProcessing::isOffscreen(void) const
+	{
+		return (_offscreen);
+	}
+
+	// Private
+	void PostProcessing::createTarget(FrameBuffer*& frameBuffer, Texture*& texture)
+	{
+		// Linear: the last pass upscales when the resolution is lowered
+		texture = new Texture(_width, _height, RGBA, LINEAR);
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		frameBuffer = new FrameBuffer();
+		frameBuffer->attach(texture);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			throw ("Error::FRAMEBUFFER:: Framebuffer is not complete!");
+
+		frameBuffer->unbind();
+	}
+
+	void PostProcessing::destroyTargets(void)
+	{
+		FrameBuffer** frameBuffers[] = { &_pSceneFrameBuffer, &_pPingPongFrameBuffers[0], &_pPingPongFrameBuffers[1], &_pOutputFrameBuffer };
+		Texture** textures[] = { &_pSceneTexture, &_pPingPongTextures[0], &_pPingPongTextures[1], &_pOutputTexture };
+
+		for (int i = 0; i < 4; i++)
+		{
+			if (*frameBuffers[i])
+				delete *frameBuffers[i];
+			if (*textures[i])
+				delete *textures[i];
+
+			*frameBuffers[i] = nullptr;
+			*textures[i] = nullptr;
+		}
+	}
+
+	void PostProcessing::drawPass(const postProcessPass& pass, Texture* input)
+	{
+		pass.pShader->bind();
+		pass.pShader->set(pass.uvScaleUniform, glm::vec2((float)getRenderWidth() / _width, (float)getRenderHeight() / _height));
+		pass.pShader->set(pass.texelSizeUniform, glm::vec2(1.0f / _width, 1.0f / _height));
+
+		input->bind();
+
+		GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 6));
+		GLStateCache::Get().countDrawCall();
+	}
+
+	postProcessPass* PostProcessing::findPass(const std::string& name)
+	{
+		for (postProcessPass& pass : _passes)
+			if (pass.name == name)
+				return (&pass);
+		return (nullptr);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace ExoEngine {
+
+	static const struct { const char* name; bool gpu; } g_profileStages[PROFILE_STAGE_COUNT] = {
+		{ "mouse picker", true },
+		{ "record", false },		// Jobs on the workers, no GL
+		{ "tile maps", true },
+		{ "objects", true },
+		{ "particles", true },
+		{ "axis", true },
+		{ "gui", true },
+		{ "text", true },
+		{ "post processing", true }
+	};
+
+	Profiler::Profiler(void)
+		: _cpuIndex(0), _cpuCount(0), _gpuIndex(0), _gpuCount(0), _frame(0), _gpuTimers(false), _gpuSupported(false)
+	{
+		std::memset(_cpu, 0, sizeof(_cpu));
+		std::memset(_gpu, 0, sizeof(_gpu));
+		std::memset(_current, 0, sizeof(_current));
+		std::memset(_queries, 0, sizeof(_queries));
+		std::memset(_pending, 0, sizeof(_pending));
+	}
+
+	Profiler::~Profiler(void)
+	{
+		if (_queries[0][0])
+			glDeleteQueries(PROFILER_QUERY_FRAMES * PROFILE_STAGE_COUNT, &_queries[0][0]);
+	}
+
+	void Profiler::beginFrame(void)
+	{
+		std::memset(_current, 0, sizeof(_current));
+
+		// The queries of this slot were issued PROFILER_QUERY_FRAMES frames ago
+		if (_gpuTimers)
+			collect(_frame % PROFILER_QUERY_FRAMES);
+	}
+
+	void Profiler::endFrame(void)
+	{
+		std::memcpy(_cpu[_cpuIndex], _current, sizeof(_current));
+		_cpuIndex = (_cpuIndex + 1) % PROFILER_HISTORY;
+		_cpuCount = std::min(_cpuCount + 1, (unsigned int)PROFILER_HISTORY);
+		_frame++;
+	}
+
+	void Profiler::begin(ProfileStage stage)
+	{
+		_starts[stage] = std::chrono::high_resolution_clock::now();
+
+		if (_gpuTimers && g_profileStages[stage].gpu)
+		{
+			GL_CALL(glBeginQuery(GL_TIME_ELAPSED, _queries[_frame % PROFILER_QUERY_FRAMES][stage]));
+		}
+	}
+
+	void Profiler::end(ProfileStage stage)
+	{
+		if (_gpuTimers && g_profileStages[stage].gpu)
+		{
+			GL_CALL(glEndQuery(GL_TIME_ELAPSED));
+			_pending[_frame % PROFILER_QUERY_FRAMES][stage] = true;
+		}
+
+		_current[stage] += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _starts[stage]).count();
+	}
+
+	// Setters
+	void Profiler::setGpuTimers(bool enabled)
+	{
+		// Needs the context, asked the first time
+		if (enabled && !_queries[0][0])
+		{
+#ifdef __APPLE__
+			_gpuSupported = true;
+#else
+			_gpuSupported = GLEW_ARB_timer_query;
+#endif
+			if (_gpuSupported)
+			{
+				GL_CALL(glGenQueries(PROFILER_QUERY_FRAMES * PROFILE_STAGE_COUNT, &_queries[0][0]));
+			}
+		}
+
+		// Results left in flight are dropped
+		if (!enabled)
+			std::memset(_pending, 0, sizeof(_pending));
+
+		_gpuTimers = enabled && _gpuSupported;
+	}
+
+	// Getters
+	bool Profiler::hasGpuTimers(void) const
+	{
+		return (_gpuTimers);
+	}
+
+	unsigned long Profiler::getFrameCount(void) const
+	{
+		return (_frame);
+	}
+
+	double Profiler::getCpuTime(ProfileStage stage) const
+	{
+		return (_cpuCount ? _cpu[(_cpuIndex + PROFILER_HISTORY - 1) % PROFILER_HISTORY][stage] : 0.0);
+	}
+
+	double Profiler::getGpuTime(ProfileStage stage) const
+	{
+		return (_gpuCount ? _gpu[(_gpuIndex + PROFILER_HISTORY - 1) % PROFILER_HISTORY][stage] : 0.0);
+	}
+
+	profileStats Profiler::getCpuStats(ProfileStage stage) const
+	{
+		return (computeStats(_cpu, _cpuCount, stage));
+	}
+
+	profileStats Profiler::getGpuStats(ProfileStage stage) const
+	{
+		return (computeStats(_gpu, _gpuCount, stage));
+	}
+
+	std::string Profiler::getReport(void) const
+	{
+		std::string report = "stage            cpu avg / p99     gpu avg / p99 (ms)\n";
+		char line[128];
+
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+		{
+			profileStats cpu = getCpuStats((ProfileStage)stage);
+			profileStats gpu = getGpuStats((ProfileStage)stage);
+
+			if (_gpuTimers && g_profileStages[stage].gpu)
+				std::snprintf(line, sizeof(line), "%-16s %6.3f / %6.3f   %6.3f / %6.3f\n", g_profileStages[stage].name, cpu.average, cpu.p99, gpu.average, gpu.p99);
+			else
+				std::snprintf(line, sizeof(line), "%-16s %6.3f / %6.3f        - / -\n", g_profileStages[stage].name, cpu.average, cpu.p99);
+			report += line;
+		}
+		return (report);
+	}
+
+	const char* Profiler::getStageName(ProfileStage stage)
+	{
+		return (g_profileStages[stage].name);
+	}
+
+	// Private
+	void Profiler::collect(unsigned int slot)
+	{
+		bool issued = false;
+
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+			issued |= _pending[slot][stage];
+		if (!issued)
+			return;
+
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+		{
+			GLuint64 elapsed = 0;
+
+			if (_pending[slot][stage])
+			{
+				GL_CALL(glGetQueryObjectui64v(_queries[slot][stage], GL_QUERY_RESULT, &elapsed));
+			}
+			_gpu[_gpuIndex][stage] = (double)elapsed / 1000000.0;
+			_pending[slot][stage] = false;
+		}
+
+		_gpuIndex = (_gpuIndex + 1) % PROFILER_HISTORY;
+		_gpuCount = std::min(_gpuCount + 1, (unsigned int)PROFILER_HISTORY);
+	}
+
+	profileStats Profiler::computeStats(const double (*history)[PROFILE_STAGE_COUNT], unsigned int count, ProfileStage stage)
+	{
+		profileStats stats = { 0.0, 0.0, 0.0 };
+		std::vector<double> values(count);
+
+		if (!count)
+			return (stats);
+
+		// The order of the rows does not matter
+		for (unsigned int i = 0; i < count; i++)
+			values[i] = history[i][stage];
+
+		std::nth_element(values.begin(), values.begin() + (count - 1) * 99 / 100, values.end());
+		stats.p99 = values[(count - 1) * 99 / 100];
+		stats.min = *std::min_element(values.begin(), values.end());
+		for (double value : values)
+			stats.average += value;
+		stats.average /= count;
+		return (stats);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "RenderQueue.h"
+
+namespace ExoEngine {
+
+	RenderQueue::RenderQueue(void)
+		: _dirty(false)
+	{	}
+
+	RenderQueue::~RenderQueue(void)
+	{	}
+
+	RenderHandle RenderQueue::add(const sprite& s, uint64_t key)
+	{
+		RenderHandle handle;
+		uint32_t index = (uint32_t)_sprites.size();
+
+		if (!_freeHandles.empty())
+		{
+			handle = _freeHandles.back();
+			_freeHandles.pop_back();
+			_handleToIndex[handle] = index;
+		}
+		else
+		{
+			handle = (RenderHandle)_handleToIndex.size();
+			_handleToIndex.push_back(index);
+		}
+
+		_sprites.push_back(s);
+		_keys.push_back(key);
+		_indexToHandle.push_back(handle);
+		_dirty = true;
+
+		return (handle);
+	}
+
+	void RenderQueue::update(RenderHandle handle, const sprite& s, uint64_t key)
+	{
+		if (!contains(handle))
+			throw (std::out_of_range("Invalid render handle"));
+
+		uint32_t index = _handleToIndex[handle];
+		_sprites[index] = s;
+		if (_keys[index] != key)
+		{
+			_keys[index] = key;
+			_dirty = true;
+		}
+	}
+
+	void RenderQueue::remove(RenderHandle handle)
+	{
+		if (!contains(handle))
+			return;
+
+		// Move the last sprite in the hole to keep the storage packed
+		uint32_t index = _handleToIndex[handle];
+		uint32_t last = (uint32_t)_sprites.size() - 1;
+
+		if (index != last)
+		{
+			_sprites[index] = _sprites[last];
+			_keys[index] = _keys[last];
+			_indexToHandle[index] = _indexToHandle[last];
+			_handleToIndex[_indexToHandle[index]] = index;
+		}
+
+		_sprites.pop_back();
+		_keys.pop_back();
+		_indexToHandle.pop_back();
+
+		_handleToIndex[handle] = INVALID_RENDER_HANDLE;
+		_freeHandles.push_back(handle);
+		_dirty = true;
+	}
+
+	void RenderQueue::clear(void)
+	{
+		_sprites.clear();
+		_keys.clear();
+		_indexToHandle.clear();
+		_handleToIndex.clear();
+		_freeHandles.clear();
+		_entries.clear();
+		_dirty = false;
+	}
+
+	const std::vector<renderEntry>& RenderQueue::sort(void)
+	{
+		if (!_dirty)
+			return (_entries);
+
+		_entries.resize(_keys.size());
+		for (uint32_t i = 0; i < _keys.size(); i++)
+			_entries[i] = { _keys[i], i };
+
+		radixSort(_entries, _swap);
+		_dirty = false;
+
+		return (_entries);
+	}
+
+	void RenderQueue::radixSort(std::vector<renderEntry>& entries, std::vector<renderEntry>& swap)
+	{
+		size_t count[8][256];
+		size_t n = entries.size();
+
+		if (n < 2)
+			return;
+
+		// One pass to build the histograms of the 8 bytes
+		std::memset(count, 0, sizeof(count));
+		for (const renderEntry& entry : entries)
+		{
+			for (unsigned int byte = 0; byte < 8; byte++)
+				count[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+		}
+
+		swap.resize(n);
+		renderEntry* src = entries.data();
+		renderEntry* dst = swap.data();
+
+		// LSD passes, stable, a byte identical for every key is skipped
+		for (unsigned int byte = 0; byte < 8; byte++)
+		{
+			size_t* histogram = count[byte];
+			if (histogram[(src[0].key >> (byte * 8)) & 0xFF] == n)
+				continue;
+
+			size_t offset = 0;
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				size_t tmp = histogram[i];
+				histogram[i] = offset;
+				offset += tmp;
+			}
+
+			for (size_t i = 0; i < n; i++)
+				dst[histogram[(src[i].key >> (byte * 8)) & 0xFF]++] = src[i];
+
+			std::swap(src, dst);
+		}
+
+		if (src != entries.data())
+			std::memcpy(entries.data(), src, n * sizeof(renderEntry));
+	}
+
+	// Getters
+	bool RenderQueue::contains(RenderHandle handle) const
+	{
+		return (handle < _handleToIndex.size() && _handleToIndex[handle] != INVALID_RENDER_HANDLE);
+	}
+
+	size_t RenderQueue::size(void) const
+	{
+		return (_sprites.size());
+	}
+
+	bool RenderQueue::empty(void) const
+	{
+		return (_sprites.empty());
+	}
+
+	uint32_t RenderQueue::indexOf(RenderHandle handle) const
+	{
+		return (_handleToIndex[handle]);
+	}
+
+	RenderHandle RenderQueue::handleAt(uint32_t index) const
+	{
+		return (_indexToHandle[index]);
+	}
+
+	uint64_t RenderQueue::keyAt(uint32_t index) const
+	{
+		return (_keys[index]);
+	}
+
+	const sprite& RenderQueue::operator[](uint32_t index) const
+	{
+		return (_sprites[index]);
+	}
+
+}
\ No newline at end of file
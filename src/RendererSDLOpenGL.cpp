@@ -24,6 +24,9 @@
 
 #include "RendererSDLOpenGL.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 namespace ExoEngine {
 
@@ -35,7 +38,32 @@ namespace ExoEngine {
 		if (_pWindow)
 			delete _pWindow;
 
-		_pWindow = new Window(title, width, height, mode, resizable);
+		// Program binaries of the previous runs, the window already builds its post-processing program
+		char* cachePath = SDL_GetPrefPath("ExoEngine", "ShaderCache");
+		if (cachePath)
+		{
+			ShaderCache::Get().setDirectory(cachePath);
+			SDL_free(cachePath);
+		}
+
+		// Cooked textures (mip chains, compressed when enabled)
+		if ((cachePath = SDL_GetPrefPath("ExoEngine", "TextureCache")))
+		{
+			TextureCache::Get().setDirectory(cachePath);
+			SDL_free(cachePath);
+		}
+
+		// Headless: offscreen EGL context, no display needed
+		if (mode == WindowMode::HEADLESS)
+		{
+#ifdef EXO_HEADLESS
+			_pWindow = new HeadlessWindow(width, height);
+#else
+			throw (std::runtime_error("headless rendering needs EGL, ExoEngine was built without it"));
+#endif
+		}
+		else
+			_pWindow = new Window(title, width, height, mode, resizable);
 		resize();
 
 		// Shaders
@@ -46,8 +74,15 @@ namespace ExoEngine {
 
 		// Renderers
 		_pObjectRenderer = new ObjectRenderer();
-		_pGUIRenderer = new GUIRenderer();
+		_pGUIRenderer = new GUIRenderer(this);
 		_pTextRenderer = new TextRenderer();
+		_pLighting = new Lighting();
+		_pParticleSystem = new ParticleSystem();
+		_pProfiler = new Profiler();
+
+		// Workers recording the frame
+		if (!_pJobPool)
+			_pJobPool = new JobPool();
 	}
 
 	void RendererSDLOpenGL::resize()
@@ -61,61 +96,36 @@ namespace ExoEngine {
 	// Create
 	ICamera* RendererSDLOpenGL::createCamera(void)
 	{
-		return new Camera();
+		return new Camera(_pWindow);
 	}
 
 	ITexture* RendererSDLOpenGL::createTexture(const std::string& filePath, TextureFilter filter)
 	{
-		ITexture* texture;
-		GLsync		fenceId;
-
+		// Worker threads upload on their shared context, the texture fences the upload and reports with isReady()
 		if (std::this_thread::get_id() != _mainThread)
-		{
 			_pWindow->handleThread();
-			texture = new Texture(filePath, filter);
-			fenceId = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-			while (glClientWaitSync(fenceId, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000)) == GL_TIMEOUT_EXPIRED)
-				;
-			return (texture);
-		}
-		else
-			return (new Texture(filePath, filter));
+		return (new Texture(filePath, filter));
 	}
 
 	ITexture* RendererSDLOpenGL::createTexture(unsigned int width, unsigned int height, TextureFormat format, TextureFilter filter)
 	{
-		ITexture* texture;
-		GLsync		fenceId;
-
 		if (std::this_thread::get_id() != _mainThread)
-		{
 			_pWindow->handleThread();
-			texture = new Texture(width, height, format, filter);
-			fenceId = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-			while (glClientWaitSync(fenceId, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000)) == GL_TIMEOUT_EXPIRED)
-				;
-			return (texture);
-		}
-		else
-			return (new Texture(width, height, format, filter));
+		return (new Texture(width, height, format, filter));
 	}
 
 	IArrayTexture* RendererSDLOpenGL::createArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
 	{
-		ArrayTexture* texture;
-		GLsync			fenceId;
+		if (std::this_thread::get_id() != _mainThread)
+			_pWindow->handleThread();
+		return (new ArrayTexture(width, height, textures, filter));
+	}
 
+	ITextureAtlas* RendererSDLOpenGL::createTextureAtlas(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+	{
 		if (std::this_thread::get_id() != _mainThread)
-		{
 			_pWindow->handleThread();
-			texture = new ArrayTexture(width, height, textures, filter);
-			fenceId = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-			while (glClientWaitSync(fenceId, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000)) == GL_TIMEOUT_EXPIRED)
-				;
-			return (new ArrayTexture(width, height, textures, filter));
-		}
-		else
-			return (new ArrayTexture(width, height, textures, filter));
+		return (new TextureAtlas(width, height, textures, filter));
 	}
 
 	IImage* RendererSDLOpenGL::createImage(const std::shared_ptr<ITexture>& texture)
@@ -142,9 +152,9 @@ namespace ExoEngine {
 	}
 
 	// Push
-	void RendererSDLOpenGL::add(sprite& s)
+	RenderHandle RendererSDLOpenGL::add(sprite& s)
 	{
-		_pObjectRenderer->add(s);
+		return (_pObjectRenderer->add(s));
 	}
 
 	void RendererSDLOpenGL::add(IWidget* widget)
@@ -188,6 +198,26 @@ namespace ExoEngine {
 		_pTextRenderer->add(label);
 	}
 
+	void RendererSDLOpenGL::add(TileMap* tileMap)
+	{
+		_tileMaps.push_back(tileMap);
+	}
+
+	void RendererSDLOpenGL::add(ParticleEmitter* emitter)
+	{
+		_pParticleSystem->add(emitter);
+	}
+
+	void RendererSDLOpenGL::update(RenderHandle handle, const sprite& s)
+	{
+		_pObjectRenderer->update(handle, s);
+	}
+
+	void RendererSDLOpenGL::remove(RenderHandle handle)
+	{
+		_pObjectRenderer->remove(handle);
+	}
+
 	void RendererSDLOpenGL::remove(sprite& s)
 	{
 		_pObjectRenderer->remove(s);
@@ -224,27 +254,100 @@ namespace ExoEngine {
 		_pTextRenderer->remove(label);
 	}
 
+	void RendererSDLOpenGL::remove(TileMap* tileMap)
+	{
+		_tileMaps.erase(std::remove(_tileMaps.begin(), _tileMaps.end(), tileMap), _tileMaps.end());
+	}
+
+	void RendererSDLOpenGL::remove(ParticleEmitter* emitter)
+	{
+		_pParticleSystem->remove(emitter);
+	}
+
 	void RendererSDLOpenGL::draw(void)
 	{		
-		GL_CALL(glEnable(GL_BLEND));
-		GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLStateCache& stateCache = GLStateCache::Get();
 
-		// Renderers
+		// Counters of the previous frame
+		_stateCounters = stateCache.getCounters();
+		stateCache.resetCounters();
+
+		_pProfiler->beginFrame();
+
+		// Text of the previous frames, before the labels are recorded
+		if (_pProfilerOverlay && _pProfiler->getFrameCount() % PROFILER_OVERLAY_INTERVAL == 0)
+			_pProfilerOverlay->setText(_pProfiler->getReport());
+
+		stateCache.setBlend(true);
+		stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		// Frame uniforms, uploaded once for every renderer
+		_frameUniforms.projection = _perspective;
+		_frameUniforms.view = _pCurrentCamera ? ((Camera*)_pCurrentCamera)->getLookAt() : glm::mat4(1.0f);
+		_frameUniforms.orthographic = _orthographic;
+		_frameUniforms.time = glm::vec4(getTime() / 1000.0f, 0.0f, 0.0f, 0.0f);
+		_pFrameUniformBuffer->updateSubData(sizeof(frameUniforms) / sizeof(float), &_frameUniforms);
+		_pFrameUniformBuffer->bindBase(FRAME_UNIFORM_BINDING);
+		stateCache.countUniformUpload();
+
+		if (_pCurrentCamera && _pMousePicker)
+		{
+			ProfileScope scope(_pProfiler, PROFILE_MOUSE_PICKER);
+			_pMousePicker->update((Mouse*)&_mouse, _pWindow->getWidth(), _pWindow->getHeight(), ((Camera*)_pCurrentCamera)->getLookAt(), _perspective);
+		}
+
+		// Record, the renderers build their packets in parallel without touching GL
+		glm::mat4 viewProjection = _perspective * _frameUniforms.view;
+		int renderWidth = (int)std::lround(_pWindow->getContextWidth() * _pWindow->getResolutionScale());
+		int renderHeight = (int)std::lround(_pWindow->getContextHeight() * _pWindow->getResolutionScale());
+		_pProfiler->begin(PROFILE_RECORD);
+		_pJobPool->run({
+			[this, &viewProjection]() { if (_pCurrentCamera) _pObjectRenderer->record(viewProjection, _pJobPool); },
+			[this, &viewProjection, renderWidth, renderHeight]() { if (_pCurrentCamera && _lightingEnabled) _pLighting->cull(viewProjection, renderWidth, renderHeight); },
+			[this]() { if (_pCurrentCamera) _pParticleSystem->update(_pWindow->getDelta()); },
+			[this]() { _pGUIRenderer->record(); },
+			[this]() { _pTextRenderer->record(); }
+		});
+		_pProfiler->end(PROFILE_RECORD);
+
+		// Submit on this thread, in the order of the passes
 		if (_pCurrentCamera)
 		{
-			if (_pMousePicker)
-				_pMousePicker->update((Mouse*)&_mouse, _pWindow->getWidth(), _pWindow->getHeight(), ((Camera*)_pCurrentCamera)->getLookAt(), _perspective);
+			// Tile maps lay under the sprites
+			_pProfiler->begin(PROFILE_TILE_MAPS);
+			for (TileMap* tileMap : _tileMaps)
+				tileMap->render(viewProjection);
+			_pProfiler->end(PROFILE_TILE_MAPS);
 
-			_pObjectRenderer->render((Camera*)_pCurrentCamera, _perspective);
+			_pProfiler->begin(PROFILE_OBJECTS);
+			_pObjectRenderer->submit();
+			_pProfiler->end(PROFILE_OBJECTS);
+
+			_pProfiler->begin(PROFILE_PARTICLES);
+			_pParticleSystem->render(_pUniformRing);
+			_pProfiler->end(PROFILE_PARTICLES);
 
 			if (_pAxis)
-				((Axis*)_pAxis)->render(((Camera*)_pCurrentCamera)->getLookAt(), _perspective);
+			{
+				ProfileScope scope(_pProfiler, PROFILE_AXIS);
+				((Axis*)_pAxis)->render();
+			}
 		}
 
-		_pGUIRenderer->render(_orthographic);
-		_pTextRenderer->render(_orthographic);
+		_pProfiler->begin(PROFILE_GUI);
+		_pGUIRenderer->submit();
+		_pProfiler->end(PROFILE_GUI);
+
+		_pProfiler->begin(PROFILE_TEXT);
+		_pTextRenderer->submit();
+		_pProfiler->end(PROFILE_TEXT);
 
-		GL_CALL(glDisable(GL_BLEND));
+		stateCache.setBlend(false);
+
+		// The streamed data of the frame is fenced, the next frame writes in another region
+		ObjectRenderer::instanceStream->endFrame();
+		ParticleSystem::instanceStream->endFrame();
+		TextRenderer::vertexStream->endFrame();
 	}
 
 	void RendererSDLOpenGL::swap(void)
@@ -256,20 +359,44 @@ namespace ExoEngine {
 		if (_pCursor)
 			_pCursor->update();
 
+		_pProfiler->begin(PROFILE_POST_PROCESSING);
 		_pWindow->swap();
 		_pWindow->clearScreen();
+		_pProfiler->end(PROFILE_POST_PROCESSING);
+		_pProfiler->endFrame();
+
+		_frameStats.record = _pProfiler->getCpuTime(PROFILE_RECORD);
+		_frameStats.tileMaps = _pProfiler->getCpuTime(PROFILE_TILE_MAPS);
+		_frameStats.sprites = _pProfiler->getCpuTime(PROFILE_OBJECTS);
+		_frameStats.particles = _pProfiler->getCpuTime(PROFILE_PARTICLES);
+		_frameStats.widgets = _pProfiler->getCpuTime(PROFILE_GUI);
+		_frameStats.text = _pProfiler->getCpuTime(PROFILE_TEXT);
+		_frameStats.postProcessing = _pProfiler->getCpuTime(PROFILE_POST_PROCESSING);
+		_frameStats.total = 0.0;
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+			_frameStats.total += _pProfiler->getCpuTime((ProfileStage)stage);
+
+		// The counters started with draw
+		const glStateCounters& counters = GLStateCache::Get().getCounters();
+		_frameStats.drawCalls = counters.drawCalls;
+		_frameStats.stateChanges = counters.issued;
+		_frameStats.stateChangesElided = counters.elided;
+		_frameStats.uniformUploads = counters.uniformUploads;
 	}
 
 	void RendererSDLOpenGL::beginScissor(glm::vec2 position, glm::vec2 size, glm::vec2 parentPosition, glm::vec2 parentSize)
 	{
-		position *= (!_pWindow->isFullscreen() ? _pWindow->getHighDPIFactor() : 1);
-		size *= (!_pWindow->isFullscreen() ? _pWindow->getHighDPIFactor() : 1);
-		parentPosition *= (!_pWindow->isFullscreen() ? _pWindow->getHighDPIFactor() : 1);
-		parentSize *= (!_pWindow->isFullscreen() ? _pWindow->getHighDPIFactor() : 1);
+		// The scene target is drawn at the render resolution
+		float factor = (!_pWindow->isFullscreen() ? _pWindow->getHighDPIFactor() : 1) * _pWindow->getResolutionScale();
+
+		position *= factor;
+		size *= factor;
+		parentPosition *= factor;
+		parentSize *= factor;
 
 		if (parentPosition.x != 0 && parentPosition.y != 0 && parentSize.x != 0 && parentSize.y != 0)
 		{
-			glGetIntegerv(GL_SCISSOR_BOX, _scissorBit);
+			GLStateCache::Get().getScissor(_scissorBit);
 			// X
 			if (position.x + size.x > parentPosition.x + parentSize.x) // Right
 				size.x = (parentPosition.x + parentSize.x) - position.x;
@@ -291,14 +418,14 @@ namespace ExoEngine {
 			}
 		}
 
-		glEnable(GL_SCISSOR_TEST);
-		glScissor(position.x, position.y, size.x, size.y);
+		GLStateCache::Get().setScissorTest(true);
+		GLStateCache::Get().setScissor((GLint)position.x, (GLint)position.y, (GLsizei)size.x, (GLsizei)size.y);
 	}
 
 	void RendererSDLOpenGL::endScissor(void)
 	{
-		glScissor(_scissorBit[0], _scissorBit[1], _scissorBit[2], _scissorBit[3]);
-		glDisable(GL_SCISSOR_TEST);
+		GLStateCache::Get().setScissor(_scissorBit[0], _scissorBit[1], _scissorBit[2], _scissorBit[3]);
+		GLStateCache::Get().setScissorTest(false);
 
 		// Reset
 		_scissorBit[0] = 0; _scissorBit[1] = 0; _scissorBit[2] = 0; _scissorBit[3] = 0;
@@ -325,6 +452,36 @@ namespace ExoEngine {
 		return SDL_GetTicks();
 	}
 
+	UniformRing* RendererSDLOpenGL::getUniformRing(void)
+	{
+		return (_pUniformRing);
+	}
+
+	const glStateCounters& RendererSDLOpenGL::getStateCounters(void) const
+	{
+		return (_stateCounters);
+	}
+
+	Lighting* RendererSDLOpenGL::getLighting(void)
+	{
+		return (_pLighting);
+	}
+
+	const particleStats& RendererSDLOpenGL::getParticleStats(void) const
+	{
+		return (_pParticleSystem->getStats());
+	}
+
+	Profiler* RendererSDLOpenGL::getProfiler(void)
+	{
+		return (_pProfiler);
+	}
+
+	const frameStats& RendererSDLOpenGL::getFrameStats(void) const
+	{
+		return (_frameStats);
+	}
+
 	void RendererSDLOpenGL::setCursor(ICursor* cursor)
 	{
 		if (_pCursor)
@@ -352,18 +509,65 @@ namespace ExoEngine {
 			_pObjectRenderer->setGrid(val);
 	}
 
+	void RendererSDLOpenGL::setTextureCompression(bool enabled)
+	{
+		TextureCache::Get().setCompression(enabled);
+	}
+
+	void RendererSDLOpenGL::setProfilerOverlay(const std::shared_ptr<Font>& font)
+	{
+		if (_pProfilerOverlay)
+		{
+			remove(_pProfilerOverlay);
+			delete _pProfilerOverlay;
+			_pProfilerOverlay = nullptr;
+		}
+		if (!font)
+			return;
+
+		// The GPU side is what the overlay is for
+		_pProfiler->setGpuTimers(true);
+
+		_pProfilerOverlay = new Label();
+		_pProfilerOverlay->setFont(font);
+		_pProfilerOverlay->setLocalAnchor(AnchorPoint::TOP_LEFT);
+		_pProfilerOverlay->setFontScale(0.2f);
+		_pProfilerOverlay->setPosition(10.0f, 10.0f);
+		_pProfilerOverlay->setText(_pProfiler->getReport());
+		add(_pProfilerOverlay);
+	}
+
+	void RendererSDLOpenGL::setCulling(bool enabled, float cellSize)
+	{
+		if (_pObjectRenderer)
+			_pObjectRenderer->setCulling(enabled, cellSize);
+	}
+
+	void RendererSDLOpenGL::setParticleBudget(unsigned int budget)
+	{
+		if (_pParticleSystem)
+			_pParticleSystem->setBudget(budget);
+	}
+
+	void RendererSDLOpenGL::setLighting(bool enabled)
+	{
+		_lightingEnabled = enabled;
+		if (_pObjectRenderer)
+			_pObjectRenderer->setLighting(enabled ? _pLighting : nullptr);
+	}
+
 	// Private
 	RendererSDLOpenGL::RendererSDLOpenGL(void)
-		: IRenderer(), _pWindow(nullptr), _pObjectRenderer(nullptr), _pGUIRenderer(nullptr), _pTextRenderer(nullptr), _pCursor(nullptr)
+		: IRenderer(), _pWindow(nullptr), _pObjectRenderer(nullptr), _pGUIRenderer(nullptr), _pTextRenderer(nullptr), _pLighting(nullptr), _lightingEnabled(false), _pParticleSystem(nullptr), _pProfiler(nullptr), _pProfilerOverlay(nullptr), _pFrameUniformBuffer(nullptr), _pUniformRing(nullptr), _pJobPool(nullptr), _pCursor(nullptr)
 	{
 		_mainThread = std::this_thread::get_id();
+		_stateCounters = { 0, 0, 0, 0 };
+		_frameStats = frameStats();
 	}
 
 	RendererSDLOpenGL::~RendererSDLOpenGL(void)
 	{
-		if (_pWindow)
-			delete _pWindow;
-
+		// Everything below releases GL objects, the window and its context go last
 		if (_pCursor)
 			delete _pCursor;
 
@@ -377,12 +581,36 @@ namespace ExoEngine {
 		if (_pTextRenderer)
 			delete _pTextRenderer;
 
+		if (_pLighting)
+			delete _pLighting;
+
+		if (_pParticleSystem)
+			delete _pParticleSystem;
+
+		if (_pProfilerOverlay)
+			delete _pProfilerOverlay;
+
+		if (_pProfiler)
+			delete _pProfiler;
+
+		if (_pJobPool)
+			delete _pJobPool;
+
 		// Buffers
+		if (_pFrameUniformBuffer)
+			delete _pFrameUniformBuffer;
+
+		if (_pUniformRing)
+			delete _pUniformRing;
+
+		if (ObjectRenderer::instanceStream)
+			delete ObjectRenderer::instanceStream;
+
 		if (TextRenderer::vaoBuffer)
 			delete TextRenderer::vaoBuffer;
 
-		if (TextRenderer::vertexBuffer)
-			delete TextRenderer::vertexBuffer;
+		if (TextRenderer::vertexStream)
+			delete TextRenderer::vertexStream;
 
 		// Shaders
 		if (ObjectRenderer::pShader)
@@ -393,6 +621,27 @@ namespace ExoEngine {
 
 		if (TextRenderer::pTextShader)
 			delete TextRenderer::pTextShader;
+
+		if (TileMap::pShader)
+			delete TileMap::pShader;
+
+		if (TileMap::indexBuffer)
+			delete TileMap::indexBuffer;
+
+		if (ParticleSystem::pShader)
+			delete ParticleSystem::pShader;
+
+		if (ParticleSystem::instanceStream)
+			delete ParticleSystem::instanceStream;
+
+		if (ParticleSystem::vertexBuffer)
+			delete ParticleSystem::vertexBuffer;
+
+		if (ParticleSystem::vaoBuffer)
+			delete ParticleSystem::vaoBuffer;
+
+		if (_pWindow)
+			delete _pWindow;
 	}
 
 	void RendererSDLOpenGL::createBuffers(void)
@@ -421,135 +670,311 @@ namespace ExoEngine {
 		ObjectRenderer::indexBuffer = new Buffer(6, 3, &indexBuffer, BufferType::INDEXBUFFER, BufferDraw::STATIC, 0, false);
 		ObjectRenderer::uvBuffer = new Buffer(8, 2, &UVBuffer, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 1, true);
 
+		// Sprite instances: position, scale (attribute 2) and angle, layer, flip (attribute 3)
+		ObjectRenderer::instanceStream = new StreamBuffer(1024 * sizeof(spriteInstance));
+
+		// Uniform buffers: the frame block, then the ring of the per batch blocks
+		_pFrameUniformBuffer = new Buffer(sizeof(frameUniforms) / sizeof(float), 0, NULL, BufferType::UNIFORMBUFFER, BufferDraw::DYNAMIC, 0, false);
+		_pUniformRing = new UniformRing(UNIFORM_RING_SIZE);
+
 		// TextRenderer
 		TextRenderer::vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
-		TextRenderer::vertexBuffer = new Buffer(24, 4, NULL, BufferType::ARRAYBUFFER, BufferDraw::DYNAMIC, 0, false);
+		TextRenderer::vertexStream = new StreamBuffer(4096 * 7 * sizeof(float));
+
+		// Axis: lines, translation heads then scale heads, colored per vertex
+		const float axisVertexBuffer[] = {
+			 0.0f,	0.0f,	1, 0, 0, 1,		// X line
+			 1.0f,	0.0f,	1, 0, 0, 1,
+			 0.0f,	0.0f,	0, 1, 0, 1,		// Y line
+			 0.0f,	1.0f,	0, 1, 0, 1,
+
+			 1.15f,	0.0f,	1, 0, 0, 1,		// X arrow
+			 0.95f,	0.05f,	1, 0, 0, 1,
+			 0.95f,	-0.05f,	1, 0, 0, 1,
+			 0.0f,	1.15f,	0, 1, 0, 1,		// Y arrow
+			-0.05f,	0.95f,	0, 1, 0, 1,
+			 0.05f,	0.95f,	0, 1, 0, 1,
+
+			 0.96f,	0.04f,	1, 0, 0, 1,		// X square
+			 0.96f,	-0.04f,	1, 0, 0, 1,
+			 1.04f,	0.04f,	1, 0, 0, 1,
+			 0.96f,	-0.04f,	1, 0, 0, 1,
+			 1.04f,	-0.04f,	1, 0, 0, 1,
+			 1.04f,	0.04f,	1, 0, 0, 1,
+			-0.04f,	1.04f,	0, 1, 0, 1,		// Y square
+			-0.04f,	0.96f,	0, 1, 0, 1,
+			 0.04f,	1.04f,	0, 1, 0, 1,
+			-0.04f,	0.96f,	0, 1, 0, 1,
+			 0.04f,	0.96f,	0, 1, 0, 1,
+			 0.04f,	1.04f,	0, 1, 0, 1,
+		};
 
-		// Grid
-		const float line[] = {
-			0.0,	0.0,
-			1.0,	0.0,
+		Axis::vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+		Axis::vertexBuffer = new Buffer(sizeof(axisVertexBuffer) / sizeof(float), 0, &axisVertexBuffer, BufferType::INSTANCEBUFFER, BufferDraw::STATIC, 0, false);
+		Axis::vertexBuffer->setAttribute(0, 2, AXIS_VERTEX_SIZE, 0, 0);
+		Axis::vertexBuffer->setAttribute(1, 4, AXIS_VERTEX_SIZE, 2, 0);
+
+		// Particles: unit quad (position, uv) shared by the emitters, the instances are streamed
+		const float particleVertexBuffer[] = {
+			-0.5f,	0.5f,	0.0f, 0.0f,
+			-0.5f, -0.5f,	0.0f, 1.0f,
+			 0.5f, -0.5f,	1.0f, 1.0f,
+			 0.5f,	0.5f,	1.0f, 0.0f
 		};
 
-		Grid::vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
-		Grid::vertexBuffer = new Buffer(4, 2, &line, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
+		ParticleSystem::vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+		ObjectRenderer::indexBuffer->bind();
+		ParticleSystem::vertexBuffer = new Buffer(16, 0, &particleVertexBuffer, BufferType::INSTANCEBUFFER, BufferDraw::STATIC, 0, false);
+		ParticleSystem::vertexBuffer->setAttribute(0, 2, 4, 0, 0);
+		ParticleSystem::vertexBuffer->setAttribute(1, 2, 4, 2, 0);
+		ParticleSystem::instanceStream = new StreamBuffer(16384 * PARTICLE_INSTANCE_SIZE * sizeof(float));
 
-		// Axis
-		const float triangleVertexBuffer[] = {
-			 0.0f,	0.15f, 0.0f,	// top
-			-0.05f, -0.05f, 0.0f,	// bottom left
-			 0.05f, -0.05f, 0.0f	// bottom right
-		};
+		// TileMap: the quads of a full chunk, bound by every chunk vertex array
+		std::vector<unsigned int> tileIndices(TILE_CHUNK_SIZE * TILE_CHUNK_SIZE * 6);
+		for (unsigned int i = 0; i < TILE_CHUNK_SIZE * TILE_CHUNK_SIZE; i++)
+		{
+			for (unsigned int j = 0; j < 6; j++)
+				tileIndices[i * 6 + j] = indexBuffer[j] + i * 4;
+		}
 
-		Axis::vaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
-		Axis::vertexBuffer = new Buffer(9, 3, &triangleVertexBuffer, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
+		GLStateCache::Get().bindVertexArray(0);
+		TileMap::indexBuffer = new Buffer(tileIndices.size(), 3, tileIndices.data(), BufferType::INDEXBUFFER, BufferDraw::STATIC, 0, false);
 	}
 
 #ifndef USE_TEST_SHADERS
 
 	static const std::vector<std::string> g_2DShader = {
 		"#version 330 core",
-		"",
 		"layout(location = 0) in vec3 position;",
 		"layout(location = 1) in vec2 texCoord;",
+		"layout(location = 2) in vec4 instanceTransform;",
+		"layout(location = 3) in vec4 instanceData;",
+		"layout(location = 4) in vec4 instanceAnimation;",
 		"",
-		"uniform mat4 view;",
-		"uniform mat4 projection;",
-		"uniform mat4 model;",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"    vec4 time;",
+		"};",
+		"uniform float size;",
 		"",
 		"out vec2 TexCoords;",
+		"out vec2 World;",
+		"flat out int Layer;",
+		"flat out vec4 NormalTransform;",
 		"",
 		"void main(void) ",
 		"{",
-		"    gl_Position = projection * view * model * vec4(position, 1.0);",
-		"    TexCoords = texCoord;",
+		"    float c = cos(instanceData.x);",
+		"    float s = sin(instanceData.x);",
+		"    vec2 scaled = position.xy * instanceTransform.zw;",
+		"    vec2 world = vec2(scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c) + instanceTransform.xy;",
+		"",
+		"    gl_Position = projection * view * vec4(world, 0.0, 1.0);",
+		"    TexCoords = texCoord * size * instanceData.zw;",
+		"    World = world;",
+		"",
+		"    // Frame of the clip from its start time, frame count, frame duration and loop flag",
+		"    float layer = instanceData.y;",
+		"    if (instanceAnimation.y > 0.0)",
+		"    {",
+		"        float frame = floor(max(time.x - instanceAnimation.x, 0.0) / max(instanceAnimation.z, 0.0001));",
+		"        layer += instanceAnimation.w > 0.5 ? mod(frame, instanceAnimation.y) : min(frame, instanceAnimation.y - 1.0);",
+		"    }",
+		"    Layer = int(layer);",
+		"    NormalTransform = vec4(c, s, instanceData.zw);",
 		"}",
 		"",
 		"#FRAGMENT",
 		"#version 330 core",
 		"",
+		"// Height of the lights above the sprites, relative to their radius",
+		"#define LIGHT_HEIGHT 0.25",
+		"#define SHADOW_STEPS 24",
+		"",
 		"in vec2 TexCoords;",
+		"in vec2 World;",
+		"flat in int Layer;",
+		"flat in vec4 NormalTransform;",
+		"",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"    vec4 time;",
+		"};",
 		"",
 		"uniform sampler2DArray ourTexture;",
-		"uniform int layer;",
-		"uniform int flipHorizontal;",
-		"uniform int flipVertical;",
-		"uniform float size;",
+		"uniform sampler2DArray normalMap;",
+		"uniform samplerBuffer lights;",
+		"uniform usamplerBuffer lightTiles;",
+		"uniform usamplerBuffer lightIndices;",
+		"uniform sampler2D shadowMask;",
+		"",
+		"uniform int lighting;",
+		"uniform int normalMapped;",
+		"uniform int occluder;",
+		"uniform int shadows;",
+		"uniform vec3 ambient;",
+		"uniform float lightTileSize;",
+		"uniform int lightTilesX;",
+		"uniform vec2 lightViewport;",
 		"",
 		"out vec4 color;",
 		"",
+		"float shadow(vec2 light)",
+		"{",
+		"    vec4 clip = projection * view * vec4(light, 0.0, 1.0);",
+		"    vec2 target = clip.xy / clip.w * 0.5 + 0.5;",
+		"    vec2 origin = gl_FragCoord.xy / lightViewport;",
+		"    bool outside = false;",
+		"",
+		"    // March to the light in the occluder mask, the sprite of the fragment does not shadow itself",
+		"    for (int i = 1; i <= SHADOW_STEPS; i++)",
+		"    {",
+		"        if (texture(shadowMask, mix(origin, target, float(i) / float(SHADOW_STEPS))).r < 0.5)",
+		"            outside = true;",
+		"        else if (outside)",
+		"            return (0.0);",
+		"    }",
+		"    return (1.0);",
+		"}",
+		"",
 		"void main(void) ",
 		"{    ",
-		"    vec4 color_out = texture(ourTexture, vec3(TexCoords.x * size * flipHorizontal, TexCoords.y * size * flipVertical, layer));",
+		"    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer));",
 		"",
 		"    if(color_out.a < 0.1)",
 		"        discard;",
 		"",
-		"	color = color_out;",
+		"    if (occluder != 0)",
+		"    {",
+		"        color = vec4(1.0);",
+		"        return;",
+		"    }",
+		"",
+		"    if (lighting == 0)",
+		"    {",
+		"        color = color_out;",
+		"        return;",
+		"    }",
+		"",
+		"    // Normal in world space: flipped then rotated like the sprite",
+		"    vec3 normal = vec3(0.0, 0.0, 1.0);",
+		"    if (normalMapped != 0)",
+		"    {",
+		"        normal = texture(normalMap, vec3(TexCoords, Layer)).xyz * 2.0 - 1.0;",
+		"        normal.xy *= NormalTransform.zw;",
+		"        normal.xy = vec2(normal.x * NormalTransform.x - normal.y * NormalTransform.y, normal.x * NormalTransform.y + normal.y * NormalTransform.x);",
+		"        normal = normalize(normal);",
+		"    }",
+		"",
+		"    // Only the lights binned in the tile of the fragment",
+		"    ivec2 tile = ivec2(gl_FragCoord.xy / lightTileSize);",
+		"    uvec2 list = texelFetch(lightTiles, tile.y * lightTilesX + tile.x).xy;",
+		"    vec3 diffuse = ambient;",
+		"",
+		"    for (uint i = 0u; i < list.y; i++)",
+		"    {",
+		"        int index = int(texelFetch(lightIndices, int(list.x + i)).r);",
+		"        vec4 light = texelFetch(lights, index * 2);",
+		"        vec4 lightColor = texelFetch(lights, index * 2 + 1);",
+		"        vec2 delta = light.xy - World;",
+		"        float dist = length(delta);",
+		"",
+		"        if (dist >= light.z)",
+		"            continue;",
+		"",
+		"        float attenuation = 1.0 - dist / light.z;",
+		"        float lambert = max(dot(normal, normalize(vec3(delta, light.z * LIGHT_HEIGHT))), 0.0);",
+		"",
+		"        if (shadows != 0 && lightColor.a > 0.5 && lambert > 0.0)",
+		"            lambert *= shadow(light.xy);",
+		"",
+		"        diffuse += lightColor.rgb * light.w * attenuation * attenuation * lambert;",
+		"    }",
+		"",
+		"    color = vec4(color_out.rgb * diffuse, color_out.a);",
 		"}"
 	};
 
 	static const std::vector<std::string> g_guiShader = {
 		"#version 330 core",
 		"layout (location = 0) in vec2 position;",
+		"layout (location = 1) in vec2 texCoord;",
+		"layout (location = 2) in float opacity;",
 		"",
-		"uniform mat4 transformation;",
-		"uniform mat4 projection;",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
 		"",
 		"out vec2 TexCoords;",
+		"out float Opacity;",
 		"",
 		"void main(void)",
 		"{",
-		"    gl_Position = projection * transformation * vec4(position, 0.0, 1.0);",
-		"    TexCoords = vec2((position.x + 1.0) / 2, 1 - (-1 * position.y + 1.0) / 2.0);",
+		"    gl_Position = orthographic * vec4(position, 0.0, 1.0);",
+		"    TexCoords = texCoord;",
+		"    Opacity = opacity;",
 		"}",
 		"",
 		"#FRAGMENT",
 		"#version 330 core",
 		"",
 		"in vec2 TexCoords;",
+		"in float Opacity;",
 		"",
 		"out vec4 color;",
 		"",
 		"uniform sampler2D guiTexture;",
-		"uniform float opacity;",
-		"uniform float numberOfRows;",
-		"uniform float numberOfColumns;",
-		"uniform vec2 offset;",
 		"",
 		"void main(void)",
 		"{    ",
-		"    color = texture(guiTexture, vec2(TexCoords.x / numberOfRows, TexCoords.y / numberOfColumns) + offset);",
-		"    color.a = color.a - opacity;",
+		"    color = texture(guiTexture, TexCoords);",
+		"    color.a = color.a - Opacity;",
 		"}"
 	};
 
 	static const std::vector<std::string>	g_fontShader = {
 		"#version 330 core",
 		"layout (location = 0) in vec4 vertex;",
+		"layout (location = 1) in vec3 color;",
 		"",
-		"uniform mat4 projection;",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
 		"",
 		"out vec2 TexCoords;",
+		"out vec3 TextColor;",
 		"",
 		"void main()",
 		"{",
-		"    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);",
+		"    gl_Position = orthographic * vec4(vertex.xy, 0.0, 1.0);",
 		"    TexCoords = vertex.zw;",
+		"    TextColor = color;",
 		"}",
 		"",
 		"#FRAGMENT",
 		"#version 330 core",
 		"",
 		"in vec2 TexCoords;",
+		"in vec3 TextColor;",
 		"out vec4 color;",
 		"",
 		"uniform sampler2D fontAtlas;",
-		"uniform vec3 textColor;",
 		"",
 		"void main()",
 		"{    ",
-		"    color = vec4(textColor, texture(fontAtlas, TexCoords).r);",
+		"    color = vec4(TextColor, texture(fontAtlas, TexCoords).r);",
 		"}"
 	};
 
@@ -558,8 +983,12 @@ namespace ExoEngine {
 		"",
 		"layout(location = 0) in vec3 position;",
 		"",
-		"uniform mat4 view;",
-		"uniform mat4 projection;",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
 		"uniform mat4 model;",
 		"uniform vec4 color;",
 		"",
@@ -587,9 +1016,14 @@ namespace ExoEngine {
 		"#version 330",
 		"",
 		"layout(location = 0) in vec3 position;",
+		"layout(location = 1) in vec4 vertexColor;",
 		"",
-		"uniform mat4 view;",
-		"uniform mat4 projection;",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
 		"uniform mat4 model;",
 		"uniform vec4 color;",
 		"",
@@ -598,7 +1032,7 @@ namespace ExoEngine {
 		"void main(void)",
 		"{",
 		"  gl_Position = projection * view * model * vec4(position, 1.0);",
-		"  in_color = color;",
+		"  in_color = color * vertexColor;",
 		"}",
 		"",
 		"#FRAGMENT",
@@ -613,23 +1047,170 @@ namespace ExoEngine {
 		"}"
 	};
 
+	static const std::vector<std::string> g_tileMapShader = {
+		"#version 330 core",
+		"",
+		"layout(location = 0) in vec2 position;",
+		"layout(location = 1) in vec2 texCoord;",
+		"layout(location = 2) in float layer;",
+		"",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
+		"uniform mat4 model;",
+		"",
+		"out vec2 TexCoords;",
+		"flat out int Layer;",
+		"",
+		"void main(void)",
+		"{",
+		"    gl_Position = projection * view * model * vec4(position, 0.0, 1.0);",
+		"    TexCoords = texCoord;",
+		"    Layer = int(layer);",
+		"}",
+		"",
+		"#FRAGMENT",
+		"#version 330 core",
+		"",
+		"in vec2 TexCoords;",
+		"flat in int Layer;",
+		"",
+		"uniform sampler2DArray ourTexture;",
+		"",
+		"out vec4 color;",
+		"",
+		"void main(void)",
+		"{",
+		"    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer));",
+		"",
+		"    if(color_out.a < 0.1)",
+		"        discard;",
+		"",
+		"    color = color_out;",
+		"}"
+	};
+
+	static const std::vector<std::string> g_particleShader = {
+		"#version 330 core",
+		"layout(location = 0) in vec2 position;",
+		"layout(location = 1) in vec2 texCoord;",
+		"layout(location = 2) in vec4 instance;",
+		"",
+		"layout(std140) uniform Frame",
+		"{",
+		"    mat4 projection;",
+		"    mat4 view;",
+		"    mat4 orthographic;",
+		"};",
+		"layout(std140) uniform Emitter",
+		"{",
+		"    vec4 startColor;",
+		"    vec4 endColor;",
+		"    vec2 scale;",
+		"    vec2 frames;",
+		"};",
+		"",
+		"out vec2 TexCoords;",
+		"out vec4 Color;",
+		"flat out int Layer;",
+		"",
+		"void main(void)",
+		"{",
+		"    // instance: position, fraction of the life, angle",
+		"    float life = instance.z;",
+		"    float c = cos(instance.w);",
+		"    float s = sin(instance.w);",
+		"    vec2 scaled = position * mix(scale.x, scale.y, life);",
+		"    vec2 world = vec2(scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c) + instance.xy;",
+		"",
+		"    gl_Position = projection * view * vec4(world, 0.0, 1.0);",
+		"    TexCoords = texCoord;",
+		"    Color = mix(startColor, endColor, life);",
+		"    Layer = int(frames.x) + min(int(life * frames.y), int(frames.y) - 1);",
+		"}",
+		"",
+		"#FRAGMENT",
+		"#version 330 core",
+		"",
+		"in vec2 TexCoords;",
+		"in vec4 Color;",
+		"flat in int Layer;",
+		"",
+		"uniform sampler2DArray ourTexture;",
+		"",
+		"out vec4 color;",
+		"",
+		"void main(void)",
+		"{",
+		"    vec4 color_out = texture(ourTexture, vec3(TexCoords, Layer)) * Color;",
+		"",
+		"    if (color_out.a < 0.01)",
+		"        discard;",
+		"",
+		"    color = color_out;",
+		"}"
+	};
+
 #endif
 
 	void RendererSDLOpenGL::loadShaders(void)
 	{
+		ObjectRenderer::pShader = new Shader();
+		GUIRenderer::pGuiShader = new Shader();
+		TextRenderer::pTextShader = new Shader();
+		Grid::pShader = new Shader();
+		Axis::pShader = new Shader();
+		TileMap::pShader = new Shader();
+		ParticleSystem::pShader = new Shader();
+
+#ifndef __APPLE__
+		// Compiles and links return at once, the driver works on its own threads
+		if (GLEW_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+#endif
+
+		// Every program is started before the first one is checked
 #ifdef USE_TEST_SHADERS
-		ObjectRenderer::pShader = new Shader("resources/shaders/OpenGL3/2D.glsl");
-		GUIRenderer::pGuiShader = new Shader("resources/shaders/OpenGL3/gui.glsl");
-		TextRenderer::pTextShader = new Shader("resources/shaders/OpenGL3/font.glsl");
-		Grid::pShader = new Shader("resources/shaders/OpenGL3/line.glsl");
-		Axis::pShader = new Shader("resources/shaders/OpenGL3/axis.glsl");
+		ObjectRenderer::pShader->compile("resources/shaders/OpenGL3/2D.glsl");
+		GUIRenderer::pGuiShader->compile("resources/shaders/OpenGL3/gui.glsl");
+		TextRenderer::pTextShader->compile("resources/shaders/OpenGL3/font.glsl");
+		Grid::pShader->compile("resources/shaders/OpenGL3/line.glsl");
+		Axis::pShader->compile("resources/shaders/OpenGL3/axis.glsl");
+		TileMap::pShader->compile("resources/shaders/OpenGL3/tilemap.glsl");
+		ParticleSystem::pShader->compile("resources/shaders/OpenGL3/particle.glsl");
 #else
-		ObjectRenderer::pShader = new Shader(g_2DShader);
-		GUIRenderer::pGuiShader = new Shader(g_guiShader);
-		TextRenderer::pTextShader = new Shader(g_fontShader);
-		Grid::pShader = new Shader(g_lineShader);
-		Axis::pShader = new Shader(g_axisShader);
+		ObjectRenderer::pShader->compile(g_2DShader);
+		GUIRenderer::pGuiShader->compile(g_guiShader);
+		TextRenderer::pTextShader->compile(g_fontShader);
+		Grid::pShader->compile(g_lineShader);
+		Axis::pShader->compile(g_axisShader);
+		TileMap::pShader->compile(g_tileMapShader);
+		ParticleSystem::pShader->compile(g_particleShader);
 #endif
+
+		for (Shader* shader : { ObjectRenderer::pShader, GUIRenderer::pGuiShader, TextRenderer::pTextShader, Grid::pShader, Axis::pShader, TileMap::pShader, ParticleSystem::pShader })
+			shader->finishCompile();
+
+		// Per frame matrices shared by every shader
+		ObjectRenderer::pShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		GUIRenderer::pGuiShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		TextRenderer::pTextShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		Grid::pShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		Axis::pShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		TileMap::pShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+		ParticleSystem::pShader->bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+
+		// Per batch parameters streamed through the ring
+		ParticleSystem::pShader->bindUniformBlock("Emitter", EMITTER_UNIFORM_BINDING);
+
+		// Resolve the uniform locations once
+		ObjectRenderer::loadUniforms();
+		Grid::loadUniforms();
+		Axis::loadUniforms();
+		TileMap::loadUniforms();
 	}
 
 }
\ No newline at end of file
@@ -48,6 +48,16 @@ namespace ExoEngine {
 		return (vector);
 	}
 
+	// "nearest", "linear" (default) or "mipmap"
+	static TextureFilter	parseFilter(const xmlChar* filter)
+	{
+		if (filter && strcmp((const char*)filter, "nearest") == 0)
+			return (TextureFilter::NEAREST);
+		if (filter && strcmp((const char*)filter, "mipmap") == 0)
+			return (TextureFilter::MIPMAP);
+		return (TextureFilter::LINEAR);
+	}
+
 	ResourceManager::ResourceManager(IRenderer* renderer, Audio* audio) 
 		: _renderer(renderer), _audio(audio)
 	{
@@ -97,13 +107,14 @@ namespace ExoEngine {
 	{
 		xmlChar* name = xmlGetProp(node, (const xmlChar*)"name");
 		xmlChar* path = xmlGetProp(node, (const xmlChar*)"path");
+		xmlChar* filter = xmlGetProp(node, (const xmlChar*)"filter");
 
 		if (!name)
 			_log.warning << "texture without name" << std::endl;
 		if (!path)
 			_log.warning << "texture without path" << std::endl;
 		if (name && path)
-			add((char*)name, std::shared_ptr<ITexture>(_renderer->createTexture((relativePath + (char*)path).c_str())));
+			add((char*)name, std::shared_ptr<ITexture>(_renderer->createTexture((relativePath + (char*)path).c_str(), parseFilter(filter))));
 	}
 
 	void	ResourceManager::loadArrayTexture(const std::string& relativePath, xmlNodePtr node)
@@ -129,7 +140,95 @@ namespace ExoEngine {
 			(*texture) = relativePath + (*texture);
 
 		if (name && width && height && content)
-			add((char*)name, std::shared_ptr<IArrayTexture>(_renderer->createArrayTexture(std::stoi((char*)width), std::stoi((char*)height), textures, strcmp((char*)filter, "nearest") == 0 ? TextureFilter::NEAREST : TextureFilter::LINEAR)));
+			add((char*)name, std::shared_ptr<IArrayTexture>(_renderer->createArrayTexture(std::stoi((char*)width), std::stoi((char*)height), textures, parseFilter(filter))));
+	}
+
+	void	ResourceManager::loadAnimation(const std::string&, xmlNodePtr node)
+	{
+		xmlChar* name = xmlGetProp(node, (const xmlChar*)"name");
+		xmlChar* texture = xmlGetProp(node, (const xmlChar*)"texture");
+		xmlChar* first = xmlGetProp(node, (const xmlChar*)"first");
+		xmlChar* frames = xmlGetProp(node, (const xmlChar*)"frames");
+		xmlChar* duration = xmlGetProp(node, (const xmlChar*)"duration");
+		xmlChar* loop = xmlGetProp(node, (const xmlChar*)"loop");
+		std::shared_ptr<IArrayTexture> arrayTexture;
+
+		if (!name)
+			_log.warning << "animation without name" << std::endl;
+		if (!texture)
+			_log.warning << "animation without texture" << std::endl;
+		if (!frames)
+			_log.warning << "animation without frames" << std::endl;
+		if (!duration)
+			_log.warning << "animation without duration" << std::endl;
+
+		// The array texture is declared before the clips using it
+		if (texture && !(arrayTexture = get<IArrayTexture>((char*)texture)))
+			_log.warning << "animation texture '" << texture << "' is not a loaded array texture" << std::endl;
+
+		if (name && arrayTexture && frames && duration)
+		{
+			int frameCount = std::stoi((char*)frames);
+			float frameDuration = std::stof((char*)duration);
+
+			if (frameCount < 1 || frameDuration <= 0.0f)
+				_log.warning << "animation '" << name << "' needs at least one frame and a positive duration" << std::endl;
+			else
+				add((char*)name, std::shared_ptr<animationClip>(new animationClip(arrayTexture, first ? std::stoi((char*)first) : 0,
+					frameCount, frameDuration, !loop || strcmp((char*)loop, "false") != 0)));
+		}
+	}
+
+	void	ResourceManager::loadAtlas(const std::string& relativePath, xmlNodePtr node)
+	{
+		xmlChar* name = xmlGetProp(node, (const xmlChar*)"name");
+		xmlChar* width = xmlGetProp(node, (const xmlChar*)"width");
+		xmlChar* height = xmlGetProp(node, (const xmlChar*)"height");
+		xmlChar* filter = xmlGetProp(node, (const xmlChar*)"filter");
+		std::vector<std::string>	names;
+		std::vector<std::string>	textures;
+
+		if (!name)
+			_log.warning << "atlas without name" << std::endl;
+		if (!width)
+			_log.warning << "atlas without width" << std::endl;
+		if (!height)
+			_log.warning << "atlas without height" << std::endl;
+
+		for (auto currentNode = node->children; currentNode; currentNode = currentNode->next)
+		{
+			if (currentNode->type == XML_ELEMENT_NODE)
+			{
+				if (!xmlStrcmp(currentNode->name, (const xmlChar*)"texture"))
+				{
+					xmlChar* textureName = xmlGetProp(currentNode, (const xmlChar*)"name");
+					xmlChar* texturePath = xmlGetProp(currentNode, (const xmlChar*)"path");
+
+					if (!textureName)
+						_log.warning << "texture without name" << std::endl;
+					if (!texturePath)
+						_log.warning << "texture without path" << std::endl;
+					if (textureName && texturePath)
+					{
+						names.push_back((char*)textureName);
+						textures.push_back(relativePath + (char*)texturePath);
+					}
+				}
+				else
+					_log.warning << "unknown atlas entry '" << currentNode->name << "'" << std::endl;
+			}
+		}
+
+		if (name && width && height && textures.size() > 0)
+		{
+			std::shared_ptr<ITextureAtlas> atlas(_renderer->createTextureAtlas(std::stoi((char*)width), std::stoi((char*)height), textures, parseFilter(filter)));
+
+			// Each texture stays reachable by its own name
+			add((char*)name, atlas);
+			for (size_t i = 0; i < names.size(); i++)
+				add(names[i], atlas->getTexture(i));
+			_log.debug << "atlas " << name << " packed " << atlas->size() << " textures in " << atlas->getPageCount() << " pages" << std::endl;
+		}
 	}
 
 	void	ResourceManager::loadSound(const std::string& relativePath, xmlNodePtr node)
@@ -237,6 +336,10 @@ namespace ExoEngine {
 						loadTexture(path, currentNode);
 					else if (!xmlStrcmp(currentNode->name, (const xmlChar*)"arrayTexture"))
 						loadArrayTexture(path, currentNode);
+					else if (!xmlStrcmp(currentNode->name, (const xmlChar*)"animation"))
+						loadAnimation(path, currentNode);
+					else if (!xmlStrcmp(currentNode->name, (const xmlChar*)"atlas"))
+						loadAtlas(path, currentNode);
 					else if (!xmlStrcmp(currentNode->name, (const xmlChar*)"sound"))
 						loadSound(path, currentNode);
 					else if (!xmlStrcmp(currentNode->name, (const xmlChar*)"font"))
@@ -27,12 +27,14 @@
 #include <vector>
 
 #include "Shader.h"
+#include "GLStateCache.h"
+#include "ShaderCache.h"
 #include "OGLCall.h"
 
 namespace ExoEngine {
 
 	Shader::Shader(void)
-		: _programId(0)
+		: _programId(0), _vertexShaderId(0), _fragmentShaderId(0), _cacheKey(0)
 	{	}
 
 	Shader::Shader(const std::string& filePath)
@@ -49,141 +51,205 @@ namespace ExoEngine {
 
 	Shader::~Shader(void)
 	{
-		glDeleteProgram(_programId);
+		GLStateCache::Get().deleteProgram(_programId);
 	}
 
 	void Shader::initialize(const std::string& filePath)
+	{
+		compile(filePath);
+		finishCompile();
+	}
+
+	void Shader::initialize(const std::vector<std::string>& shaderSource)
+	{
+		compile(shaderSource);
+		finishCompile();
+	}
+
+	void Shader::compile(const std::string& filePath)
 	{
 		std::string vertexShaderCode;
 		std::string fragmentShaderCode;
 
 		// Read the shader file
 		loadShader(filePath, vertexShaderCode, fragmentShaderCode);
+		compileProgram(vertexShaderCode, fragmentShaderCode);
+	}
 
-		// Compile
-		unsigned int vertexShaderID = compileShader(vertexShaderCode, GL_VERTEX_SHADER);
-		unsigned int fragmentShaderID = compileShader(fragmentShaderCode, GL_FRAGMENT_SHADER);
-
-		// Create the program
-		GL_CALL(_programId = glCreateProgram());
+	void Shader::compile(const std::vector<std::string>& shaderSource)
+	{
+		std::string vertexShaderCode;
+		std::string fragmentShaderCode;
 
-		GL_CALL(glAttachShader(_programId, vertexShaderID));
-		GL_CALL(glAttachShader(_programId, fragmentShaderID));
-		GL_CALL(glLinkProgram(_programId));
+		// Read the shader source
+		loadShader(shaderSource, vertexShaderCode, fragmentShaderCode);
+		compileProgram(vertexShaderCode, fragmentShaderCode);
+	}
 
-		GLint isLinked = 0;
-		GL_CALL(glGetProgramiv(_programId, GL_LINK_STATUS, &isLinked));
-		if (isLinked == GL_FALSE)
+	void Shader::finishCompile(void)
+	{
+		// Compiled from the sources, a cached binary is already linked
+		if (_vertexShaderId)
 		{
-			GLint maxLength = 0;
-			GL_CALL(glGetProgramiv(_programId, GL_INFO_LOG_LENGTH, &maxLength));
+			checkShader(_vertexShaderId);
+			checkShader(_fragmentShaderId);
 
-			std::vector<char> errorMessage(maxLength);
-			GL_CALL(glGetProgramInfoLog(_programId, maxLength, &maxLength, &errorMessage[0]));
-			glDeleteProgram(_programId);
-			throw (std::invalid_argument(&errorMessage[0]));
-		}
+			GLint isLinked = 0;
+			GL_CALL(glGetProgramiv(_programId, GL_LINK_STATUS, &isLinked));
+			if (isLinked == GL_FALSE)
+			{
+				GLint maxLength = 0;
+				GL_CALL(glGetProgramiv(_programId, GL_INFO_LOG_LENGTH, &maxLength));
+
+				std::vector<char> errorMessage(maxLength + 1);
+				GL_CALL(glGetProgramInfoLog(_programId, maxLength, &maxLength, &errorMessage[0]));
+				deleteShaders();
+				glDeleteProgram(_programId);
+				_programId = 0;
+				throw (std::invalid_argument(&errorMessage[0]));
+			}
 
-		GL_CALL(glDetachShader(_programId, vertexShaderID));
-		GL_CALL(glDetachShader(_programId, fragmentShaderID));
+			deleteShaders();
+			ShaderCache::Get().store(_cacheKey, _programId);
+		}
 
-		GL_CALL(glDeleteShader(vertexShaderID));
-		GL_CALL(glDeleteShader(fragmentShaderID));
+		reflectUniforms();
 	}
 
-	void Shader::initialize(const std::vector<std::string>& shaderSource)
+	void Shader::bind(void) const
 	{
-		std::string vertexShaderCode;
-		std::string fragmentShaderCode;
-
-		// Read the shader file
-		loadShader(shaderSource, vertexShaderCode, fragmentShaderCode);
+		GLStateCache::Get().useProgram(_programId);
+	}
 
-		// Compile
-		unsigned int vertexShaderID = compileShader(vertexShaderCode, GL_VERTEX_SHADER);
-		unsigned int fragmentShaderID = compileShader(fragmentShaderCode, GL_FRAGMENT_SHADER);
+	void Shader::unbind(void) const
+	{
+		GLStateCache::Get().useProgram(0);
+	}
 
-		// Create the program
-		GL_CALL(_programId = glCreateProgram());
+	// Uniforms
+	int Shader::getUniformLocation(const std::string& name) const
+	{
+		std::unordered_map<std::string, GLint>::const_iterator iterator = _uniforms.find(name);
+		if (iterator == _uniforms.end())
+			return (-1);
+		return (iterator->second);
+	}
 
-		GL_CALL(glAttachShader(_programId, vertexShaderID));
-		GL_CALL(glAttachShader(_programId, fragmentShaderID));
-		GL_CALL(glLinkProgram(_programId));
+	void Shader::set(const UniformHandle<glm::mat4>& handle, const glm::mat4& value) const
+	{
+		if (handle.location >= 0)
+		{
+			GL_CALL(glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value)));
+			GLStateCache::Get().countUniformUpload();
+		}
+	}
 
-		GLint isLinked = 0;
-		GL_CALL(glGetProgramiv(_programId, GL_LINK_STATUS, &isLinked));
-		if (isLinked == GL_FALSE)
+	void Shader::set(const UniformHandle<glm::vec4>& handle, const glm::vec4& value) const
+	{
+		if (handle.location >= 0)
 		{
-			GLint maxLength = 0;
-			GL_CALL(glGetProgramiv(_programId, GL_INFO_LOG_LENGTH, &maxLength));
+			GL_CALL(glUniform4fv(handle.location, 1, &value[0]));
+			GLStateCache::Get().countUniformUpload();
+		}
+	}
 
-			std::vector<char> errorMessage(maxLength);
-			GL_CALL(glGetProgramInfoLog(_programId, maxLength, &maxLength, &errorMessage[0]));
-			glDeleteProgram(_programId);
-			throw (std::invalid_argument(&errorMessage[0]));
+	void Shader::set(const UniformHandle<glm::vec3>& handle, const glm::vec3& value) const
+	{
+		if (handle.location >= 0)
+		{
+			GL_CALL(glUniform3fv(handle.location, 1, &value[0]));
+			GLStateCache::Get().countUniformUpload();
 		}
+	}
 
-		GL_CALL(glDetachShader(_programId, vertexShaderID));
-		GL_CALL(glDetachShader(_programId, fragmentShaderID));
+	void Shader::set(const UniformHandle<glm::vec2>& handle, const glm::vec2& value) const
+	{
+		if (handle.location >= 0)
+		{
+			GL_CALL(glUniform2fv(handle.location, 1, &value[0]));
+			GLStateCache::Get().countUniformUpload();
+		}
+	}
 
-		GL_CALL(glDeleteShader(vertexShaderID));
-		GL_CALL(glDeleteShader(fragmentShaderID));
+	void Shader::set(const UniformHandle<float>& handle, float value) const
+	{
+		if (handle.location >= 0)
+		{
+			GL_CALL(glUniform1f(handle.location, value));
+			GLStateCache::Get().countUniformUpload();
+		}
 	}
 
-	void Shader::bind(void) const
+	void Shader::set(const UniformHandle<int>& handle, int value) const
 	{
-		GL_CALL(glUseProgram(_programId));
+		if (handle.location >= 0)
+		{
+			GL_CALL(glUniform1i(handle.location, value));
+			GLStateCache::Get().countUniformUpload();
+		}
 	}
 
-	void Shader::unbind(void) const
+	void Shader::bindUniformBlock(const std::string& name, unsigned int binding) const
 	{
-		GL_CALL(glUseProgram(0));
+		GLuint index;
+		GL_CALL(index = glGetUniformBlockIndex(_programId, name.c_str()));
+		if (index != GL_INVALID_INDEX)
+			GL_CALL(glUniformBlockBinding(_programId, index, binding));
 	}
 
 	// Setters
 	void Shader::setMat4(const std::string& name, const glm::mat4& value) const
 	{
-		GL_CALL(glUniformMatrix4fv(glGetUniformLocation(_programId, name.c_str()), 1, GL_FALSE, glm::value_ptr(value)));
+		GL_CALL(glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value)));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec4(const std::string& name, const glm::vec4& value) const
 	{
-		GL_CALL(glUniform4fv(glGetUniformLocation(_programId, name.c_str()), 1, &value[0]));
+		GL_CALL(glUniform4fv(getUniformLocation(name), 1, &value[0]));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const
 	{
-		GL_CALL(glUniform4f(glGetUniformLocation(_programId, name.c_str()), x, y, z, w));
+		GL_CALL(glUniform4f(getUniformLocation(name), x, y, z, w));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec3(const std::string& name, const glm::vec3& value) const
 	{
-		GL_CALL(glUniform3fv(glGetUniformLocation(_programId, name.c_str()), 1, &value[0]));
+		GL_CALL(glUniform3fv(getUniformLocation(name), 1, &value[0]));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec3(const std::string& name, float x, float y, float z) const
 	{
-		GL_CALL(glUniform3f(glGetUniformLocation(_programId, name.c_str()), x, y, z));
+		GL_CALL(glUniform3f(getUniformLocation(name), x, y, z));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec2(const std::string& name, const glm::vec2& value) const
 	{
-		GL_CALL(glUniform2fv(glGetUniformLocation(_programId, name.c_str()), 1, &value[0]));
+		GL_CALL(glUniform2fv(getUniformLocation(name), 1, &value[0]));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setVec2(const std::string& name, float x, float y) const
 	{
-		GL_CALL(glUniform2f(glGetUniformLocation(_programId, name.c_str()), x, y));
+		GL_CALL(glUniform2f(getUniformLocation(name), x, y));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setFloat(const std::string& name, const float& value) const
 	{
-		GL_CALL(glUniform1f(glGetUniformLocation(_programId, name.c_str()), value));
+		GL_CALL(glUniform1f(getUniformLocation(name), value));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	void Shader::setInt(const std::string& name, const int& value) const
 	{
-		GL_CALL(glUniform1i(glGetUniformLocation(_programId, name.c_str()), value));
+		GL_CALL(glUniform1i(getUniformLocation(name), value));
+		GLStateCache::Get().countUniformUpload();
 	}
 
 	// Getters
@@ -241,6 +307,29 @@ namespace ExoEngine {
 		}
 	}
 
+	void Shader::compileProgram(const std::string& vertexShaderCode, const std::string& fragmentShaderCode)
+	{
+		ShaderCache& cache = ShaderCache::Get();
+
+		// Binary linked by a previous run
+		_cacheKey = cache.getKey(vertexShaderCode, fragmentShaderCode);
+		if ((_programId = cache.load(_cacheKey)))
+			return;
+
+		// Nothing is checked here: with KHR_parallel_shader_compile the driver works until finishCompile asks
+		_vertexShaderId = compileShader(vertexShaderCode, GL_VERTEX_SHADER);
+		_fragmentShaderId = compileShader(fragmentShaderCode, GL_FRAGMENT_SHADER);
+
+		// Create the program
+		GL_CALL(_programId = glCreateProgram());
+		if (cache.isEnabled())
+			GL_CALL(glProgramParameteri(_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
+		GL_CALL(glAttachShader(_programId, _vertexShaderId));
+		GL_CALL(glAttachShader(_programId, _fragmentShaderId));
+		GL_CALL(glLinkProgram(_programId));
+	}
+
 	unsigned int Shader::compileShader(const std::string& shaderCode, const GLenum& type)
 	{
 		unsigned int shaderId = glCreateShader(type);
@@ -248,7 +337,11 @@ namespace ExoEngine {
 		GL_CALL(glShaderSource(shaderId, 1, &c_str, NULL));
 		GL_CALL(glCompileShader(shaderId));
 
-		// Check
+		return shaderId;
+	}
+
+	void Shader::checkShader(unsigned int shaderId)
+	{
 		GLint result = GL_FALSE;
 		int InfoLogLength;
 
@@ -258,10 +351,55 @@ namespace ExoEngine {
 		if (result != GL_TRUE) {
 			std::vector<char> VertexShaderErrorMessage(InfoLogLength + 1);
 			glGetShaderInfoLog(shaderId, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
+			deleteShaders();
+			glDeleteProgram(_programId);
+			_programId = 0;
 			throw (std::invalid_argument(&VertexShaderErrorMessage[0]));
 		}
+	}
 
-		return shaderId;
+	void Shader::deleteShaders(void)
+	{
+		GL_CALL(glDetachShader(_programId, _vertexShaderId));
+		GL_CALL(glDetachShader(_programId, _fragmentShaderId));
+
+		GL_CALL(glDeleteShader(_vertexShaderId));
+		GL_CALL(glDeleteShader(_fragmentShaderId));
+
+		_vertexShaderId = 0;
+		_fragmentShaderId = 0;
+	}
+
+	void Shader::reflectUniforms(void)
+	{
+		GLint count = 0;
+		GLint maxLength = 0;
+
+		_uniforms.clear();
+		GL_CALL(glGetProgramiv(_programId, GL_ACTIVE_UNIFORMS, &count));
+		GL_CALL(glGetProgramiv(_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+
+		std::vector<char> name(maxLength + 1);
+		for (GLint i = 0; i < count; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+
+			GL_CALL(glGetActiveUniform(_programId, (GLuint)i, maxLength + 1, &length, &size, &type, &name[0]));
+			std::string uniform(&name[0], length);
+
+			// Uniforms in a block have no location
+			GLint location;
+			GL_CALL(location = glGetUniformLocation(_programId, uniform.c_str()));
+			if (location < 0)
+				continue;
+
+			// Arrays are reported as "name[0]", register them under both names
+			_uniforms[uniform] = location;
+			if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+				_uniforms[uniform.substr(0, uniform.size() - 3)] = location;
+		}
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "ShaderCache.h"
+
+namespace ExoEngine {
+
+	// FNV-1a
+	static uint64_t hashString(const std::string& string, uint64_t hash)
+	{
+		for (unsigned char c : string)
+		{
+			hash ^= c;
+			hash *= 1099511628211ULL;
+		}
+		return (hash);
+	}
+
+	// Drain the error flags, true when one was set
+	static bool clearErrors(void)
+	{
+		bool error = false;
+
+		while (glGetError() != GL_NO_ERROR)
+			error = true;
+		return (error);
+	}
+
+	ShaderCache::ShaderCache(void)
+		: _queried(false), _supported(false), _hits(0), _misses(0)
+	{	}
+
+	ShaderCache::~ShaderCache(void)
+	{	}
+
+	void ShaderCache::setDirectory(const std::string& directory)
+	{
+		_directory = directory;
+		if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\')
+			_directory += '/';
+	}
+
+	bool ShaderCache::isEnabled(void)
+	{
+		queryDriver();
+		return (_supported && !_directory.empty());
+	}
+
+	uint64_t ShaderCache::getKey(const std::string& vertexShaderCode, const std::string& fragmentShaderCode)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+
+		queryDriver();
+		hash = hashString(_driver, hash);
+		hash = hashString(vertexShaderCode, hash);
+		hash = hashString("#FRAGMENT", hash);
+		return (hashString(fragmentShaderCode, hash));
+	}
+
+	GLuint ShaderCache::load(uint64_t key)
+	{
+		uint32_t header[2];
+		GLuint programId;
+		GLint isLinked = GL_FALSE;
+
+		if (!isEnabled())
+			return (0);
+
+		std::ifstream file(getPath(key), std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			_misses++;
+			return (0);
+		}
+
+		std::streamoff size = (std::streamoff)file.tellg() - (std::streamoff)sizeof(header);
+		std::vector<char> binary(size > 0 ? (size_t)size : 0);
+
+		file.seekg(0);
+		file.read((char*)header, sizeof(header));
+		file.read(binary.data(), binary.size());
+		if (!file || header[0] != SHADER_CACHE_MAGIC || binary.empty())
+		{
+			_misses++;
+			return (0);
+		}
+
+		GL_CALL(programId = glCreateProgram());
+
+		// Not through GL_CALL: a format the driver dropped raises GL_INVALID_ENUM, which is a rejection like a failed link
+		clearErrors();
+		glProgramBinary(programId, (GLenum)header[1], binary.data(), (GLsizei)binary.size());
+		bool rejected = clearErrors();
+		GL_CALL(glGetProgramiv(programId, GL_LINK_STATUS, &isLinked));
+
+		// Rejected (driver update not visible in the strings), compiled and saved again
+		if (rejected || isLinked == GL_FALSE)
+		{
+			glDeleteProgram(programId);
+			file.close();
+			std::remove(getPath(key).c_str());
+			_misses++;
+			return (0);
+		}
+
+		_hits++;
+		return (programId);
+	}
+
+	void ShaderCache::store(uint64_t key, GLuint programId)
+	{
+		uint32_t header[2];
+		GLint length = 0;
+		GLenum format = 0;
+
+		if (!isEnabled())
+			return;
+
+		GL_CALL(glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length));
+		if (length <= 0)
+			return;
+
+		std::vector<char> binary(length);
+		GL_CALL(glGetProgramBinary(programId, length, &length, &format, binary.data()));
+
+		// Written aside then renamed, a crash while writing never leaves a truncated binary
+		std::string path = getPath(key);
+		std::string temporaryPath = path + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return;
+
+			header[0] = SHADER_CACHE_MAGIC;
+			header[1] = (uint32_t)format;
+			file.write((const char*)header, sizeof(header));
+			file.write(binary.data(), length);
+			if (!file)
+			{
+				file.close();
+				std::remove(temporaryPath.c_str());
+				return;
+			}
+		}
+
+		std::remove(path.c_str());
+		std::rename(temporaryPath.c_str(), path.c_str());
+	}
+
+	// Getters
+	unsigned int ShaderCache::getHits(void) const
+	{
+		return (_hits);
+	}
+
+	unsigned int ShaderCache::getMisses(void) const
+	{
+		return (_misses);
+	}
+
+	// Private
+	void ShaderCache::queryDriver(void)
+	{
+		GLint formats = 0;
+
+		if (_queried)
+			return;
+		_queried = true;
+
+		// Vendor, renderer and version: a binary is only valid for the driver which produced it
+		for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+		{
+			const GLubyte* string = glGetString(name);
+			if (string)
+				_driver += (const char*)string;
+			_driver += '\n';
+		}
+
+#ifndef __APPLE__
+		if (!GLEW_ARB_get_program_binary)
+			return;
+#endif
+		GL_CALL(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+		_supported = (formats > 0);
+	}
+
+	std::string ShaderCache::getPath(uint64_t key) const
+	{
+		char name[17];
+
+		snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+		return (_directory + name + ".bin");
+	}
+
+}
\ No newline at end of file
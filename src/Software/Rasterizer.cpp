@@ -0,0 +1,356 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define EXO_RASTERIZER_SSE
+#endif
+
+#include "Software/Rasterizer.h"
+
+namespace ExoEngine {
+
+	Rasterizer::Rasterizer(void)
+		: _pixels(nullptr), _width(0), _height(0), _tilesX(0), _tilesY(0)
+	{	}
+
+	Rasterizer::~Rasterizer(void)
+	{	}
+
+	void Rasterizer::setTarget(uint8_t* pixels, int width, int height)
+	{
+		_pixels = pixels;
+		_width = width;
+		_height = height;
+
+		_tilesX = (width + RASTERIZER_TILE_SIZE - 1) / RASTERIZER_TILE_SIZE;
+		_tilesY = (height + RASTERIZER_TILE_SIZE - 1) / RASTERIZER_TILE_SIZE;
+		_bins.resize((size_t)_tilesX * _tilesY);
+	}
+
+	uint32_t Rasterizer::addState(const rasterState& state)
+	{
+		_states.push_back(state);
+		return ((uint32_t)_states.size() - 1);
+	}
+
+	size_t Rasterizer::reserveStates(size_t count)
+	{
+		size_t first = _states.size();
+		_states.resize(first + count);
+		return (first);
+	}
+
+	size_t Rasterizer::reserve(size_t count)
+	{
+		size_t first = _triangles.size();
+		_triangles.resize(first + count);
+		return (first);
+	}
+
+	void Rasterizer::setState(size_t index, const rasterState& state)
+	{
+		_states[index] = state;
+	}
+
+	void Rasterizer::setTriangle(size_t index, const rasterVertex& a, const rasterVertex& b, const rasterVertex& c, uint32_t state)
+	{
+		triangleSetup& triangle = _triangles[index];
+		const rasterState& rasterState = _states[state];
+		const rasterVertex* vertices[3] = { &a, &b, &c };
+
+		triangle.state = state;
+
+		// Bounds in the target and the scissor, an empty box is never binned; the far away
+		// coordinates are clamped before they become integers
+		float minX = std::max(std::min({ a.x, b.x, c.x }), -1.0f);
+		float minY = std::max(std::min({ a.y, b.y, c.y }), -1.0f);
+		float maxX = std::min(std::max({ a.x, b.x, c.x }), (float)_width + 1.0f);
+		float maxY = std::min(std::max({ a.y, b.y, c.y }), (float)_height + 1.0f);
+		triangle.minX = std::max({ 0, rasterState.scissor[0], (int)std::floor(minX) });
+		triangle.minY = std::max({ 0, rasterState.scissor[1], (int)std::floor(minY) });
+		triangle.maxX = std::min({ _width, rasterState.scissor[2], (int)std::ceil(maxX) });
+		triangle.maxY = std::min({ _height, rasterState.scissor[3], (int)std::ceil(maxY) });
+
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (!rasterState.texture.pixels || std::fabs(area) < 1e-8f || triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+		{
+			triangle.maxX = triangle.minX;
+			return;
+		}
+
+		// Both windings are drawn, the edges always turn the same way
+		if (area < 0.0f)
+		{
+			std::swap(vertices[1], vertices[2]);
+			area = -area;
+		}
+
+		triangle.inclusive = 0;
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const rasterVertex& from = *vertices[i];
+			const rasterVertex& to = *vertices[(i + 1) % 3];
+			float dx = to.x - from.x;
+			float dy = to.y - from.y;
+
+			// Edge i is 0 on the side from vertex i to i + 1 and positive inside
+			triangle.edgeA[i] = -dy;
+			triangle.edgeB[i] = dx;
+			triangle.edgeC[i] = dy * from.x - dx * from.y;
+
+			// Two triangles sharing an edge run it in opposite directions, only one of them owns its pixels
+			if (dy < 0.0f || (dy == 0.0f && dx > 0.0f))
+				triangle.inclusive |= 1u << i;
+		}
+
+		// Weight of a vertex: the edge facing it over the area
+		float inverse = 1.0f / area;
+		const float* edges[3] = { triangle.edgeA, triangle.edgeB, triangle.edgeC };
+		float* uPlane[3] = { &triangle.uA, &triangle.uB, &triangle.uC };
+		float* vPlane[3] = { &triangle.vA, &triangle.vB, &triangle.vC };
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			*uPlane[i] = (edges[i][1] * vertices[0]->u + edges[i][2] * vertices[1]->u + edges[i][0] * vertices[2]->u) * inverse;
+			*vPlane[i] = (edges[i][1] * vertices[0]->v + edges[i][2] * vertices[1]->v + edges[i][0] * vertices[2]->v) * inverse;
+		}
+	}
+
+	void Rasterizer::addTriangle(const rasterVertex& a, const rasterVertex& b, const rasterVertex& c, uint32_t state)
+	{
+		setTriangle(reserve(1), a, b, c, state);
+	}
+
+	void Rasterizer::flush(JobPool* pool)
+	{
+		if (_triangles.empty() || !_pixels)
+		{
+			_triangles.clear();
+			_states.clear();
+			return;
+		}
+
+		// Binned in the order of the triangles, each bin keeps the draw order
+		for (std::vector<uint32_t>& bin : _bins)
+			bin.clear();
+
+		for (size_t i = 0; i < _triangles.size(); i++)
+		{
+			const triangleSetup& triangle = _triangles[i];
+			if (triangle.minX >= triangle.maxX)
+				continue;
+
+			int tileMaxX = (triangle.maxX - 1) / RASTERIZER_TILE_SIZE;
+			int tileMaxY = (triangle.maxY - 1) / RASTERIZER_TILE_SIZE;
+			for (int y = triangle.minY / RASTERIZER_TILE_SIZE; y <= tileMaxY; y++)
+				for (int x = triangle.minX / RASTERIZER_TILE_SIZE; x <= tileMaxX; x++)
+					_bins[(size_t)y * _tilesX + x].push_back((uint32_t)i);
+		}
+
+		// Tiles do not overlap, no synchronization past the pool
+		if (pool)
+			pool->parallelFor(_bins.size(), 1, [this](size_t, size_t begin, size_t end) {
+				for (size_t tile = begin; tile < end; tile++)
+					rasterizeTile(tile);
+			});
+		else
+		{
+			for (size_t tile = 0; tile < _bins.size(); tile++)
+				rasterizeTile(tile);
+		}
+
+		_triangles.clear();
+		_states.clear();
+	}
+
+	// Getters
+	size_t Rasterizer::getTriangleCount(void) const
+	{
+		return (_triangles.size());
+	}
+
+	size_t Rasterizer::getTileCount(void) const
+	{
+		return (_bins.size());
+	}
+
+	rasterState Rasterizer::defaultState(void)
+	{
+		rasterState state;
+
+		state.texture = { nullptr, 0, 0 };
+		state.mode = RASTER_SPRITE;
+		state.color = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+		state.scissor[0] = 0;
+		state.scissor[1] = 0;
+		state.scissor[2] = std::numeric_limits<int>::max();
+		state.scissor[3] = std::numeric_limits<int>::max();
+		return (state);
+	}
+
+	// Private
+	void Rasterizer::rasterizeTile(size_t tile)
+	{
+		const std::vector<uint32_t>& bin = _bins[tile];
+		if (bin.empty())
+			return;
+
+		int tileX = (int)(tile % _tilesX) * RASTERIZER_TILE_SIZE;
+		int tileY = (int)(tile / _tilesX) * RASTERIZER_TILE_SIZE;
+		int tileMaxX = std::min(tileX + RASTERIZER_TILE_SIZE, _width);
+		int tileMaxY = std::min(tileY + RASTERIZER_TILE_SIZE, _height);
+
+		for (uint32_t index : bin)
+		{
+			const triangleSetup& triangle = _triangles[index];
+			rasterize(triangle, _states[triangle.state],
+				std::max(tileX, triangle.minX), std::max(tileY, triangle.minY),
+				std::min(tileMaxX, triangle.maxX), std::min(tileMaxY, triangle.maxY));
+		}
+	}
+
+	void Rasterizer::rasterize(const triangleSetup& triangle, const rasterState& state, int minX, int minY, int maxX, int maxY)
+	{
+#ifdef EXO_RASTERIZER_SSE
+		const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+		const __m128 zero = _mm_setzero_ps();
+		__m128 edgeA[3];
+		for (unsigned int i = 0; i < 3; i++)
+			edgeA[i] = _mm_set1_ps(triangle.edgeA[i]);
+		__m128 uA = _mm_set1_ps(triangle.uA);
+		__m128 vA = _mm_set1_ps(triangle.vA);
+		float u[4], v[4];
+#endif
+
+		for (int y = minY; y < maxY; y++)
+		{
+			float py = (float)y + 0.5f;
+			float edgeRow[3];
+			for (unsigned int i = 0; i < 3; i++)
+				edgeRow[i] = triangle.edgeB[i] * py + triangle.edgeC[i];
+			float uRow = triangle.uB * py + triangle.uC;
+			float vRow = triangle.vB * py + triangle.vC;
+			uint8_t* row = _pixels + ((size_t)y * _width) * 4;
+			int x = minX;
+
+#ifdef EXO_RASTERIZER_SSE
+			// Four pixels per step, only the covered ones are shaded
+			for (; x + 4 <= maxX; x += 4)
+			{
+				__m128 px = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+				__m128 inside = _mm_cmpeq_ps(zero, zero);
+
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					__m128 edge = _mm_add_ps(_mm_mul_ps(edgeA[i], px), _mm_set1_ps(edgeRow[i]));
+					inside = _mm_and_ps(inside, (triangle.inclusive & (1u << i)) ? _mm_cmpge_ps(edge, zero) : _mm_cmpgt_ps(edge, zero));
+				}
+
+				int mask = _mm_movemask_ps(inside);
+				if (!mask)
+					continue;
+
+				_mm_storeu_ps(u, _mm_add_ps(_mm_mul_ps(uA, px), _mm_set1_ps(uRow)));
+				_mm_storeu_ps(v, _mm_add_ps(_mm_mul_ps(vA, px), _mm_set1_ps(vRow)));
+				for (int lane = 0; lane < 4; lane++)
+					if (mask & (1 << lane))
+						shade(row + (size_t)(x + lane) * 4, state, u[lane], v[lane]);
+			}
+#endif
+
+			// Scalar tail, or every pixel without SSE
+			for (; x < maxX; x++)
+			{
+				float px = (float)x + 0.5f;
+				bool inside = true;
+
+				for (unsigned int i = 0; i < 3 && inside; i++)
+				{
+					float edge = triangle.edgeA[i] * px + edgeRow[i];
+					inside = (triangle.inclusive & (1u << i)) ? edge >= 0.0f : edge > 0.0f;
+				}
+
+				if (inside)
+					shade(row + (size_t)x * 4, state, triangle.uA * px + uRow, triangle.vA * px + vRow);
+			}
+		}
+	}
+
+	void Rasterizer::shade(uint8_t* pixel, const rasterState& state, float u, float v)
+	{
+		const rasterTexture& texture = state.texture;
+
+		// Nearest texel, repeated outside [0, 1] so the flipped sprites sample the mirrored texel
+		int x = (int)std::floor(u * texture.width) % texture.width;
+		int y = (int)std::floor(v * texture.height) % texture.height;
+		if (x < 0)
+			x += texture.width;
+		if (y < 0)
+			y += texture.height;
+		const uint8_t* texel = texture.pixels + ((size_t)y * texture.width + x) * 4;
+
+		int red, green, blue, alpha;
+		switch (state.mode)
+		{
+		case RASTER_SPRITE:
+			if (texel[3] < 26)	// 0.1
+				return;
+			red = texel[0];
+			green = texel[1];
+			blue = texel[2];
+			alpha = texel[3];
+			break;
+		case RASTER_GUI:
+			red = texel[0];
+			green = texel[1];
+			blue = texel[2];
+			alpha = texel[3] - (int)(state.color.a * 255.0f + 0.5f);
+			break;
+		default:
+			red = (int)(state.color.r * 255.0f + 0.5f);
+			green = (int)(state.color.g * 255.0f + 0.5f);
+			blue = (int)(state.color.b * 255.0f + 0.5f);
+			alpha = texel[0];
+			break;
+		}
+
+		if (alpha <= 0)
+			return;
+		if (alpha > 255)
+			alpha = 255;
+
+		// Source alpha, one minus source alpha; x / 255 rounded as (x + 128 + ((x + 128) >> 8)) >> 8
+		int inverse = 255 - alpha;
+		int channels[4] = { red, green, blue, alpha };
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			int value = channels[i] * alpha + pixel[i] * inverse + 128;
+			pixel[i] = (uint8_t)((value + (value >> 8)) >> 8);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,626 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include "Software/RendererSoftware.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ExoEngine {
+
+	void RendererSoftware::initialize(const std::string& title, const int width, const int height, const WindowMode& mode, bool resizable)
+	{
+		// Destroy if window already exist
+		if (_pWindow)
+			delete _pWindow;
+
+		_pWindow = new SoftwareWindow(title, width, height, mode, resizable);
+		resize();
+
+		// Renderers, recording only: the rasterizer draws what they produce
+		if (!_pGUIRenderer)
+			_pGUIRenderer = new GUIRenderer(this);
+		if (!_pTextRenderer)
+			_pTextRenderer = new TextRenderer();
+		if (!_pProfiler)
+			_pProfiler = new Profiler();
+
+		// Workers recording the frame then rasterizing the tiles
+		if (!_pJobPool)
+			_pJobPool = new JobPool();
+	}
+
+	void RendererSoftware::resize()
+	{
+		_UIScaleFactor = _pWindow->getWidth() / REFRENCE_RESOLUTION_WIDTH;
+
+		_perspective = glm::perspective(glm::radians(90.0f), (float)(_pWindow->getWidth() / _pWindow->getHeight()), 0.1f, 100.f);
+		_orthographic = glm::ortho(0.0f, (float)_pWindow->getWidth(), (float)_pWindow->getHeight(), 0.0f, 0.0f, 1.0f);
+	}
+
+	// Create
+	ICamera* RendererSoftware::createCamera(void)
+	{
+		return new Camera(_pWindow);
+	}
+
+	ITexture* RendererSoftware::createTexture(const std::string& filePath, TextureFilter)
+	{
+		// Sampled at the nearest texel whatever the filter
+		return (new SoftwareTexture(filePath));
+	}
+
+	ITexture* RendererSoftware::createTexture(unsigned int width, unsigned int height, TextureFormat, TextureFilter)
+	{
+		return (new SoftwareTexture(width, height));
+	}
+
+	IArrayTexture* RendererSoftware::createArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+	{
+		return (new SoftwareArrayTexture(width, height, textures, filter));
+	}
+
+	ITextureAtlas* RendererSoftware::createTextureAtlas(int, int, std::vector<std::string>& textures, TextureFilter)
+	{
+		return (new SoftwareTextureAtlas(textures));
+	}
+
+	IImage* RendererSoftware::createImage(const std::shared_ptr<ITexture>& texture)
+	{
+		return new Image(texture, _UIScaleFactor, _pWindow->getWidth(), _pWindow->getHeight());
+	}
+
+	IFrameBuffer* RendererSoftware::createFrameBuffer(void)
+	{
+		throw (std::runtime_error("frame buffers need the GPU, the software renderer only draws in its window"));
+	}
+
+	// Push
+	RenderHandle RendererSoftware::add(sprite& s)
+	{
+		uint32_t depth = _depth++ & 0xFFFFFF;
+		RenderHandle handle = _renderQueue.add(s, renderKey::make(s.zOrder, 0, 0, depth));
+
+		if (handle >= _depths.size())
+		{
+			_depths.resize(handle + 1);
+			_owners.resize(handle + 1);
+		}
+		_depths[handle] = depth;
+		_owners[handle] = &s;
+
+		_spriteHandles[&s] = handle;
+		return (handle);
+	}
+
+	void RendererSoftware::add(IWidget* widget)
+	{
+		widget->update(getMouse(), getKeyboard(), getNavigationType());
+
+		// Update
+		switch (widget->getType())
+		{
+			case IWidget::BUTTON: {
+				auto button = (Button*)widget;
+				if (button->getLabel())
+					add(button->getLabel());
+				break;
+			}
+			case IWidget::SELECT: {
+				auto select = (Select*)widget;
+				add(select->getLabel());
+				break;
+			}
+			case IWidget::INPUT: {
+				auto input = (Input*)widget;
+				add(input->getLabel());
+				break;
+			}
+			case IWidget::SPINNER: {
+				auto spinner = (Spinner*)widget;
+				spinner->update(_pWindow->getDelta());
+				break;
+			}
+			default: break;
+		}
+
+		// Push in renderer
+		_pGUIRenderer->add(widget);
+	}
+
+	void RendererSoftware::add(Label* label)
+	{
+		label->contextInfo(_UIScaleFactor, _pWindow->getWidth(), _pWindow->getHeight());
+		_pTextRenderer->add(label);
+	}
+
+	void RendererSoftware::add(TileMap*)
+	{
+		// Tile maps are drawn by their own GL buffers
+	}
+
+	void RendererSoftware::add(ParticleEmitter*)
+	{
+		// Particles are simulated and drawn on the GPU
+	}
+
+	void RendererSoftware::update(RenderHandle handle, const sprite& s)
+	{
+		_renderQueue.update(handle, s, renderKey::make(s.zOrder, 0, 0, _depths[handle]));
+	}
+
+	void RendererSoftware::remove(RenderHandle handle)
+	{
+		if (!_renderQueue.contains(handle))
+			return;
+
+		std::unordered_map<const sprite*, RenderHandle>::iterator iterator = _spriteHandles.find(_owners[handle]);
+		if (iterator != _spriteHandles.end() && iterator->second == handle)
+			_spriteHandles.erase(iterator);
+
+		_renderQueue.remove(handle);
+	}
+
+	void RendererSoftware::remove(sprite& s)
+	{
+		// The queue stores copies, find the handle from the address given to add
+		std::unordered_map<const sprite*, RenderHandle>::iterator iterator = _spriteHandles.find(&s);
+		if (iterator != _spriteHandles.end())
+			remove(iterator->second);
+	}
+
+	void RendererSoftware::remove(IWidget* widget)
+	{
+		// Update
+		switch (widget->getType())
+		{
+			case IWidget::BUTTON: {
+				auto button = (Button*)widget;
+				remove(button->getLabel());
+				break;
+			}
+			case IWidget::SELECT: {
+				auto select = (Select*)widget;
+				remove(select->getLabel());
+				break;
+			}
+			case IWidget::INPUT: {
+				auto input = (Input*)widget;
+				remove(input->getLabel());
+				break;
+			}
+			default: break;
+		}
+		// Push in renderer
+		_pGUIRenderer->remove(widget);
+	}
+
+	void RendererSoftware::remove(Label* label)
+	{
+		_pTextRenderer->remove(label);
+	}
+
+	void RendererSoftware::remove(TileMap*)
+	{	}
+
+	void RendererSoftware::remove(ParticleEmitter*)
+	{	}
+
+	void RendererSoftware::draw(void)
+	{
+		_flushes = 0;
+		_pProfiler->beginFrame();
+
+		// Text of the previous frames, before the labels are recorded
+		if (_pProfilerOverlay && _pProfiler->getFrameCount() % PROFILER_OVERLAY_INTERVAL == 0)
+			_pProfilerOverlay->setText(_pProfiler->getReport());
+
+		glm::mat4 view = _pCurrentCamera ? ((Camera*)_pCurrentCamera)->getLookAt() : glm::mat4(1.0f);
+
+		if (_pCurrentCamera && _pMousePicker)
+		{
+			ProfileScope scope(_pProfiler, PROFILE_MOUSE_PICKER);
+			_pMousePicker->update((Mouse*)&_mouse, _pWindow->getWidth(), _pWindow->getHeight(), view, _perspective);
+		}
+
+		// Record, the widgets and the labels are laid out in parallel
+		_pProfiler->begin(PROFILE_RECORD);
+		_pJobPool->run({
+			[this]() { _pGUIRenderer->record(); },
+			[this]() { _pTextRenderer->record(); }
+		});
+		_pProfiler->end(PROFILE_RECORD);
+
+		// Every pass is binned then rasterized by tiles, in the order of the GL passes
+		_rasterizer.setTarget(_pWindow->getPixels(), _pWindow->getContextWidth(), _pWindow->getContextHeight());
+
+		if (_pCurrentCamera)
+		{
+			ProfileScope scope(_pProfiler, PROFILE_OBJECTS);
+			drawSprites(_perspective * view);
+		}
+
+		_pProfiler->begin(PROFILE_GUI);
+		drawWidgets();
+		_pProfiler->end(PROFILE_GUI);
+
+		_pProfiler->begin(PROFILE_TEXT);
+		drawLabels(*_pTextRenderer, Rasterizer::defaultState().scissor);
+		_rasterizer.flush(_pJobPool);
+		_flushes++;
+		_pProfiler->end(PROFILE_TEXT);
+	}
+
+	void RendererSoftware::swap(void)
+	{
+		_mouse.updateLastBuffer();
+		_keyboard.updateLastBuffer();
+
+		_pWindow->handleEvents(_keyboard, _mouse);
+		if (_pCursor && _pCursor->getImage())
+			_pCursor->getImage()->setPosition((float)_mouse.x, (float)_mouse.y);
+
+		_pProfiler->begin(PROFILE_POST_PROCESSING);
+		_pWindow->swap();
+		_pWindow->clearScreen();
+		_pProfiler->end(PROFILE_POST_PROCESSING);
+		_pProfiler->endFrame();
+
+		_frameStats.record = _pProfiler->getCpuTime(PROFILE_RECORD);
+		_frameStats.tileMaps = 0.0;
+		_frameStats.sprites = _pProfiler->getCpuTime(PROFILE_OBJECTS);
+		_frameStats.particles = 0.0;
+		_frameStats.widgets = _pProfiler->getCpuTime(PROFILE_GUI);
+		_frameStats.text = _pProfiler->getCpuTime(PROFILE_TEXT);
+		_frameStats.postProcessing = _pProfiler->getCpuTime(PROFILE_POST_PROCESSING);
+		_frameStats.total = 0.0;
+		for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+			_frameStats.total += _pProfiler->getCpuTime((ProfileStage)stage);
+
+		// One rasterizer flush per pass stands for the draw calls, there is no GL state
+		_frameStats.drawCalls = _flushes;
+		_frameStats.stateChanges = 0;
+		_frameStats.stateChangesElided = 0;
+		_frameStats.uniformUploads = 0;
+	}
+
+	// Getters
+	IWindow* RendererSoftware::getWindow(void)
+	{
+		return _pWindow;
+	}
+
+	Keyboard* RendererSoftware::getKeyboard(void)
+	{
+		return &_keyboard;
+	}
+
+	Mouse* RendererSoftware::getMouse(void)
+	{
+		return &_mouse;
+	}
+
+	unsigned int RendererSoftware::getTime(void) const
+	{
+		return SDL_GetTicks();
+	}
+
+	Lighting* RendererSoftware::getLighting(void)
+	{
+		return (nullptr);
+	}
+
+	const particleStats& RendererSoftware::getParticleStats(void) const
+	{
+		return (_particleStats);
+	}
+
+	const frameStats& RendererSoftware::getFrameStats(void) const
+	{
+		return (_frameStats);
+	}
+
+	Profiler* RendererSoftware::getProfiler(void)
+	{
+		return (_pProfiler);
+	}
+
+	// Setters
+	void RendererSoftware::setCursor(ICursor* cursor)
+	{
+		if (_pCursor)
+			remove(_pCursor->getImage());
+
+		_pCursor = cursor;
+		if (_pCursor)
+			add(_pCursor->getImage());
+	}
+
+	void RendererSoftware::setMousePicker(MousePicker* picker)
+	{
+		_pMousePicker = picker;
+	}
+
+	void RendererSoftware::setAxis(Axis* axis)
+	{
+		_pAxis = axis;
+	}
+
+	void RendererSoftware::setGridEnable(bool)
+	{	}
+
+	void RendererSoftware::setCulling(bool, float)
+	{
+		// The triangles out of the frame are dropped by their bounds, nothing else to cull
+	}
+
+	void RendererSoftware::setLighting(bool)
+	{	}
+
+	void RendererSoftware::setParticleBudget(unsigned int)
+	{	}
+
+	void RendererSoftware::setTextureCompression(bool)
+	{	}
+
+	void RendererSoftware::setProfilerOverlay(const std::shared_ptr<Font>& font)
+	{
+		if (_pProfilerOverlay)
+		{
+			remove(_pProfilerOverlay);
+			delete _pProfilerOverlay;
+			_pProfilerOverlay = nullptr;
+		}
+		if (!font)
+			return;
+
+		_pProfilerOverlay = new Label();
+		_pProfilerOverlay->setFont(font);
+		_pProfilerOverlay->setLocalAnchor(AnchorPoint::TOP_LEFT);
+		_pProfilerOverlay->setFontScale(0.2f);
+		_pProfilerOverlay->setPosition(10.0f, 10.0f);
+		_pProfilerOverlay->setText(_pProfiler->getReport());
+		add(_pProfilerOverlay);
+	}
+
+	// Private
+	RendererSoftware::RendererSoftware(void)
+		: IRenderer(), _pWindow(nullptr), _depth(0), _pGUIRenderer(nullptr), _pTextRenderer(nullptr), _pProfiler(nullptr), _pProfilerOverlay(nullptr), _pJobPool(nullptr), _flushes(0), _pCursor(nullptr)
+	{
+		_particleStats = particleStats();
+		_frameStats = frameStats();
+	}
+
+	RendererSoftware::~RendererSoftware(void)
+	{
+		if (_pProfilerOverlay)
+			delete _pProfilerOverlay;
+
+		if (_pProfiler)
+			delete _pProfiler;
+
+		if (_pGUIRenderer)
+			delete _pGUIRenderer;
+
+		if (_pTextRenderer)
+			delete _pTextRenderer;
+
+		if (_pJobPool)
+			delete _pJobPool;
+
+		if (_pWindow)
+			delete _pWindow;
+	}
+
+	void RendererSoftware::drawSprites(const glm::mat4& viewProjection)
+	{
+		// Unit quad of the sprite shader: corner then uv, the top left texel at the top left
+		static const float corners[4][4] = {
+			{ -0.5f,  0.5f, 0.0f, 0.0f },
+			{ -0.5f, -0.5f, 0.0f, 1.0f },
+			{  0.5f, -0.5f, 1.0f, 1.0f },
+			{  0.5f,  0.5f, 1.0f, 0.0f }
+		};
+
+		if (_renderQueue.empty())
+			return;
+
+		const std::vector<renderEntry>& entries = _renderQueue.sort();
+		size_t states = _rasterizer.reserveStates(entries.size());
+		size_t triangles = _rasterizer.reserve(entries.size() * 2);
+		float time = getTime() / 1000.0f;
+		float width = (float)_pWindow->getContextWidth();
+		float height = (float)_pWindow->getContextHeight();
+
+		// Each sprite has its state and two triangles at its rank, the jobs fill distinct ones
+		_pJobPool->parallelFor(entries.size(), SOFTWARE_SPRITE_GRAIN, [&](size_t, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				const sprite& s = _renderQueue[entries[i].index];
+				const SoftwareArrayTexture* texture = (const SoftwareArrayTexture*)s.texture.get();
+				const animationClip* clip = s.animation.get();
+				rasterState state = Rasterizer::defaultState();
+
+				// Frame of the clip, as the vertex shader picks it
+				float layer = (float)s.layer;
+				if (clip && clip->frameCount > 0)
+				{
+					float frame = std::floor(std::max(time - s.animationStart, 0.0f) / std::max(clip->frameDuration, 0.0001f));
+					layer += clip->loop ? std::fmod(frame, (float)clip->frameCount) : std::min(frame, (float)clip->frameCount - 1.0f);
+				}
+
+				rasterVertex vertices[4];
+				float c = std::cos(s.angle);
+				float sn = std::sin(s.angle);
+				bool visible = texture != nullptr;
+				for (unsigned int k = 0; k < 4; k++)
+				{
+					float x = corners[k][0] * s.scale.x;
+					float y = corners[k][1] * s.scale.y;
+					glm::vec4 position = viewProjection * glm::vec4(x * c - y * sn + s.position.x, x * sn + y * c + s.position.y, 0.0f, 1.0f);
+
+					if (position.w <= 0.0f)
+						visible = false;
+
+					// Flipped sprites sample the mirrored texel, the coordinates wrap
+					vertices[k].x = (position.x / position.w * 0.5f + 0.5f) * width;
+					vertices[k].y = (0.5f - position.y / position.w * 0.5f) * height;
+					vertices[k].u = corners[k][2] * (s.flip == HORIZONTAL ? -1.0f : 1.0f);
+					vertices[k].v = corners[k][3] * (s.flip == VERTICAL ? -1.0f : 1.0f);
+				}
+
+				// Without pixels the triangles are never binned
+				if (visible)
+					state.texture = { texture->getLayer((int)layer), texture->getWidth(), texture->getHeight() };
+				_rasterizer.setState(states + i, state);
+				_rasterizer.setTriangle(triangles + i * 2, vertices[0], vertices[1], vertices[2], (uint32_t)(states + i));
+				_rasterizer.setTriangle(triangles + i * 2 + 1, vertices[0], vertices[2], vertices[3], (uint32_t)(states + i));
+			}
+		});
+
+		_rasterizer.flush(_pJobPool);
+		_flushes++;
+	}
+
+	void RendererSoftware::drawWidgets(void)
+	{
+		const GUIBatch& batch = _pGUIRenderer->getBatch();
+		const std::vector<float>& vertices = batch.getVertices();
+		const std::vector<guiRun>& runs = batch.getRuns();
+		float height = (float)_pWindow->getContextHeight();
+
+		// Scissors of the views being drawn, the frame at the bottom
+		std::vector<glm::ivec4> scissors;
+		const int* frame = Rasterizer::defaultState().scissor;
+		scissors.push_back(glm::ivec4(frame[0], frame[1], frame[2], frame[3]));
+
+		for (const GUIRenderer::guiCommand& command : _pGUIRenderer->getCommands())
+		{
+			switch (command.type)
+			{
+			case GUIRenderer::guiCommand::QUADS:
+				for (size_t i = command.first; i < command.last; i++)
+				{
+					rasterState state = Rasterizer::defaultState();
+					state.texture = getTexture(runs[i].texture);
+					state.mode = RASTER_GUI;
+					for (unsigned int k = 0; k < 4; k++)
+						state.scissor[k] = scissors.back()[k];
+
+					// Five floats per vertex: x y u v opacity, the opacity of a widget is the same on its quads
+					uint32_t current = 0;
+					for (size_t v = runs[i].first; v + 3 <= runs[i].first + runs[i].count; v += 3)
+					{
+						const float* vertex = &vertices[v * 5];
+						if (v == runs[i].first || vertex[4] != state.color.a)
+						{
+							state.color.a = vertex[4];
+							current = _rasterizer.addState(state);
+						}
+						_rasterizer.addTriangle({ vertex[0], vertex[1], vertex[2], vertex[3] },
+							{ vertex[5], vertex[6], vertex[7], vertex[8] },
+							{ vertex[10], vertex[11], vertex[12], vertex[13] }, current);
+					}
+				}
+				break;
+			case GUIRenderer::guiCommand::BEGIN_SCISSOR: {
+				// Rectangles of the GL scissor, from the bottom of the frame, clamped to the parent view
+				glm::vec2 position = command.position;
+				glm::vec2 size = command.size;
+				glm::vec2 parentPosition = command.parentPosition;
+				glm::vec2 parentSize = command.parentSize;
+
+				if (parentPosition.x != 0 && parentPosition.y != 0 && parentSize.x != 0 && parentSize.y != 0)
+				{
+					glm::vec2 end = glm::min(position + size, parentPosition + parentSize);
+					position = glm::max(position, parentPosition);
+					size = end - position;
+				}
+
+				glm::ivec4 rectangle((int)position.x, (int)(height - (position.y + size.y)), (int)(position.x + size.x), (int)(height - position.y));
+				const glm::ivec4& parent = scissors.back();
+				scissors.push_back(glm::ivec4(std::max(rectangle.x, parent.x), std::max(rectangle.y, parent.y), std::min(rectangle.z, parent.z), std::min(rectangle.w, parent.w)));
+				break;
+			}
+			case GUIRenderer::guiCommand::END_SCISSOR:
+				if (scissors.size() > 1)
+					scissors.pop_back();
+				break;
+			case GUIRenderer::guiCommand::LABELS: {
+				_viewTextRenderer.clear();
+				for (Label* label : _pGUIRenderer->getLabels(command.first))
+					_viewTextRenderer.add(label);
+				_viewTextRenderer.record();
+
+				int scissor[4] = { scissors.back().x, scissors.back().y, scissors.back().z, scissors.back().w };
+				drawLabels(_viewTextRenderer, scissor);
+				break;
+			}
+			}
+		}
+
+		_rasterizer.flush(_pJobPool);
+		_flushes++;
+	}
+
+	void RendererSoftware::drawLabels(const TextRenderer& textRenderer, const int scissor[4])
+	{
+		const std::vector<float>& vertices = textRenderer.getVertices();
+
+		for (const TextRenderer::textBatch& batch : textRenderer.getBatches())
+		{
+			rasterState state = Rasterizer::defaultState();
+			state.texture = getTexture(batch.texture);
+			state.mode = RASTER_TEXT;
+			for (unsigned int k = 0; k < 4; k++)
+				state.scissor[k] = scissor[k];
+
+			// Seven floats per vertex: x y u v r g b, the color of a label is the same on its glyphs
+			uint32_t current = 0;
+			for (size_t v = batch.first; v + 3 <= batch.first + batch.count; v += 3)
+			{
+				const float* vertex = &vertices[v * 7];
+				glm::vec3 color(vertex[4], vertex[5], vertex[6]);
+				if (v == batch.first || color != glm::vec3(state.color))
+				{
+					state.color = glm::vec4(color, 0.0f);
+					current = _rasterizer.addState(state);
+				}
+				_rasterizer.addTriangle({ vertex[0], vertex[1], vertex[2], vertex[3] },
+					{ vertex[7], vertex[8], vertex[9], vertex[10] },
+					{ vertex[14], vertex[15], vertex[16], vertex[17] }, current);
+			}
+		}
+	}
+
+	rasterTexture RendererSoftware::getTexture(const ITexture* texture)
+	{
+		// Every texture of this renderer is a SoftwareTexture
+		const SoftwareTexture* softwareTexture = dynamic_cast<const SoftwareTexture*>(texture);
+		if (!softwareTexture || softwareTexture->getWidth() <= 0 || softwareTexture->getHeight() <= 0)
+			return { nullptr, 0, 0 };
+		return { softwareTexture->getPixels(), softwareTexture->getWidth(), softwareTexture->getHeight() };
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <stdexcept>
+
+#include "Software/SoftwareArrayTexture.h"
+#include "Software/SoftwareTexture.h"
+
+namespace ExoEngine {
+
+	SoftwareArrayTexture::SoftwareArrayTexture(void)
+		: _width(0), _height(0), _layers(0)
+	{	}
+
+	SoftwareArrayTexture::SoftwareArrayTexture(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+		: SoftwareArrayTexture()
+	{
+		initialize(width, height, textures, filter);
+	}
+
+	SoftwareArrayTexture::~SoftwareArrayTexture(void)
+	{	}
+
+	void SoftwareArrayTexture::initialize(int width, int height, std::vector<std::string>& textures, TextureFilter)
+	{
+		if (textures.size() <= 0)
+			throw (std::invalid_argument("cannot create ArrayTexture, number of images insufficient."));
+		if (width <= 0 || height <= 0)
+			throw (std::invalid_argument("cannot create ArrayTexture, invalid layer size."));
+
+		_width = width;
+		_height = height;
+		_layers = (int)textures.size();
+		_pixels.resize((size_t)width * height * 4 * _layers);
+
+		std::vector<uint8_t> image;
+		int imageWidth, imageHeight;
+		for (int i = 0; i < _layers; i++)
+		{
+			SoftwareTexture::load(textures[i], image, imageWidth, imageHeight);
+			SoftwareTexture::resize(image, imageWidth, imageHeight, &_pixels[(size_t)width * height * 4 * i], width, height);
+		}
+	}
+
+	void SoftwareArrayTexture::bind(int) const
+	{	}
+
+	void SoftwareArrayTexture::unbind(void) const
+	{	}
+
+	// Getters
+	int SoftwareArrayTexture::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int SoftwareArrayTexture::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	int SoftwareArrayTexture::getLayerCount(void) const
+	{
+		return (_layers);
+	}
+
+	const uint8_t* SoftwareArrayTexture::getLayer(int layer) const
+	{
+		if (!_layers)
+			return (nullptr);
+
+		if (layer < 0)
+			layer = 0;
+		else if (layer >= _layers)
+			layer = _layers - 1;
+		return (&_pixels[(size_t)_width * _height * 4 * layer]);
+	}
+
+}
\ No newline at end of file
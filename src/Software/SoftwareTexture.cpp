@@ -0,0 +1,124 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <SDL2/SDL_image.h>
+#include <atomic>
+#include <cstring>
+
+#include "Software/SoftwareTexture.h"
+#include "SDLException.h"
+
+namespace ExoEngine {
+
+	// GUIBatch merges the runs of a same engine id
+	static std::atomic<int> nextTextureId(1);
+
+	SoftwareTexture::SoftwareTexture(const std::string& filePath)
+		: _id(nextTextureId++), _width(0), _height(0)
+	{
+		load(filePath, _pixels, _width, _height);
+	}
+
+	SoftwareTexture::SoftwareTexture(unsigned int width, unsigned int height, const void* pixels)
+		: _id(nextTextureId++), _width((int)width), _height((int)height), _pixels((size_t)width * height * 4, 0)
+	{
+		if (pixels)
+			std::memcpy(_pixels.data(), pixels, _pixels.size());
+	}
+
+	SoftwareTexture::~SoftwareTexture(void)
+	{	}
+
+	void SoftwareTexture::bind(int) const
+	{	}
+
+	void SoftwareTexture::unbind(void) const
+	{	}
+
+	// Getters
+	int SoftwareTexture::getEngineId(void) const
+	{
+		return (_id);
+	}
+
+	int SoftwareTexture::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int SoftwareTexture::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	const uint8_t* SoftwareTexture::getPixels(void) const
+	{
+		return (_pixels.data());
+	}
+
+	void SoftwareTexture::load(const std::string& filePath, std::vector<uint8_t>& pixels, int& width, int& height)
+	{
+		SDL_Surface* image = IMG_Load(filePath.c_str());
+
+		if (!image)
+		{
+			width = 1;
+			height = 1;
+			pixels = { 255, 0, 255, 255 };
+			return;
+		}
+
+		// Byte order R G B A whatever the endianness, palettes and gray images expanded
+		SDL_Surface* converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(image);
+		if (!converted)
+			throw (SDLException());
+
+		width = converted->w;
+		height = converted->h;
+		pixels.resize((size_t)width * height * 4);
+
+		SDL_LockSurface(converted);
+		for (int y = 0; y < height; y++)
+			std::memcpy(&pixels[(size_t)y * width * 4], (const uint8_t*)converted->pixels + (size_t)y * converted->pitch, (size_t)width * 4);
+		SDL_UnlockSurface(converted);
+		SDL_FreeSurface(converted);
+	}
+
+	void SoftwareTexture::resize(const std::vector<uint8_t>& source, int sourceWidth, int sourceHeight, uint8_t* destination, int width, int height)
+	{
+		if (sourceWidth == width && sourceHeight == height)
+		{
+			std::memcpy(destination, source.data(), (size_t)width * height * 4);
+			return;
+		}
+
+		for (int y = 0; y < height; y++)
+		{
+			const uint8_t* row = &source[(size_t)(y * sourceHeight / height) * sourceWidth * 4];
+			for (int x = 0; x < width; x++)
+				std::memcpy(destination + ((size_t)y * width + x) * 4, row + (size_t)(x * sourceWidth / width) * 4, 4);
+		}
+	}
+
+}
\ No newline at end of file
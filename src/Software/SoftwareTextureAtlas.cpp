@@ -0,0 +1,57 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <stdexcept>
+
+#include "Software/SoftwareTextureAtlas.h"
+
+namespace ExoEngine {
+
+	SoftwareTextureAtlas::SoftwareTextureAtlas(std::vector<std::string>& textures)
+	{
+		for (const std::string& path : textures)
+			_textures.push_back(std::shared_ptr<ITexture>(new SoftwareTexture(path)));
+	}
+
+	SoftwareTextureAtlas::~SoftwareTextureAtlas(void)
+	{	}
+
+	// Getters
+	const std::shared_ptr<ITexture>& SoftwareTextureAtlas::getTexture(size_t index) const
+	{
+		if (index >= _textures.size())
+			throw (std::out_of_range("atlas texture index out of range"));
+		return (_textures[index]);
+	}
+
+	size_t SoftwareTextureAtlas::size(void) const
+	{
+		return (_textures.size());
+	}
+
+	size_t SoftwareTextureAtlas::getPageCount(void) const
+	{
+		return (_textures.size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+#include <SDL2/SDL_image.h>
+#include <cstring>
+
+#include "Software/SoftwareWindow.h"
+#include "SDLException.h"
+
+namespace ExoEngine {
+
+	SoftwareWindow::SoftwareWindow(const std::string& title, uint32_t width, uint32_t height, const WindowMode& mode, bool resizable)
+		: IWindow(), _window(nullptr)
+	{
+		initialize(title, width, height, mode, resizable);
+	}
+
+	SoftwareWindow::~SoftwareWindow(void)
+	{
+		if (_window)
+			SDL_DestroyWindow(_window);
+		IMG_Quit();
+		SDL_Quit();
+	}
+
+	void SoftwareWindow::initialize(const std::string& title, uint32_t width, uint32_t height, const WindowMode& mode, bool resizable)
+	{
+		_width = width;
+		_height = height;
+
+		_contextWidth = width;
+		_contextHeight = height;
+		_highDPIFactor = 1;
+		_windowMode = mode;
+
+		if (_windowMode == WindowMode::HEADLESS)
+		{
+			// Timers, signals and images, no video subsystem
+			if (!(SDL_WasInit(SDL_INIT_EVENTS) & SDL_INIT_EVENTS))
+				if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS))
+					throw (SDLException());
+		}
+		else
+		{
+			if (!(SDL_WasInit(SDL_INIT_EVERYTHING) & SDL_INIT_VIDEO))
+				if (SDL_Init(SDL_INIT_EVERYTHING))
+					throw (SDLException());
+
+			auto windowModeFlag = 0;
+			if (_windowMode == WindowMode::FULLSCREEN)
+				windowModeFlag = SDL_WINDOW_FULLSCREEN;
+			else if (_windowMode == WindowMode::BORDERLESS)
+				windowModeFlag = SDL_WINDOW_FULLSCREEN_DESKTOP;
+
+			if (resizable)
+				windowModeFlag += SDL_WINDOW_RESIZABLE;
+
+			// Presented through the window surface, without any GL context
+			if (!(_window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, windowModeFlag)))
+			{
+				SDL_Quit();
+				throw (SDLException());
+			}
+			SDL_ShowCursor(SDL_DISABLE); // Disable cursor
+
+			SDL_GetWindowSize(_window, &_width, &_height);
+			_contextWidth = _width;
+			_contextHeight = _height;
+		}
+
+		IMG_Init(IMG_INIT_PNG);
+		IMG_Init(IMG_INIT_JPG);
+
+		_pixels.assign((size_t)_contextWidth * _contextHeight * 4, 0);
+		_presented.assign(_pixels.size(), 0);
+
+		_now = SDL_GetPerformanceCounter();
+		_last = _now;
+	}
+
+	void SoftwareWindow::handleEvents(Keyboard& keyboard, Mouse& mouse)
+	{
+		while (SDL_PollEvent(&_event))
+		{
+			switch (_event.type)
+			{
+			case SDL_QUIT:
+				_close = true;
+				break;
+			case SDL_KEYDOWN:
+				keyboard.keyDown(keyboard.getKeyboardInput(_event.key.keysym.sym));
+				break;
+			case SDL_KEYUP:
+				keyboard.keyUp(keyboard.getKeyboardInput(_event.key.keysym.sym));
+				break;
+			case SDL_MOUSEBUTTONDOWN:
+				mouse.keyDown(mouse.getMouseInput(_event.button.button));
+				break;
+			case SDL_MOUSEBUTTONUP:
+				mouse.keyUp(mouse.getMouseInput(_event.button.button));
+				break;
+			case SDL_MOUSEWHEEL:
+				mouse.wheelX = _event.wheel.x;
+				mouse.wheelY = _event.wheel.y;
+				break;
+			case SDL_MOUSEMOTION:
+				mouse.x = _event.motion.x;
+				mouse.y = _event.motion.y;
+				break;
+			}
+		}
+	}
+
+	void SoftwareWindow::clearScreen(void)
+	{
+		static const uint8_t black[4] = { 0, 0, 0, 255 };
+
+		_last = _now;
+		_now = SDL_GetPerformanceCounter();
+
+		// Opaque black, like the scene frame buffer
+		for (size_t i = 0; i < _pixels.size(); i += 4)
+			std::memcpy(&_pixels[i], black, 4);
+	}
+
+	void SoftwareWindow::swap(void)
+	{
+		_presented.swap(_pixels);
+		present();
+	}
+
+	void SoftwareWindow::present(void)
+	{
+		if (!_window)
+			return;
+
+		SDL_Surface* surface = SDL_GetWindowSurface(_window);
+		if (!surface || surface->w != _contextWidth || surface->h != _contextHeight)
+			return;
+
+		if (SDL_MUSTLOCK(surface))
+			SDL_LockSurface(surface);
+		SDL_ConvertPixels(_contextWidth, _contextHeight, SDL_PIXELFORMAT_RGBA32, _presented.data(), _contextWidth * 4,
+			surface->format->format, surface->pixels, surface->pitch);
+		if (SDL_MUSTLOCK(surface))
+			SDL_UnlockSurface(surface);
+		SDL_UpdateWindowSurface(_window);
+	}
+
+	// Setters
+	void SoftwareWindow::isCursorVisible(bool visible)
+	{
+		if (_window)
+			SDL_ShowCursor(visible);
+	}
+
+	void SoftwareWindow::setWindowSize(int w, int h)
+	{
+		if (_window)
+			SDL_SetWindowSize(_window, w, h);
+		_width = w;
+		_height = h;
+		_contextWidth = w;
+		_contextHeight = h;
+
+		_pixels.assign((size_t)w * h * 4, 0);
+		_presented.assign(_pixels.size(), 0);
+	}
+
+	void SoftwareWindow::setWindowMode(const WindowMode& mode)
+	{
+		// A headless window stays headless
+		if (!_window)
+			return;
+
+		int error = 0;
+		switch (mode)
+		{
+		case WindowMode::FULLSCREEN:
+			error = SDL_SetWindowFullscreen(_window, SDL_WINDOW_FULLSCREEN);
+			break;
+		case WindowMode::BORDERLESS:
+			error = SDL_SetWindowFullscreen(_window, SDL_WINDOW_FULLSCREEN_DESKTOP);
+			break;
+		default: // Windowed
+			error = SDL_SetWindowFullscreen(_window, 0);
+			break;
+		}
+		_windowMode = mode;
+
+		// Check error
+		if (error == -1)
+			throw (SDLException());
+
+		int w, h;
+		SDL_GetWindowSize(_window, &w, &h);
+		setWindowSize(w, h);
+	}
+
+	void SoftwareWindow::setVsync(bool)
+	{
+		// Window surfaces are not synchronized
+	}
+
+	// Post processing
+	void SoftwareWindow::addPostProcess(const std::string&, const std::string&)
+	{	}
+
+	void SoftwareWindow::removePostProcess(const std::string&)
+	{	}
+
+	void SoftwareWindow::setPostProcessEnabled(const std::string&, bool)
+	{	}
+
+	void SoftwareWindow::setResolutionScale(float)
+	{	}
+
+	void SoftwareWindow::setFrameTimeTarget(double)
+	{	}
+
+	float SoftwareWindow::getResolutionScale(void) const
+	{
+		return (1.0f);
+	}
+
+	// Getters
+	void* SoftwareWindow::getWindowID()
+	{
+		return (_window);
+	}
+
+	void* SoftwareWindow::getGLContext()
+	{
+		return (nullptr);
+	}
+
+	double SoftwareWindow::getDelta(void) const
+	{
+		return (double)((_now - _last) * 1000 / (double)SDL_GetPerformanceFrequency());
+	}
+
+	float SoftwareWindow::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	float SoftwareWindow::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	int SoftwareWindow::getContextWidth(void) const
+	{
+		return (_contextWidth);
+	}
+
+	int SoftwareWindow::getContextHeight(void) const
+	{
+		return (_contextHeight);
+	}
+
+	int SoftwareWindow::getHighDPIFactor(void) const
+	{
+		return (_highDPIFactor);
+	}
+
+	bool SoftwareWindow::isFullscreen(void) const
+	{
+		return (_windowMode == WindowMode::FULLSCREEN);
+	}
+
+	bool SoftwareWindow::getIsClosing(void) const
+	{
+		return (_close);
+	}
+
+	IFrameBuffer* SoftwareWindow::getFrameBuffer(void) const
+	{
+		return (nullptr);
+	}
+
+	void SoftwareWindow::readPixels(std::vector<uint8_t>& pixels) const
+	{
+		pixels = _presented;
+	}
+
+	uint8_t* SoftwareWindow::getPixels(void)
+	{
+		return (_pixels.data());
+	}
+
+}
\ No newline at end of file
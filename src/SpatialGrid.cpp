@@ -0,0 +1,194 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "SpatialGrid.h"
+
+namespace ExoEngine {
+
+	SpatialGrid::SpatialGrid(float cellSize)
+		: _cellSize(cellSize), _stamp(0)
+	{
+		if (cellSize <= 0.0f)
+			throw (std::invalid_argument("SpatialGrid cannot have a null cell size"));
+	}
+
+	SpatialGrid::~SpatialGrid(void)
+	{	}
+
+	void SpatialGrid::insert(uint32_t id, const glm::vec2& min, const glm::vec2& max)
+	{
+		if (id >= _ranges.size())
+		{
+			_ranges.resize(id + 1, { 0, 0, -1, -1, false });
+			_stamps.resize(id + 1, 0);
+		}
+		else if (_ranges[id].used)
+			removeFromCells(id, _ranges[id]);
+
+		cellRange range = makeRange(min, max);
+		for (int y = range.y0; y <= range.y1; y++)
+			for (int x = range.x0; x <= range.x1; x++)
+				_cells[cellKey(x, y)].push_back(id);
+
+		_ranges[id] = range;
+	}
+
+	void SpatialGrid::update(uint32_t id, const glm::vec2& min, const glm::vec2& max)
+	{
+		if (id < _ranges.size() && _ranges[id].used)
+		{
+			// Most updates stay in the same cells
+			cellRange range = makeRange(min, max);
+			const cellRange& current = _ranges[id];
+			if (range.x0 == current.x0 && range.y0 == current.y0 && range.x1 == current.x1 && range.y1 == current.y1)
+				return;
+		}
+		insert(id, min, max);
+	}
+
+	void SpatialGrid::remove(uint32_t id)
+	{
+		if (id >= _ranges.size() || !_ranges[id].used)
+			return;
+
+		removeFromCells(id, _ranges[id]);
+		_ranges[id].used = false;
+	}
+
+	void SpatialGrid::clear(void)
+	{
+		_cells.clear();
+		_ranges.clear();
+		_stamps.clear();
+		_stamp = 0;
+	}
+
+	void SpatialGrid::query(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t>& result)
+	{
+		cellRange range = makeRange(min, max);
+
+		// A new stamp per query avoids clearing the visited flags
+		if (++_stamp == 0)
+		{
+			std::fill(_stamps.begin(), _stamps.end(), 0);
+			_stamp = 1;
+		}
+
+		double area = ((double)range.x1 - range.x0 + 1) * ((double)range.y1 - range.y0 + 1);
+		if (area > (double)_cells.size())
+		{
+			// Zoomed out further than the populated cells, walk the cells instead of the area
+			for (const std::pair<const uint64_t, std::vector<uint32_t>>& cell : _cells)
+			{
+				int x = (int)(int32_t)(uint32_t)(cell.first >> 32);
+				int y = (int)(int32_t)(uint32_t)(cell.first & 0xFFFFFFFF);
+				if (x < range.x0 || x > range.x1 || y < range.y0 || y > range.y1)
+					continue;
+
+				for (uint32_t id : cell.second)
+				{
+					if (_stamps[id] != _stamp)
+					{
+						_stamps[id] = _stamp;
+						result.push_back(id);
+					}
+				}
+			}
+			return;
+		}
+
+		for (int y = range.y0; y <= range.y1; y++)
+		{
+			for (int x = range.x0; x <= range.x1; x++)
+			{
+				std::unordered_map<uint64_t, std::vector<uint32_t>>::const_iterator cell = _cells.find(cellKey(x, y));
+				if (cell == _cells.end())
+					continue;
+
+				for (uint32_t id : cell->second)
+				{
+					if (_stamps[id] != _stamp)
+					{
+						_stamps[id] = _stamp;
+						result.push_back(id);
+					}
+				}
+			}
+		}
+	}
+
+	// Getters
+	float SpatialGrid::getCellSize(void) const
+	{
+		return (_cellSize);
+	}
+
+	// Private
+	uint64_t SpatialGrid::cellKey(int x, int y)
+	{
+		return (((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y);
+	}
+
+	SpatialGrid::cellRange SpatialGrid::makeRange(const glm::vec2& min, const glm::vec2& max) const
+	{
+		static const float limit = 1.0e9f;
+
+		cellRange range = {
+			(int)std::floor(std::max(-limit, std::min(limit, min.x / _cellSize))),
+			(int)std::floor(std::max(-limit, std::min(limit, min.y / _cellSize))),
+			(int)std::floor(std::max(-limit, std::min(limit, max.x / _cellSize))),
+			(int)std::floor(std::max(-limit, std::min(limit, max.y / _cellSize))),
+			true
+		};
+		return (range);
+	}
+
+	void SpatialGrid::removeFromCells(uint32_t id, const cellRange& range)
+	{
+		for (int y = range.y0; y <= range.y1; y++)
+		{
+			for (int x = range.x0; x <= range.x1; x++)
+			{
+				std::unordered_map<uint64_t, std::vector<uint32_t>>::iterator cell = _cells.find(cellKey(x, y));
+				if (cell == _cells.end())
+					continue;
+
+				std::vector<uint32_t>& ids = cell->second;
+				std::vector<uint32_t>::iterator it = std::find(ids.begin(), ids.end(), id);
+				if (it != ids.end())
+				{
+					*it = ids.back();
+					ids.pop_back();
+				}
+				if (ids.empty())
+					_cells.erase(cell);
+			}
+		}
+	}
+
+}
\ No newline at end of file
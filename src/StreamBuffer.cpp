@@ -0,0 +1,211 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "StreamBuffer.h"
+#include "GLStateCache.h"
+
+namespace ExoEngine {
+
+	StreamBuffer::StreamBuffer(unsigned long size)
+		: _id(0), _size(0), _region(0), _offset(0), _pMapped(nullptr), _persistent(false)
+	{
+		for (unsigned int i = 0; i < STREAM_BUFFER_REGIONS; i++)
+			_fences[i] = 0;
+
+		allocate(size);
+	}
+
+	StreamBuffer::~StreamBuffer(void)
+	{
+		release();
+	}
+
+	unsigned long StreamBuffer::push(const void* data, unsigned long size)
+	{
+		unsigned long offset;
+
+		// Grow when a frame needs more than a region, the first region of the new store also holds the frame so far
+		if (_offset + size > _size)
+		{
+			unsigned long capacity = _size;
+			while (capacity < _region * _size + _offset + size)
+				capacity *= 2;
+
+			grow(capacity);
+		}
+
+		offset = _region * _size + _offset;
+		GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+
+		if (_persistent)
+			std::memcpy(_pMapped + offset, data, size);
+		else
+		{
+			// The fence of the region was waited, the driver doesn't need to synchronize
+			void* pointer;
+			GL_CALL(pointer = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+			std::memcpy(pointer, data, size);
+			GL_CALL(glUnmapBuffer(GL_ARRAY_BUFFER));
+		}
+
+		_offset += (size + STREAM_BUFFER_ALIGNMENT - 1) & ~(unsigned long)(STREAM_BUFFER_ALIGNMENT - 1);
+		return (offset);
+	}
+
+	void StreamBuffer::endFrame(void)
+	{
+		if (_fences[_region])
+			glDeleteSync(_fences[_region]);
+		_fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		_region = (_region + 1) % STREAM_BUFFER_REGIONS;
+		_offset = 0;
+
+		// Only blocks when the GPU is more than STREAM_BUFFER_REGIONS - 1 frames late
+		waitRegion(_region);
+	}
+
+	void StreamBuffer::bind(void) const
+	{
+		GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+	}
+
+	void StreamBuffer::setAttribute(unsigned char attribArray, unsigned int size, unsigned int stride, unsigned long offset, unsigned int divisor) const
+	{
+		GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+		GL_CALL(glEnableVertexAttribArray(attribArray));
+		GL_CALL(glVertexAttribPointer(attribArray, size, GL_FLOAT, GL_FALSE, stride * sizeof(GL_FLOAT), (void*)(offset * sizeof(GL_FLOAT))));
+		GL_CALL(glVertexAttribDivisor(attribArray, divisor));
+	}
+
+	// Getters
+	GLuint StreamBuffer::getBuffer(void) const
+	{
+		return (_id);
+	}
+
+	unsigned long StreamBuffer::getSize(void) const
+	{
+		return (_size);
+	}
+
+	bool StreamBuffer::isPersistent(void) const
+	{
+		return (_persistent);
+	}
+
+	// Private
+	void StreamBuffer::allocate(unsigned long size)
+	{
+		unsigned long total;
+
+		_size = (size + STREAM_BUFFER_ALIGNMENT - 1) & ~(unsigned long)(STREAM_BUFFER_ALIGNMENT - 1);
+		total = _size * STREAM_BUFFER_REGIONS;
+		_region = 0;
+		_offset = 0;
+
+		GL_CALL(glGenBuffers(1, &_id));
+		GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+
+#ifndef __APPLE__
+		if (GLEW_ARB_buffer_storage)
+		{
+			static const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, total, NULL, flags));
+			GL_CALL(_pMapped = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags));
+			_persistent = _pMapped != nullptr;
+			return;
+		}
+#endif
+		GL_CALL(glBufferData(GL_ARRAY_BUFFER, total, NULL, GL_STREAM_DRAW));
+		_persistent = false;
+	}
+
+	void StreamBuffer::grow(unsigned long size)
+	{
+		GLStateCache& stateCache = GLStateCache::Get();
+		GLuint previous = _id;
+		bool persistent = _persistent;
+		unsigned long first = _region * _size;
+		unsigned long used = first + _offset;
+
+		// The fences only guard the previous store, the new one is not used by the GPU yet
+		for (unsigned int i = 0; i < STREAM_BUFFER_REGIONS; i++)
+		{
+			if (_fences[i])
+				glDeleteSync(_fences[i]);
+			_fences[i] = 0;
+		}
+
+		allocate(size);
+
+		// Same offsets in the new store, the draws of the frame recorded earlier keep reading the previous one
+		stateCache.bindBuffer(GL_COPY_READ_BUFFER, previous);
+		if (used > first)
+		{
+			stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, _id);
+			GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, first, first, used - first));
+		}
+		if (persistent)
+			glUnmapBuffer(GL_COPY_READ_BUFFER);
+		stateCache.deleteBuffer(previous);
+
+		// The rest of the frame goes after it
+		_offset = used;
+	}
+
+	void StreamBuffer::release(void)
+	{
+		for (unsigned int i = 0; i < STREAM_BUFFER_REGIONS; i++)
+		{
+			if (_fences[i])
+				glDeleteSync(_fences[i]);
+			_fences[i] = 0;
+		}
+
+		if (_persistent)
+		{
+			GLStateCache::Get().bindBuffer(GL_ARRAY_BUFFER, _id);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+			_pMapped = nullptr;
+		}
+		GLStateCache::Get().deleteBuffer(_id);
+		_id = 0;
+	}
+
+	void StreamBuffer::waitRegion(unsigned int region)
+	{
+		if (!_fences[region])
+			return;
+
+		while (glClientWaitSync(_fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000)) == GL_TIMEOUT_EXPIRED)
+			;
+		glDeleteSync(_fences[region]);
+		_fences[region] = 0;
+	}
+
+}
\ No newline at end of file
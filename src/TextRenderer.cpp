@@ -23,20 +23,23 @@
  */
 
 #include "TextRenderer.h"
+#include "GLStateCache.h"
 #include "RendererSDLOpenGL.h"
 #include "UI/FntLoader.h"
 
 #include <locale>
 #include <codecvt>
+#include <algorithm>
 
 namespace ExoEngine {
 
 	Shader* TextRenderer::pTextShader = nullptr;
 	Buffer* TextRenderer::vaoBuffer = nullptr;
-	Buffer* TextRenderer::vertexBuffer = nullptr;
+	StreamBuffer* TextRenderer::vertexStream = nullptr;
+	std::unordered_map<Label*, glyphCache> TextRenderer::_glyphCache;
+	unsigned int TextRenderer::_cacheFrame = 0;
 
 	TextRenderer::TextRenderer(void)
-		: _currentTextureBind(-1)
 	{	}
 
 	TextRenderer::~TextRenderer(void)
@@ -49,50 +52,166 @@ namespace ExoEngine {
 
 	void TextRenderer::remove(Label* element)
 	{
-		_renderQueue.push_back(element);
+		std::deque<Label*>::iterator iterator = std::find(_renderQueue.begin(), _renderQueue.end(), element);
+		if (iterator != _renderQueue.end())
+			_renderQueue.erase(iterator);
+
+		_glyphCache.erase(element);
+	}
+
+	void TextRenderer::clear(void)
+	{
+		_renderQueue.clear();
+	}
+
+	void TextRenderer::render(void)
+	{
+		record();
+		submit();
 	}
 
-	void TextRenderer::render(const glm::mat4& orthographic)
+	void TextRenderer::record(void)
 	{
-		prepare(orthographic);
+		static const unsigned int vertexFloats = 7;
+
+		_commands.clear();
+		_labels.clear();
+		_batches.clear();
 
-		static float x = 0;
-		static float y = 0;
+		if ((++_cacheFrame % 1024) == 0)
+			pruneCache();
 
+		if (_renderQueue.empty())
+			return;
+
+		// Count the vertices of each font atlas
 		for (Label* label : _renderQueue)
 		{
-			int engineId = label->getFont()->getTexture()->getEngineId();
-			if (_currentTextureBind != engineId || _currentTextureBind == -1)
-				label->getFont()->getTexture()->bind();
+			ITexture* texture = label->getFont()->getTexture().get();
+			const glyphCache& glyphs = getGlyphs(label);
+
+			size_t batch = 0;
+			while (batch < _batches.size() && _batches[batch].texture != texture)
+				batch++;
+			if (batch == _batches.size())
+				_batches.push_back({ texture, 0, 0 });
+
+			_batches[batch].count += glyphs.vertices.size() / 4;
+			_labels.push_back({ label, &glyphs, batch });
+		}
+
+		size_t total = 0;
+		for (textBatch& batch : _batches)
+		{
+			batch.first = total;
+			total += batch.count;
+			batch.count = 0;
+		}
+
+		if (!total)
+			return;
+
+		// Move the cached quads to the label origin and append the color
+		_vertices.resize(total * vertexFloats);
+		for (const labelGlyphs& entry : _labels)
+		{
+			Label* label = entry.label;
+			textBatch& batch = _batches[entry.batch];
+			float* out = &_vertices[(batch.first + batch.count) * vertexFloats];
 
-			pTextShader->setVec3("textColor", label->getColor());
-			x = label->getRealPosition().x + label->getVirtualOffset().x + label->getRelativeParentPosition().x;
-			y = label->getRealPosition().y + label->getVirtualOffset().y + label->getRelativeParentPosition().y;
+			float x = label->getRealPosition().x + label->getVirtualOffset().x + label->getRelativeParentPosition().x;
+			float y = label->getRealPosition().y + label->getVirtualOffset().y + label->getRelativeParentPosition().y;
+			glm::vec3 color = label->getColor();
 
-			for (const auto& c : utf8ToUtf16(label->getText()))
-				renderCharacter(c, x, y, label);
+			const std::vector<float>& vertices = entry.glyphs->vertices;
+			for (size_t i = 0; i < vertices.size(); i += 4)
+			{
+				*out++ = vertices[i] + x;
+				*out++ = vertices[i + 1] + y;
+				*out++ = vertices[i + 2];
+				*out++ = vertices[i + 3];
+				*out++ = color.r;
+				*out++ = color.g;
+				*out++ = color.b;
+			}
+			batch.count += vertices.size() / 4;
 		}
 
-		_currentTextureBind = -1;
+		// One packet per font atlas
+		for (size_t i = 0; i < _batches.size(); i++)
+			_commands.add(i, _batches[i].texture, (uint32_t)_batches[i].first, (uint32_t)_batches[i].count);
+	}
+
+	void TextRenderer::submit(void)
+	{
+		if (_commands.empty())
+			return;
+
+		unsigned long offset = vertexStream->push(_vertices.data(), _vertices.size() * sizeof(float)) / sizeof(float);
+
+		prepare();
+
+		// The region of the stream changes every frame
+		vertexStream->setAttribute(0, 4, 7, offset, 0);		// position, uv
+		vertexStream->setAttribute(1, 3, 7, offset + 4, 0);	// color
+
+		for (const drawPacket& packet : _commands.sort())
+		{
+			((const ITexture*)packet.state)->bind();
+			GL_CALL(glDrawArrays(GL_TRIANGLES, (GLint)packet.first, (GLsizei)packet.count));
+			GLStateCache::Get().countDrawCall();
+		}
+	}
+
+	// Getters
+	const std::vector<float>& TextRenderer::getVertices(void) const
+	{
+		return (_vertices);
+	}
+
+	const std::vector<TextRenderer::textBatch>& TextRenderer::getBatches(void) const
+	{
+		return (_batches);
 	}
 
 	// Private
-	void TextRenderer::prepare(const glm::mat4& orthographic)
+	void TextRenderer::prepare(void)
 	{
 		pTextShader->bind();
-		pTextShader->setMat4("projection", orthographic);
 
 		// Render
 		vaoBuffer->bind();
 	}
 
-	void TextRenderer::renderCharacter(const wchar_t c, float& x, float& y, Label* label)
+	const glyphCache& TextRenderer::getGlyphs(Label* label)
+	{
+		glyphCache& glyphs = _glyphCache[label];
+		glyphs.lastUse = _cacheFrame;
+
+		// Layout again only when the text, the font or its scale changed
+		if (glyphs.font == label->getFont().get() && glyphs.fontScale == label->getFontScale() && glyphs.text == label->getText())
+			return (glyphs);
+
+		glyphs.text = label->getText();
+		glyphs.font = label->getFont().get();
+		glyphs.fontScale = label->getFontScale();
+		glyphs.vertices.clear();
+
+		float x = 0;
+		float y = 0;
+		for (const auto& c : utf8ToUtf16(glyphs.text))
+			layoutCharacter(c, x, y, label, glyphs.vertices);
+
+		return (glyphs);
+	}
+
+	void TextRenderer::layoutCharacter(const wchar_t c, float& x, float& y, Label* label, std::vector<float>& vertices)
 	{
 		if (c == ' ') // Space
 			x += 18 * label->getFontScale();
 		else if (c == '\n') // Return
 		{
-			x = label->getRealPosition().x + label->getVirtualOffset().x + label->getRelativeParentPosition().x;
+			x = 0;
 			y += 85 * label->getFontScale();
 		}
 		else
@@ -106,7 +225,7 @@ namespace ExoEngine {
 			float ypos = y + (ch.height + ch.yOffset) * label->getFontScale();
 
 			// Vertices for character
-			float vertices[24] = {
+			const float quad[24] = {
 				xpos,	 ypos - h,	ch.x,					ch.y,
 				xpos,	 ypos,		ch.x,					ch.yMaxTextureCoord,
 				xpos + w, ypos,		ch.xMaxTextureCoord,	ch.yMaxTextureCoord,
@@ -116,14 +235,23 @@ namespace ExoEngine {
 				xpos + w, ypos - h,	ch.xMaxTextureCoord,	ch.y
 			};
 
-			vertexBuffer->updateSubData(24, vertices);
-			vertexBuffer->bind();
-
-			GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 6));
+			vertices.insert(vertices.end(), quad, quad + 24);
 			x += ch.xAdvance * label->getFontScale();
 		}
 	}
 
+	void TextRenderer::pruneCache(void)
+	{
+		// Labels destroyed without being removed
+		for (std::unordered_map<Label*, glyphCache>::iterator iterator = _glyphCache.begin(); iterator != _glyphCache.end();)
+		{
+			if (_cacheFrame - iterator->second.lastUse > 1024)
+				iterator = _glyphCache.erase(iterator);
+			else
+				iterator++;
+		}
+	}
+
 	std::wstring TextRenderer::utf8ToUtf16(const std::string& utf8Str)
 	{
 		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
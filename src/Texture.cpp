@@ -23,18 +23,22 @@
  */
 
 #include "Texture.h"
+#include "GLStateCache.h"
+#include "TextureUploader.h"
+#include "TextureCache.h"
 
 namespace ExoEngine {
 
-	Texture::Texture(unsigned int width, unsigned int height, TextureFormat format, TextureFilter filter) :
+	Texture::Texture(unsigned int width, unsigned int height, TextureFormat format, TextureFilter filter, const void* pixels) :
 		_width(width), _height(height)
 	{
 		GLenum	textureFormat;
+		size_t	pixelSize;
 
 		_format = format;
-		GL_CALL(glGenTextures(1, &_id));
+		_id = GLStateCache::Get().genTexture();
 
-		GL_CALL(glBindTexture(GL_TEXTURE_2D, _id));
+		GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D, _id);
 
 		applyFilter(filter);
 
@@ -42,22 +46,46 @@ namespace ExoEngine {
 		{
 		case RGBA:
 			textureFormat = GL_RGBA;
+			pixelSize = 4;
 			break;
 		case RGB:
 			textureFormat = GL_RGB;
+			pixelSize = 3;
 			break;
 		case DEPTH:
 			textureFormat = GL_DEPTH_COMPONENT;
+			pixelSize = 1;
 			break;
 		}
 
-		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, textureFormat, width, height, 0, textureFormat, GL_UNSIGNED_BYTE, NULL));
+		// Rows are aligned on 4 bytes (GL_UNPACK_ALIGNMENT)
+		if (pixels)
+			pixels = TextureUploader::Get().stage(pixels, ((width * pixelSize + 3) & ~(size_t)3) * height);
+
+		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, textureFormat, width, height, 0, textureFormat, GL_UNSIGNED_BYTE, pixels));
+		if (pixels && filter == TextureFilter::MIPMAP)
+			GL_CALL(glGenerateMipmap(GL_TEXTURE_2D));
+		_upload.set(TextureUploader::Get().finish());
 	}
 
 	Texture::Texture(const std::string& filePath, TextureFilter filter)
 	{
+		CookedTexture	cooked;
+
+		// Cooked first: cooking binds a texture of its own
+		if (TextureCache::Get().load(filePath, cooked))
+		{
+			_id = GLStateCache::Get().genTexture();
+			GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D, _id);
+
+			applyFilter(filter);
+			uploadCooked(cooked, filter);
+			return;
+		}
+
 		SDL_Surface* image = IMG_Load(filePath.c_str());
 		GLenum			textureFormat;
+		GLint			internalFormat;
 
 		if (!image)
 		{
@@ -65,9 +93,9 @@ namespace ExoEngine {
 			SDL_FillRect(image, NULL, SDL_MapRGB(image->format, 255, 0, 255));
 		}
 
-		GL_CALL(glGenTextures(1, &_id));
+		_id = GLStateCache::Get().genTexture();
 
-		GL_CALL(glBindTexture(GL_TEXTURE_2D, _id));
+		GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D, _id);
 
 		applyFilter(filter);
 
@@ -86,7 +114,17 @@ namespace ExoEngine {
 			break;
 		}
 
-		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, textureFormat, image->w, image->h, 0, textureFormat, GL_UNSIGNED_BYTE, image->pixels));
+		// Color images are compressed by the driver when asked
+		internalFormat = textureFormat;
+		if (image->format->BytesPerPixel >= 3)
+			internalFormat = TextureCache::Get().getInternalFormat(image->format->BytesPerPixel == 4);
+
+		// The driver copies from the pixel buffer while the loading goes on
+		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image->w, image->h, 0, textureFormat, GL_UNSIGNED_BYTE,
+			TextureUploader::Get().stage(image->pixels, image->pitch * image->h)));
+		if (filter == TextureFilter::MIPMAP)
+			GL_CALL(glGenerateMipmap(GL_TEXTURE_2D));
+		_upload.set(TextureUploader::Get().finish());
 
 		_width = image->w;
 		_height = image->h;
@@ -98,27 +136,24 @@ namespace ExoEngine {
 
 	Texture::~Texture(void)
 	{
-		glDeleteTextures(1, &_id);
+		GLStateCache::Get().deleteTexture(_id);
 	}
 
 	void Texture::bind(int unit) const
 	{
-		static GLuint	lastId = 0;
-
-		if (_id != lastId)
-		{
-			GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
-			GL_CALL(glBindTexture(GL_TEXTURE_2D, _id));
-
-			lastId = _id;
-		}
+		_upload.waitOnGPU();
+		GLStateCache::Get().bindTexture(unit, GL_TEXTURE_2D, _id);
 	}
 
 	void Texture::unbind(void) const
 	{
+		GLStateCache::Get().bindTexture(GLStateCache::Get().getActiveTexture(), GL_TEXTURE_2D, 0);
+		GLStateCache::Get().activeTexture(0);
+	}
 
-		GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
-		GL_CALL(glActiveTexture(GL_TEXTURE0));
+	bool Texture::isReady(void) const
+	{
+		return (_upload.isReady());
 	}
 
 	// Getters
@@ -138,10 +173,43 @@ namespace ExoEngine {
 	}
 
 	// Private
+	void Texture::uploadCooked(const CookedTexture& cooked, TextureFilter filter)
+	{
+		TextureUploader& uploader = TextureUploader::Get();
+
+		// Without mipmapping only the first level is used
+		int levels = filter == TextureFilter::MIPMAP ? cooked.getLevelCount() : 1;
+
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1));
+		for (int level = 0; level < levels; level++)
+		{
+			const cookedLevel& info = cooked.getLevel(level);
+			const void* pixels = uploader.stage(cooked.getLevelData(level), (size_t)info.size);
+
+			if (cooked.isCompressed())
+			{
+				GL_CALL(glCompressedTexImage2D(GL_TEXTURE_2D, level, cooked.getInternalFormat(), info.width, info.height, 0, (GLsizei)info.size, pixels));
+			}
+			else
+			{
+				GL_CALL(glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, info.width, info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+			}
+		}
+		_upload.set(uploader.finish());
+
+		_format = RGBA;
+		_width = cooked.getWidth();
+		_height = cooked.getHeight();
+	}
+
 	void Texture::applyFilter(const TextureFilter& filter)
 	{
 		switch (filter)
 		{
+		case TextureFilter::MIPMAP:
+			GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+			GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			break;
 		case TextureFilter::NEAREST:
 			GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
 			GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
@@ -0,0 +1,227 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "TextureAtlas.h"
+
+namespace ExoEngine {
+
+	TextureRegion::TextureRegion(const std::shared_ptr<Texture>& page, int x, int y, int width, int height)
+		: _page(page), _width(width), _height(height)
+	{
+		_uvRect = glm::vec4((float)x / page->getWidth(), (float)y / page->getHeight(), (float)width / page->getWidth(), (float)height / page->getHeight());
+	}
+
+	TextureRegion::~TextureRegion(void)
+	{	}
+
+	void TextureRegion::bind(int unit) const
+	{
+		_page->bind(unit);
+	}
+
+	void TextureRegion::unbind(void) const
+	{
+		_page->unbind();
+	}
+
+	bool TextureRegion::isReady(void) const
+	{
+		return (_page->isReady());
+	}
+
+	// Getters
+	int TextureRegion::getEngineId(void) const
+	{
+		return (_page->getEngineId());
+	}
+
+	int TextureRegion::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int TextureRegion::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	glm::vec4 TextureRegion::getUVRect(void) const
+	{
+		return (_uvRect);
+	}
+
+	const std::shared_ptr<Texture>& TextureRegion::getPage(void) const
+	{
+		return (_page);
+	}
+
+	TextureAtlas::TextureAtlas(int width, int height, std::vector<std::string>& textures, TextureFilter filter)
+	{
+		std::vector<SDL_Surface*>	surfaces(textures.size());
+		std::vector<size_t>			order(textures.size());
+		std::vector<int>			pageOf(textures.size(), -1);
+		std::vector<SDL_Rect>		rects(textures.size());
+		std::vector<TexturePacker>	packers;
+		std::vector<SDL_Surface*>	pageSurfaces;
+
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			surfaces[i] = loadSurface(textures[i]);
+			order[i] = i;
+		}
+
+		// Tallest first keeps the skyline flat
+		std::sort(order.begin(), order.end(), [&surfaces](size_t a, size_t b) {
+			if (surfaces[a]->h != surfaces[b]->h)
+				return (surfaces[a]->h > surfaces[b]->h);
+			return (surfaces[a]->w > surfaces[b]->w);
+		});
+
+		for (size_t index : order)
+		{
+			SDL_Surface* surface = surfaces[index];
+			int paddedWidth = surface->w + ATLAS_PADDING * 2;
+			int paddedHeight = surface->h + ATLAS_PADDING * 2;
+			glm::ivec2 position;
+			size_t page;
+
+			// Too large for a page, it keeps its own texture
+			if (paddedWidth > width || paddedHeight > height)
+				continue;
+
+			for (page = 0; page < packers.size(); page++)
+			{
+				if (packers[page].pack(paddedWidth, paddedHeight, position))
+					break;
+			}
+
+			if (page == packers.size())
+			{
+				packers.emplace_back(width, height);
+				packers.back().pack(paddedWidth, paddedHeight, position);
+
+				pageSurfaces.push_back(SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32));
+				SDL_FillRect(pageSurfaces.back(), NULL, 0);
+			}
+
+			rects[index] = { position.x + ATLAS_PADDING, position.y + ATLAS_PADDING, surface->w, surface->h };
+			pageOf[index] = (int)page;
+
+			SDL_Rect destination = rects[index];
+			SDL_BlitSurface(surface, NULL, pageSurfaces[page], &destination);
+			extrude(pageSurfaces[page], rects[index]);
+		}
+
+		// One upload per page
+		for (SDL_Surface* pageSurface : pageSurfaces)
+		{
+			_pages.push_back(std::shared_ptr<Texture>(new Texture(width, height, TextureFormat::RGBA, filter, pageSurface->pixels)));
+			SDL_FreeSurface(pageSurface);
+		}
+
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			if (pageOf[i] >= 0)
+				_textures.push_back(std::shared_ptr<ITexture>(new TextureRegion(_pages[pageOf[i]], rects[i].x, rects[i].y, rects[i].w, rects[i].h)));
+			else
+				_textures.push_back(std::shared_ptr<ITexture>(new Texture(surfaces[i]->w, surfaces[i]->h, TextureFormat::RGBA, filter, surfaces[i]->pixels)));
+
+			SDL_FreeSurface(surfaces[i]);
+		}
+	}
+
+	TextureAtlas::~TextureAtlas(void)
+	{	}
+
+	// Getters
+	const std::shared_ptr<ITexture>& TextureAtlas::getTexture(size_t index) const
+	{
+		if (index >= _textures.size())
+			throw (std::out_of_range("atlas texture index out of range"));
+		return (_textures[index]);
+	}
+
+	size_t TextureAtlas::size(void) const
+	{
+		return (_textures.size());
+	}
+
+	size_t TextureAtlas::getPageCount(void) const
+	{
+		return (_pages.size());
+	}
+
+	// Private
+	SDL_Surface* TextureAtlas::loadSurface(const std::string& filePath)
+	{
+		SDL_Surface* image = IMG_Load(filePath.c_str());
+		SDL_Surface* converted;
+
+		if (!image)
+		{
+			image = Texture::generateDefaultTexture();
+			SDL_FillRect(image, NULL, SDL_MapRGB(image->format, 255, 0, 255));
+		}
+
+		// Every page is RGBA, whatever the format of the file
+		converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(image);
+		SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+
+		return (converted);
+	}
+
+	void TextureAtlas::extrude(SDL_Surface* page, const SDL_Rect& rect)
+	{
+		Uint32* pixels = (Uint32*)page->pixels;
+		int pitch = page->pitch / 4;
+
+		// Left and right columns
+		for (int y = rect.y; y < rect.y + rect.h; y++)
+		{
+			Uint32* row = pixels + y * pitch;
+
+			for (int x = 1; x <= ATLAS_PADDING; x++)
+			{
+				row[rect.x - x] = row[rect.x];
+				row[rect.x + rect.w - 1 + x] = row[rect.x + rect.w - 1];
+			}
+		}
+
+		// Top and bottom rows, corners included
+		for (int y = 1; y <= ATLAS_PADDING; y++)
+		{
+			std::copy(pixels + rect.y * pitch + rect.x - ATLAS_PADDING,
+				pixels + rect.y * pitch + rect.x + rect.w + ATLAS_PADDING,
+				pixels + (rect.y - y) * pitch + rect.x - ATLAS_PADDING);
+			std::copy(pixels + (rect.y + rect.h - 1) * pitch + rect.x - ATLAS_PADDING,
+				pixels + (rect.y + rect.h - 1) * pitch + rect.x + rect.w + ATLAS_PADDING,
+				pixels + (rect.y + rect.h - 1 + y) * pitch + rect.x - ATLAS_PADDING);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,336 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <sys/stat.h>
+#include <SDL2/SDL_image.h>
+
+#include "TextureCache.h"
+#include "GLStateCache.h"
+
+namespace ExoEngine {
+
+	// FNV-1a
+	static uint64_t hashString(const std::string& string, uint64_t hash)
+	{
+		for (unsigned char c : string)
+		{
+			hash ^= c;
+			hash *= 1099511628211ULL;
+		}
+		return (hash);
+	}
+
+	// Level data starts on 16 bytes
+	static uint64_t alignOffset(uint64_t offset)
+	{
+		return ((offset + 15) & ~(uint64_t)15);
+	}
+
+	CookedTexture::CookedTexture(void)
+		: _header(nullptr), _levels(nullptr)
+	{	}
+
+	CookedTexture::~CookedTexture(void)
+	{	}
+
+	bool CookedTexture::open(const std::string& path, uint64_t sourceSize, int64_t sourceTime)
+	{
+		close();
+		if (!_file.open(path))
+			return (false);
+
+		_header = (const cookedHeader*)_file.getData();
+		_levels = (const cookedLevel*)(_file.getData() + sizeof(cookedHeader));
+
+		// Another version, an outdated source or a truncated file
+		if (_file.getSize() < sizeof(cookedHeader) ||
+			_header->magic != TEXTURE_CACHE_MAGIC || _header->version != TEXTURE_CACHE_VERSION ||
+			_header->sourceSize != sourceSize || _header->sourceTime != sourceTime ||
+			_header->levelCount == 0 || _header->levelCount > TEXTURE_CACHE_MAX_LEVELS ||
+			_file.getSize() < sizeof(cookedHeader) + _header->levelCount * sizeof(cookedLevel))
+		{
+			close();
+			return (false);
+		}
+
+		for (uint32_t level = 0; level < _header->levelCount; level++)
+		{
+			if (_levels[level].offset + _levels[level].size > _file.getSize())
+			{
+				close();
+				return (false);
+			}
+		}
+		return (true);
+	}
+
+	void CookedTexture::close(void)
+	{
+		_file.close();
+		_header = nullptr;
+		_levels = nullptr;
+	}
+
+	// Getters
+	int CookedTexture::getWidth(void) const
+	{
+		return ((int)_header->width);
+	}
+
+	int CookedTexture::getHeight(void) const
+	{
+		return ((int)_header->height);
+	}
+
+	int CookedTexture::getLevelCount(void) const
+	{
+		return ((int)_header->levelCount);
+	}
+
+	const cookedLevel& CookedTexture::getLevel(int level) const
+	{
+		return (_levels[level]);
+	}
+
+	const void* CookedTexture::getLevelData(int level) const
+	{
+		return (_file.getData() + _levels[level].offset);
+	}
+
+	GLenum CookedTexture::getInternalFormat(void) const
+	{
+		return ((GLenum)_header->internalFormat);
+	}
+
+	bool CookedTexture::isCompressed(void) const
+	{
+		return (_header->compressed != 0);
+	}
+
+	TextureCache::TextureCache(void)
+		: _compression(false), _hits(0), _cooked(0)
+	{	}
+
+	TextureCache::~TextureCache(void)
+	{	}
+
+	void TextureCache::setDirectory(const std::string& directory)
+	{
+		_directory = directory;
+		if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\')
+			_directory += '/';
+	}
+
+	bool TextureCache::isEnabled(void) const
+	{
+		return (!_directory.empty());
+	}
+
+	void TextureCache::setCompression(bool compression)
+	{
+		_compression = compression;
+	}
+
+	bool TextureCache::useCompression(void) const
+	{
+#ifndef __APPLE__
+		return (_compression && GLEW_EXT_texture_compression_s3tc);
+#else
+		return (false);
+#endif
+	}
+
+	GLenum TextureCache::getInternalFormat(bool alpha) const
+	{
+		if (useCompression())
+			return (alpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+		return (alpha ? GL_RGBA : GL_RGB);
+	}
+
+	bool TextureCache::load(const std::string& sourcePath, CookedTexture& cooked)
+	{
+		struct stat status;
+		std::string path;
+
+		// Missing sources keep the fallback of the loaders
+		if (!isEnabled() || stat(sourcePath.c_str(), &status) != 0)
+			return (false);
+
+		path = getPath(sourcePath);
+		if (cooked.open(path, (uint64_t)status.st_size, (int64_t)status.st_mtime))
+		{
+			_hits++;
+			return (true);
+		}
+
+		if (!cook(sourcePath, path, (uint64_t)status.st_size, (int64_t)status.st_mtime))
+			return (false);
+
+		_cooked++;
+		return (cooked.open(path, (uint64_t)status.st_size, (int64_t)status.st_mtime));
+	}
+
+	// Getters
+	unsigned int TextureCache::getHits(void) const
+	{
+		return (_hits);
+	}
+
+	unsigned int TextureCache::getCooked(void) const
+	{
+		return (_cooked);
+	}
+
+	// Private
+	bool TextureCache::cook(const std::string& sourcePath, const std::string& cookedPath, uint64_t sourceSize, int64_t sourceTime)
+	{
+		GLStateCache& stateCache = GLStateCache::Get();
+		SDL_Surface* source = IMG_Load(sourcePath.c_str());
+		SDL_Surface* image;
+		cookedHeader header;
+		std::vector<cookedLevel> levels;
+		std::vector<unsigned char> data;
+		GLint compressed = GL_FALSE;
+		GLuint id;
+
+		if (!source)
+			return (false);
+
+		// One layout for every image: RGBA8, rows without padding
+		bool alpha = source->format->Amask != 0;
+		image = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(source);
+		if (!image)
+			return (false);
+
+		header.magic = TEXTURE_CACHE_MAGIC;
+		header.version = TEXTURE_CACHE_VERSION;
+		header.sourceSize = sourceSize;
+		header.sourceTime = sourceTime;
+		header.width = image->w;
+		header.height = image->h;
+		header.internalFormat = useCompression() ? getInternalFormat(alpha) : GL_RGBA8;
+		header.padding = 0;
+
+		// The GL builds the mip chain and compresses it, then gives it back
+		id = stateCache.genTexture();
+		stateCache.bindTexture(stateCache.getActiveTexture(), GL_TEXTURE_2D, id);
+		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, header.internalFormat, image->w, image->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels));
+		GL_CALL(glGenerateMipmap(GL_TEXTURE_2D));
+		SDL_FreeSurface(image);
+
+		GL_CALL(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed));
+		header.compressed = compressed == GL_TRUE ? 1 : 0;
+
+		header.levelCount = 1;
+		for (uint32_t size = std::max(header.width, header.height); size > 1 && header.levelCount < TEXTURE_CACHE_MAX_LEVELS; size >>= 1)
+			header.levelCount++;
+
+		levels.resize(header.levelCount);
+		uint64_t base = alignOffset(sizeof(cookedHeader) + header.levelCount * sizeof(cookedLevel));
+		uint64_t offset = base;
+
+		for (uint32_t level = 0; level < header.levelCount; level++)
+		{
+			GLint width, height, size;
+
+			GL_CALL(glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width));
+			GL_CALL(glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height));
+			if (header.compressed)
+			{
+				GL_CALL(glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size));
+			}
+			else
+				size = width * height * 4;
+
+			levels[level].width = width;
+			levels[level].height = height;
+			levels[level].offset = offset;
+			levels[level].size = size;
+
+			data.resize(offset + size - base);
+			unsigned char* pixels = data.data() + (offset - base);
+			if (header.compressed)
+			{
+				GL_CALL(glGetCompressedTexImage(GL_TEXTURE_2D, level, pixels));
+			}
+			else
+			{
+				GL_CALL(glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+			}
+
+			offset = alignOffset(offset + size);
+		}
+
+		stateCache.deleteTexture(id);
+
+		// Written aside then renamed, a concurrent load never maps half a file. The name is unique per cook,
+		// two threads cooking the same texture never write in the same temporary file.
+		static std::atomic<unsigned int> temporaryCount(0);
+		std::string temporaryPath = cookedPath + "." + std::to_string(temporaryCount++) + ".tmp";
+		bool written;
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			std::vector<char> padding(base - (sizeof(cookedHeader) + header.levelCount * sizeof(cookedLevel)), 0);
+
+			if (!file.is_open())
+				return (false);
+
+			file.write((const char*)&header, sizeof(header));
+			file.write((const char*)levels.data(), levels.size() * sizeof(cookedLevel));
+			file.write(padding.data(), padding.size());
+			file.write((const char*)data.data(), data.size());
+			written = !file.fail();
+		}
+
+		// Unique names don't overwrite each other, a failed write must not stay on the disk
+		if (!written)
+		{
+			std::remove(temporaryPath.c_str());
+			return (false);
+		}
+
+		std::remove(cookedPath.c_str());
+		return (std::rename(temporaryPath.c_str(), cookedPath.c_str()) == 0);
+	}
+
+	std::string TextureCache::getPath(const std::string& sourcePath) const
+	{
+		char name[17];
+		uint64_t hash = hashString(sourcePath, 14695981039346656037ULL);
+
+		// Compressed and uncompressed versions live side by side
+		if (useCompression())
+			hash = hashString("#s3tc", hash);
+
+		snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+		return (_directory + name + ".tex");
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <limits>
+
+#include "TexturePacker.h"
+
+namespace ExoEngine {
+
+	TexturePacker::TexturePacker(int width, int height)
+		: _width(width), _height(height), _usedArea(0)
+	{
+		clear();
+	}
+
+	TexturePacker::~TexturePacker(void)
+	{	}
+
+	bool TexturePacker::pack(int width, int height, glm::ivec2& position)
+	{
+		int bestTop = std::numeric_limits<int>::max();
+		int bestWidth = std::numeric_limits<int>::max();
+		size_t bestIndex = _skyline.size();
+		int y;
+
+		if (width <= 0 || height <= 0)
+			return (false);
+
+		// Lowest top edge first, the narrowest segment breaks ties
+		for (size_t i = 0; i < _skyline.size(); i++)
+		{
+			if (fits(i, width, height, y) && (y + height < bestTop || (y + height == bestTop && _skyline[i].width < bestWidth)))
+			{
+				bestTop = y + height;
+				bestWidth = _skyline[i].width;
+				bestIndex = i;
+				position = glm::ivec2(_skyline[i].x, y);
+			}
+		}
+
+		if (bestIndex == _skyline.size())
+			return (false);
+
+		// Raise the skyline under the rectangle
+		_skyline.insert(_skyline.begin() + bestIndex, { position.x, position.y + height, width });
+		for (size_t i = bestIndex + 1; i < _skyline.size();)
+		{
+			int shrink = _skyline[i - 1].x + _skyline[i - 1].width - _skyline[i].x;
+
+			if (shrink <= 0)
+				break;
+			_skyline[i].x += shrink;
+			_skyline[i].width -= shrink;
+			if (_skyline[i].width > 0)
+				break;
+			_skyline.erase(_skyline.begin() + i);
+		}
+
+		// Merge the segments left at the same height
+		for (size_t i = 0; i + 1 < _skyline.size();)
+		{
+			if (_skyline[i].y == _skyline[i + 1].y)
+			{
+				_skyline[i].width += _skyline[i + 1].width;
+				_skyline.erase(_skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		_usedArea += (long)width * height;
+		return (true);
+	}
+
+	void TexturePacker::clear(void)
+	{
+		_skyline.clear();
+		_skyline.push_back({ 0, 0, _width });
+		_usedArea = 0;
+	}
+
+	// Getters
+	int TexturePacker::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	int TexturePacker::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	float TexturePacker::getOccupancy(void) const
+	{
+		return ((float)_usedArea / ((float)_width * _height));
+	}
+
+	// Private
+	bool TexturePacker::fits(size_t index, int width, int height, int& y) const
+	{
+		int x = _skyline[index].x;
+		int remaining = width;
+
+		if (x + width > _width)
+			return (false);
+
+		y = _skyline[index].y;
+		for (size_t i = index; remaining > 0; i++)
+		{
+			if (i == _skyline.size())
+				return (false);
+			if (_skyline[i].y > y)
+				y = _skyline[i].y;
+			if (y + height > _height)
+				return (false);
+			remaining -= _skyline[i].width;
+		}
+		return (true);
+	}
+
+}
\ No newline at end of file
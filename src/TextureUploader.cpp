@@ -0,0 +1,136 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "TextureUploader.h"
+#include "GLStateCache.h"
+#include "Log.h"
+
+namespace ExoEngine {
+
+	UploadFence::UploadFence(void)
+		: _fence(0), _waited(false)
+	{	}
+
+	UploadFence::~UploadFence(void)
+	{
+		if (_fence)
+			glDeleteSync(_fence);
+	}
+
+	void UploadFence::set(GLsync fence)
+	{
+		if (_fence)
+			glDeleteSync(_fence);
+		_fence = fence;
+		_waited = false;
+	}
+
+	bool UploadFence::isReady(void)
+	{
+		if (!_fence)
+			return (true);
+
+		// Timeout of 0: only asks for the status
+		if (glClientWaitSync(_fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			return (false);
+
+		glDeleteSync(_fence);
+		_fence = 0;
+		return (true);
+	}
+
+	void UploadFence::waitOnGPU(void)
+	{
+		if (_fence && !_waited)
+		{
+			GL_CALL(glWaitSync(_fence, 0, GL_TIMEOUT_IGNORED));
+			_waited = true;
+		}
+	}
+
+	TextureUploader& TextureUploader::Get(void)
+	{
+		static thread_local TextureUploader uploader;
+
+		return (uploader);
+	}
+
+	TextureUploader::TextureUploader(void)
+		: _pixelBuffer(0), _uploadedBytes(0)
+	{	}
+
+	TextureUploader::~TextureUploader(void)
+	{
+		// The context of the thread can already be gone, the buffer goes with it
+	}
+
+	const void* TextureUploader::stage(const void* pixels, size_t size, size_t reserve)
+	{
+		void* pointer;
+
+		if (!_pixelBuffer)
+			GL_CALL(glGenBuffers(1, &_pixelBuffer));
+
+		GLStateCache::Get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffer);
+
+		// A new store each time, the previous one is released once the GPU copied it
+		GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size > reserve ? size : reserve, NULL, GL_STREAM_DRAW));
+		GL_CALL(pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+		if (!pointer)
+		{
+			// Nothing was copied, the upload reads the client pixels like without a pixel buffer
+			_log.warning << "texture upload: mapping the pixel buffer failed, " << size << " bytes read from client memory" << std::endl;
+			GLStateCache::Get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			return (pixels);
+		}
+		std::memcpy(pointer, pixels, size);
+		GL_CALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+		_uploadedBytes += size;
+		return ((const void*)0);
+	}
+
+	GLsync TextureUploader::finish(void)
+	{
+		GLsync fence;
+
+		// Client pointers are read from memory again
+		GLStateCache::Get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		// The fence must reach the GPU for the other contexts to see it signaled
+		GL_CALL(glFlush());
+		return (fence);
+	}
+
+	// Getters
+	unsigned long TextureUploader::getUploadedBytes(void) const
+	{
+		return (_uploadedBytes);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "TileMap.h"
+#include "GLStateCache.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/gtx/transform.hpp>
+
+namespace ExoEngine {
+
+	Shader* TileMap::pShader = nullptr;
+	UniformHandle<glm::mat4> TileMap::modelUniform;
+	Buffer* TileMap::indexBuffer = nullptr;
+
+	TileMap::TileMap(unsigned int width, unsigned int height, float tileSize, const std::shared_ptr<IArrayTexture>& texture)
+		: _width(width), _height(height), _tileSize(tileSize), _position(0.0f, 0.0f), _texture(texture), _drawCount(0)
+	{
+		_chunksX = (_width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+		_chunksY = (_height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+
+		_tiles.assign((size_t)_width * _height, TILE_EMPTY);
+		_chunks.resize((size_t)_chunksX * _chunksY, { nullptr, nullptr, 0, true });
+	}
+
+	TileMap::~TileMap(void)
+	{
+		for (tileChunk& chunk : _chunks)
+		{
+			if (chunk.pVertexBuffer)
+				delete chunk.pVertexBuffer;
+			if (chunk.pVaoBuffer)
+				delete chunk.pVaoBuffer;
+		}
+	}
+
+	void TileMap::loadUniforms(void)
+	{
+		modelUniform = pShader->getUniform<glm::mat4>("model");
+	}
+
+	void TileMap::render(const glm::mat4& viewProjection)
+	{
+		float chunkSize = _tileSize * TILE_CHUNK_SIZE;
+		glm::vec2 min, max;
+		int beginX = 0, beginY = 0, endX = _chunksX, endY = _chunksY;
+
+		_drawCount = 0;
+
+		// Only the chunks under the camera are visited, all of them when the bounds are unknown
+		_frustum.update(viewProjection);
+		if (_frustum.getBounds(min, max))
+		{
+			min -= _position;
+			max -= _position;
+
+			beginX = std::max((int)std::floor(min.x / chunkSize), 0);
+			beginY = std::max((int)std::floor(min.y / chunkSize), 0);
+			endX = std::min((int)std::ceil(max.x / chunkSize), (int)_chunksX);
+			endY = std::min((int)std::ceil(max.y / chunkSize), (int)_chunksY);
+		}
+
+		if (beginX >= endX || beginY >= endY)
+			return;
+
+		pShader->bind();
+		pShader->set(modelUniform, glm::translate(glm::mat4(1.0f), glm::vec3(_position, 0.0f)));
+		_texture->bind(0);
+
+		for (int chunkY = beginY; chunkY < endY; chunkY++)
+		{
+			for (int chunkX = beginX; chunkX < endX; chunkX++)
+			{
+				tileChunk& chunk = _chunks[(size_t)chunkY * _chunksX + chunkX];
+
+				// Changed chunks are rebuilt once they are seen
+				if (chunk.dirty)
+					buildChunk(chunkX, chunkY);
+
+				if (chunk.indexCount == 0)
+					continue;
+
+				chunk.pVaoBuffer->bind();
+				GL_CALL(glDrawElements(GL_TRIANGLES, chunk.indexCount, GL_UNSIGNED_INT, (void*)0));
+				GLStateCache::Get().countDrawCall();
+				_drawCount++;
+			}
+		}
+	}
+
+	// Tiles
+	void TileMap::setTile(unsigned int x, unsigned int y, uint16_t layer)
+	{
+		if (x >= _width || y >= _height)
+			return;
+
+		uint16_t& tile = _tiles[(size_t)y * _width + x];
+		if (tile == layer)
+			return;
+
+		tile = layer;
+		_chunks[(size_t)(y / TILE_CHUNK_SIZE) * _chunksX + x / TILE_CHUNK_SIZE].dirty = true;
+	}
+
+	uint16_t TileMap::getTile(unsigned int x, unsigned int y) const
+	{
+		if (x >= _width || y >= _height)
+			return (TILE_EMPTY);
+		return (_tiles[(size_t)y * _width + x]);
+	}
+
+	void TileMap::fill(uint16_t layer)
+	{
+		std::fill(_tiles.begin(), _tiles.end(), layer);
+		for (tileChunk& chunk : _chunks)
+			chunk.dirty = true;
+	}
+
+	// Getters
+	unsigned int TileMap::getWidth(void) const
+	{
+		return (_width);
+	}
+
+	unsigned int TileMap::getHeight(void) const
+	{
+		return (_height);
+	}
+
+	float TileMap::getTileSize(void) const
+	{
+		return (_tileSize);
+	}
+
+	const glm::vec2& TileMap::getPosition(void) const
+	{
+		return (_position);
+	}
+
+	unsigned int TileMap::getDrawCount(void) const
+	{
+		return (_drawCount);
+	}
+
+	// Setters
+	void TileMap::setPosition(const glm::vec2& position)
+	{
+		_position = position;
+	}
+
+	// Private
+	void TileMap::buildChunk(unsigned int chunkX, unsigned int chunkY)
+	{
+		tileChunk& chunk = _chunks[(size_t)chunkY * _chunksX + chunkX];
+		unsigned int endX = std::min((chunkX + 1) * TILE_CHUNK_SIZE, _width);
+		unsigned int endY = std::min((chunkY + 1) * TILE_CHUNK_SIZE, _height);
+
+		_vertices.clear();
+		for (unsigned int y = chunkY * TILE_CHUNK_SIZE; y < endY; y++)
+		{
+			for (unsigned int x = chunkX * TILE_CHUNK_SIZE; x < endX; x++)
+			{
+				uint16_t tile = _tiles[(size_t)y * _width + x];
+				if (tile == TILE_EMPTY)
+					continue;
+
+				float left = x * _tileSize, bottom = y * _tileSize;
+				float right = left + _tileSize, top = bottom + _tileSize;
+				float layer = (float)tile;
+
+				// Same corners and winding as the sprite quad
+				_vertices.insert(_vertices.end(), {
+					left,	top,	0.0f, 0.0f, layer,
+					left,	bottom,	0.0f, 1.0f, layer,
+					right,	bottom,	1.0f, 1.0f, layer,
+					right,	top,	1.0f, 0.0f, layer
+				});
+			}
+		}
+
+		chunk.indexCount = (unsigned int)(_vertices.size() / (TILE_VERTEX_SIZE * 4) * 6);
+		chunk.dirty = false;
+
+		// An emptied chunk keeps its buffers for the next fill
+		if (chunk.indexCount == 0)
+			return;
+
+		if (!chunk.pVaoBuffer)
+		{
+			chunk.pVaoBuffer = new Buffer(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
+			indexBuffer->bind();
+
+			chunk.pVertexBuffer = new Buffer(_vertices.size(), 0, _vertices.data(), BufferType::INSTANCEBUFFER, BufferDraw::STATIC, 0, false);
+			chunk.pVertexBuffer->setAttribute(0, 2, TILE_VERTEX_SIZE, 0, 0);
+			chunk.pVertexBuffer->setAttribute(1, 2, TILE_VERTEX_SIZE, 2, 0);
+			chunk.pVertexBuffer->setAttribute(2, 1, TILE_VERTEX_SIZE, 4, 0);
+		}
+		else
+			chunk.pVertexBuffer->resize(_vertices.size(), _vertices.data());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <stdexcept>
+
+#include "UniformRing.h"
+#include "GLStateCache.h"
+#include "OGLCall.h"
+
+namespace ExoEngine {
+
+	UniformRing::UniformRing(unsigned long size)
+		: _pBuffer(nullptr), _size(size), _alignment(256), _offset(0)
+	{
+		GLint alignment = 0;
+		GL_CALL(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+		if (alignment > 0)
+			_alignment = (unsigned long)alignment;
+
+		_pBuffer = new Buffer(size / sizeof(float), 0, NULL, BufferType::UNIFORMBUFFER, BufferDraw::DYNAMIC, 0, false);
+	}
+
+	UniformRing::~UniformRing(void)
+	{
+		if (_pBuffer)
+			delete _pBuffer;
+	}
+
+	unsigned long UniformRing::push(unsigned int binding, const void* data, unsigned long size)
+	{
+		if (size > _size)
+			throw (std::invalid_argument("UniformRing: block larger than the ring"));
+
+		// Wrap, the previous storage stays alive for the draws still using it
+		if (_offset + size > _size)
+		{
+			_pBuffer->resize(_size / sizeof(float), NULL);
+			_offset = 0;
+		}
+
+		unsigned long offset = _offset;
+		_pBuffer->updateSubData(offset, size, data);
+		_pBuffer->bindRange(binding, offset, size);
+		GLStateCache::Get().countUniformUpload();
+
+		_offset = (offset + size + _alignment - 1) / _alignment * _alignment;
+		return (offset);
+	}
+
+	// Getters
+	unsigned long UniformRing::getSize(void) const
+	{
+		return (_size);
+	}
+
+	unsigned long UniformRing::getAlignment(void) const
+	{
+		return (_alignment);
+	}
+
+}
\ No newline at end of file
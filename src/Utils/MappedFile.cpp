@@ -0,0 +1,144 @@
+/*
+ *	MIT License
+ *
+ *	Copyright (c) 2020 Gaëtan Dezeiraud and Ribault Paul
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "Utils/MappedFile.h"
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace ExoEngine {
+
+	MappedFile::MappedFile(void)
+		: _data(nullptr), _size(0)
+#ifdef _WIN32
+		, _file(INVALID_HANDLE_VALUE), _mapping(NULL)
+#endif
+	{	}
+
+	MappedFile::~MappedFile(void)
+	{
+		close();
+	}
+
+#ifdef _WIN32
+
+	bool MappedFile::open(const std::string& path)
+	{
+		LARGE_INTEGER size;
+
+		close();
+		_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (_file == INVALID_HANDLE_VALUE)
+			return (false);
+
+		if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0 ||
+			!(_mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL)) ||
+			!(_data = (const unsigned char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)))
+		{
+			close();
+			return (false);
+		}
+
+		_size = (size_t)size.QuadPart;
+		return (true);
+	}
+
+	void MappedFile::close(void)
+	{
+		if (_data)
+			UnmapViewOfFile(_data);
+		if (_mapping)
+			CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE)
+			CloseHandle(_file);
+
+		_data = nullptr;
+		_mapping = NULL;
+		_file = INVALID_HANDLE_VALUE;
+		_size = 0;
+	}
+
+#else
+
+	bool MappedFile::open(const std::string& path)
+	{
+		struct stat status;
+		void* data;
+		int fd;
+
+		close();
+		if ((fd = ::open(path.c_str(), O_RDONLY)) == -1)
+			return (false);
+
+		if (fstat(fd, &status) == -1 || status.st_size == 0)
+		{
+			::close(fd);
+			return (false);
+		}
+
+		// The mapping keeps the file alive, the descriptor isn't needed anymore
+		data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return (false);
+
+		_data = (const unsigned char*)data;
+		_size = (size_t)status.st_size;
+		return (true);
+	}
+
+	void MappedFile::close(void)
+	{
+		if (_data)
+			munmap((void*)_data, _size);
+
+		_data = nullptr;
+		_size = 0;
+	}
+
+#endif
+
+	// Getters
+	const unsigned char* MappedFile::getData(void) const
+	{
+		return (_data);
+	}
+
+	size_t MappedFile::getSize(void) const
+	{
+		return (_size);
+	}
+
+	bool MappedFile::isOpen(void) const
+	{
+		return (_data != nullptr);
+	}
+
+}
\ No newline at end of file
@@ -29,61 +29,34 @@
 #include "SDLException.h"
 #include "Window.h"
 #include "OGLCall.h"
+#include "GLStateCache.h"
 
 namespace ExoEngine {
 
 	Window::Window(const std::string& title, uint32_t width, uint32_t height, const WindowMode& mode, bool resizable)
-		: IWindow(), _frameTexture(nullptr), _window(nullptr), _pFrameBuffer(nullptr)
+		: IWindow(), _window(nullptr)
 	{
 		initialize(title, width, height, mode, resizable);
 	}
 
+	Window::Window(void)
+		: IWindow(), _window(nullptr), _context(nullptr), _threadContext(nullptr)
+	{ }
+
 	Window::~Window(void)
 	{
-		if (_pFrameBuffer)
-			delete _pFrameBuffer;
-
-		if (_frameTexture)
-			delete _frameTexture;
+		_postProcessing.release();
 
-		SDL_GL_DeleteContext(_context);
-		SDL_GL_DeleteContext(_threadContext);
-		SDL_DestroyWindow(_window);
+		if (_window)
+		{
+			SDL_GL_DeleteContext(_context);
+			SDL_GL_DeleteContext(_threadContext);
+			SDL_DestroyWindow(_window);
+		}
 		IMG_Quit();
 		SDL_Quit();
 	}
 
-#ifndef USE_TEST_SHADERS
-
-	static const std::vector<std::string>	g_defaultShader = {
-		"#version 330 core",
-		"layout(location = 0) in vec3 position;",
-		"layout(location = 1) in vec2 texCoord;",
-		"",
-		"out vec2 TexCoords;",
-		"",
-		"void main(void) ",
-		"{",
-		"	gl_Position = vec4(position.x, position.y, 0.0, 1.0);",
-		"	TexCoords = texCoord;",
-		"}",
-		"",
-		"#FRAGMENT",
-		"#version 330 core",
-		"",
-		"uniform sampler2D screenTexture;",
-		"",
-		"in vec2 TexCoords;",
-		"out vec4 color;",
-		"",
-		"void main(void) ",
-		"{",
-		"	color = texture(screenTexture, TexCoords);",
-		"}"
-	};
-
-#endif
-
 	void Window::initialize(const std::string& title, uint32_t width, uint32_t height, const WindowMode& mode, bool resizable)
 	{
 		_width = width;
@@ -190,36 +163,6 @@ namespace ExoEngine {
 		_highDPIFactor = _contextWidth / _width;
 
 		// Post Processing
-		const static float tmp1[] = {
-			-1.0f,	1.0f, 0.0f,
-			-1.0f, -1.0f, 0.0f,
-			1.0f, -1.0f, 0.0f,
-
-			-1.0f,	1.0f, 0.0f,
-			1.0f, -1.0f, 0.0f,
-			1.0f,	1.0f, 0.0f
-		};
-		const static float tmp2[] = {
-			0.0f, 1.0f,
-			0.0f, 0.0f,
-			1.0f, 0.0f,
-
-			0.0f, 1.0f,
-			1.0f, 0.0f,
-			1.0f, 1.0f
-		};
-
-#ifdef USE_TEST_SHADERS
-		_postProcessing.initialize("resources/shaders/OpenGL3/post-processing/default.glsl");
-#else
-		_postProcessing.initialize(g_defaultShader);
-#endif
-		_postProcessing.bind();
-
-		_postVertexArrayObject.initialize(0, 0, NULL, BufferType::VERTEXARRAY, BufferDraw::STATIC, 0, false);
-		_postArrayBuffer.initialize(18, 3, &tmp1, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 0, false);
-		_postUVMappingBuffer.initialize(12, 2, &tmp2, BufferType::ARRAYBUFFER, BufferDraw::STATIC, 1, true);
-
 		initPostProcessing();
 	}
 
@@ -261,25 +204,13 @@ namespace ExoEngine {
 		_last = _now;
 		_now = SDL_GetPerformanceCounter();
 
-		_pFrameBuffer->clear();
+		_postProcessing.update(getDelta());
+		_postProcessing.begin();
 	}
 
 	void Window::swap(void)
 	{
-		_pFrameBuffer->unbind(); // back to default
-		glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
-
-		_postProcessing.bind();
-		GL_CALL(glBindVertexArray(_postVertexArrayObject.getBuffer()));
-		GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, _postArrayBuffer.getBuffer()));
-		GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, _postUVMappingBuffer.getBuffer()));
-
-		// Bind texture
-		GL_CALL(glActiveTexture(GL_TEXTURE0));
-		_frameTexture->bind();
-
-		GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 6));
+		_postProcessing.apply();
 		SDL_GL_SwapWindow(_window);
 	}
 
@@ -295,7 +226,12 @@ namespace ExoEngine {
 
 	IFrameBuffer* Window::getFrameBuffer(void) const
 	{
-		return (_pFrameBuffer);
+		return (_postProcessing.getSceneFrameBuffer());
+	}
+
+	void Window::readPixels(std::vector<uint8_t>& pixels) const
+	{
+		_postProcessing.readPixels(pixels);
 	}
 
 	void Window::isCursorVisible(bool visible)
@@ -305,26 +241,38 @@ namespace ExoEngine {
 
 	void Window::initPostProcessing(void)
 	{
-		// If already exist
-		if (_pFrameBuffer)
-			delete _pFrameBuffer;
+		_postProcessing.initialize(_contextWidth, _contextHeight);
+	}
 
-		if (_frameTexture)
-			delete _frameTexture;
+	// Post processing
+	void Window::addPostProcess(const std::string& name, const std::string& filePath)
+	{
+		_postProcessing.addPass(name, new Shader(filePath));
+	}
 
-		// Color Texture
-		_frameTexture = new Texture(_contextWidth, _contextHeight, RGBA, NEAREST);
-		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+	void Window::removePostProcess(const std::string& name)
+	{
+		_postProcessing.removePass(name);
+	}
 
-		// Framebuffer
-		_pFrameBuffer = new FrameBuffer();
-		_pFrameBuffer->attach(_frameTexture);
+	void Window::setPostProcessEnabled(const std::string& name, bool enabled)
+	{
+		_postProcessing.setPassEnabled(name, enabled);
+	}
 
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-			throw ("Error::FRAMEBUFFER:: Framebuffer is not complete!");
+	void Window::setResolutionScale(float scale)
+	{
+		_postProcessing.setResolutionScale(scale);
+	}
 
-		_pFrameBuffer->unbind();
+	void Window::setFrameTimeTarget(double frameTime)
+	{
+		_postProcessing.setFrameTimeTarget(frameTime);
+	}
+
+	float Window::getResolutionScale(void) const
+	{
+		return (_postProcessing.getResolutionScale());
 	}
 
 	// Setters